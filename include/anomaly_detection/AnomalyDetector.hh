@@ -12,23 +12,44 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <thread>
+#include <utility>
+#include <cstddef>
 
 #include "object_characterization/CharacterizedObject.hh"
+#include "object_characterization/Face.hh"
 #include "anomaly_detection/AnomalyReport.hh"
+#include "anomaly_detection/ClassificationReport.hh"
+#include "anomaly_detection/DeviationReport.hh"
+#include "anomaly_detection/DistanceReport.hh"
+#include "app/config.h"
+
+/**
+ * Métodos de emparejamiento de las caras de un objeto con las de un modelo
+ */
+enum FaceMatching {
+    kFaceMatchingGreedy,  ///< Emparejamiento voraz por menor diferencia de volumen de las bounding boxes
+    kFaceMatchingOptimal  ///< Asignación de coste total mínimo mediante el algoritmo húngaro
+};
 
 /**
  * @brief Detector de anomalías entre objetos y modelos
  */
 class AnomalyDetector {
    private:
-    bool chrono;  ///< Activador de la medicion de tiempos
+    bool chrono;             ///< Activador de la medicion de tiempos
+    FaceMatching matching;   ///< Método de emparejamiento de las caras
+    bool deviationAnalysis;  ///< Activador del análisis de desviaciones de la superficie
+    bool distanceMetrics;    ///< Activador del cálculo de las distancias de Chamfer y Hausdorff
 
    public:
     /**
      * Constructor
+     * @param chrono Activador del cronometraje de tiempos
+     * @param matching Método de emparejamiento de las caras
      */
-    AnomalyDetector(bool chrono) : chrono(chrono) {}
+    AnomalyDetector(bool chrono, FaceMatching matching = FACE_MATCHING_MODE) : chrono(chrono), matching(matching), deviationAnalysis(DEVIATION_ANALYSIS), distanceMetrics(DISTANCE_METRICS) {}
 
     /**
      * Destructor virtual
@@ -43,12 +64,94 @@ class AnomalyDetector {
      */
     AnomalyReport compare(const CharacterizedObject& obj, const Model& model);
 
+    /**
+     * Compara un objeto con varios modelos de forma concurrente y los ordena según su parecido. Los modelos cuya
+     * bounding box global o número de caras difieren demasiado del objeto se descartan sin comparar sus caras
+     * @param obj Objeto a comparar
+     * @param models Modelos candidatos por nombre
+     * @return Modelos comparados ordenados por similitud, número de anomalías y distancia entre bounding boxes
+     * junto a sus informes de anomalías, y modelos descartados
+     */
+    ClassificationReport classify(const CharacterizedObject& obj, const std::unordered_map<std::string, Model>& models);
+    /**
+     * Compara un objeto con varios modelos de forma concurrente y los ordena según su parecido. Los modelos cuya
+     * bounding box global o número de caras difieren demasiado del objeto se descartan sin comparar sus caras
+     * @param obj Objeto a comparar
+     * @param models Nombre de cada modelo candidato junto al modelo
+     * @return Modelos comparados ordenados por similitud, número de anomalías y distancia entre bounding boxes
+     * junto a sus informes de anomalías, y modelos descartados
+     */
+    ClassificationReport classify(const CharacterizedObject& obj, const std::vector<std::pair<std::string, const Model*>>& models);
+
+    /**
+     * Empareja las caras de un objeto con las de un modelo
+     * @param objFaces Caras del objeto
+     * @param modFaces Caras del modelo
+     * @param mode Método de emparejamiento
+     * @return Pares (cara del objeto, cara del modelo) emparejados, tantos como caras tenga el que menos tenga
+     */
+    static std::vector<std::pair<size_t, size_t>> matchFaces(const std::vector<Face>& objFaces, const std::vector<Face>& modFaces, FaceMatching mode);
+    /**
+     * Empareja las caras de un objeto con las de un modelo a partir de sus descriptores ya calculados
+     * @param objFaces Descriptores de las caras del objeto
+     * @param modFaces Descriptores de las caras del modelo
+     * @param mode Método de emparejamiento
+     * @return Pares (cara del objeto, cara del modelo) emparejados, tantos como caras tenga el que menos tenga
+     */
+    static std::vector<std::pair<size_t, size_t>> matchFaces(const FaceFeatures& objFaces, const FaceFeatures& modFaces, FaceMatching mode);
+
+    /**
+     * Calcula el coste de emparejar dos caras como combinación ponderada de la diferencia relativa de volumen
+     * y de dimensiones de sus bounding boxes y del ángulo entre sus normales
+     * @param objFace Cara del objeto
+     * @param modFace Cara del modelo
+     * @return Coste del emparejamiento, 0 para caras idénticas
+     */
+    static double matchingCost(const Face& objFace, const Face& modFace);
+
+    /**
+     * Registra los puntos de un objeto sobre los de un modelo mediante ICP punto a plano y calcula la desviación
+     * de cada punto registrado respecto a la superficie del modelo. El registro parte de la alineación de las
+     * bounding boxes de ambos y usa el índice espacial del modelo, que se construye una única vez
+     * @param obj Objeto a registrar
+     * @param model Modelo de referencia
+     * @return Mapa y estadísticas de las desviaciones, o un informe sin análisis si alguno no tiene puntos
+     */
+    static DeviationReport deviations(const CharacterizedObject& obj, const Model& model);
+
+    /**
+     * Registra los puntos de un objeto sobre los de un modelo y calcula las distancias simétricas de Chamfer y
+     * Hausdorff entre ambos. Las búsquedas sobre el modelo usan su índice espacial, que se construye una única vez.
+     * El cálculo se detiene en cuanto la distancia de un punto del objeto al modelo supera el umbral de Hausdorff,
+     * y la similitud depende solo de la distancia media del objeto al modelo
+     * @param obj Objeto a registrar
+     * @param model Modelo de referencia
+     * @param threshold Umbral (mm) de la distancia de Hausdorff
+     * @return Distancias entre objeto y modelo, o un informe sin distancias si alguno no tiene puntos
+     */
+    static DistanceReport distances(const CharacterizedObject& obj, const Model& model, double threshold = HAUSDORFF_THRESHOLD);
+
     ////// Setters
     /**
      * Setter del cronometraje
      * @param chrono Booleano para establecer el nuevo cronometraje
      */
     void setChrono(bool chrono) { this->chrono = chrono; }
+    /**
+     * Setter del método de emparejamiento de las caras
+     * @param matching Nuevo método de emparejamiento
+     */
+    void setMatching(FaceMatching matching) { this->matching = matching; }
+    /**
+     * Setter del análisis de desviaciones de la superficie
+     * @param deviationAnalysis Booleano para activar o desactivar el análisis
+     */
+    void setDeviationAnalysis(bool deviationAnalysis) { this->deviationAnalysis = deviationAnalysis; }
+    /**
+     * Setter del cálculo de las distancias de Chamfer y Hausdorff
+     * @param distanceMetrics Booleano para activar o desactivar el cálculo
+     */
+    void setDistanceMetrics(bool distanceMetrics) { this->distanceMetrics = distanceMetrics; }
 
     ////// Getters
     /**
@@ -56,6 +159,21 @@ class AnomalyDetector {
      * @return Booleano conforme está activado el cronometraje
      */
     bool isChrono() const { return this->chrono; }
+    /**
+     * Devuelve el método de emparejamiento de las caras
+     * @return Método de emparejamiento
+     */
+    FaceMatching getMatching() const { return this->matching; }
+    /**
+     * Devuelve si se analizan las desviaciones de la superficie
+     * @return Booleano conforme está activado el análisis de desviaciones
+     */
+    bool isDeviationAnalysis() const { return this->deviationAnalysis; }
+    /**
+     * Devuelve si se calculan las distancias de Chamfer y Hausdorff
+     * @return Booleano conforme está activado el cálculo de distancias
+     */
+    bool isDistanceMetrics() const { return this->distanceMetrics; }
 };
 
 #endif  // ANOMALYDETECTOR_INTERFACE_H
\ No newline at end of file
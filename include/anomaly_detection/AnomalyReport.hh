@@ -15,6 +15,8 @@
 
 #include <anomaly_detection/Comparison.hh>
 #include <anomaly_detection/FaceComparison.hh>
+#include <anomaly_detection/DeviationReport.hh>
+#include <anomaly_detection/DistanceReport.hh>
 
 /**
  * @brief Informe de anomalías encontradas en una comparación entre objeto y modelo
@@ -27,6 +29,8 @@ class AnomalyReport {
     const long totalAnomalies;                          ///< Número total de anomalías detectadas
     const std::vector<FaceComparison> faceComparisons;  ///< Vector de resultados de las comparaciones de caras individuales
     const std::vector<size_t> unmatched;                ///< Índices de las caras no emparejadas del modelo u objeto
+    const DeviationReport deviation;                    ///< Desviaciones de la superficie del objeto registrado sobre el modelo
+    const DistanceReport distance;                      ///< Distancias de Chamfer y Hausdorff entre el objeto registrado y el modelo
 
     /**
      * Constructor
@@ -35,8 +39,8 @@ class AnomalyReport {
      * @param yrd Anomalía del radio en y
      * @param zrd Anomalía del radio en z
      */
-    AnomalyReport(bool similar, const Comparison &generalComparison, long deltaFaces, long totalAnomalies, const std::vector<FaceComparison> &faceComparisons, const std::vector<size_t> &unmatched)
-        : similar(similar), generalComparison(generalComparison), deltaFaces(deltaFaces), totalAnomalies(totalAnomalies), faceComparisons(faceComparisons), unmatched(unmatched) {}
+    AnomalyReport(bool similar, const Comparison &generalComparison, long deltaFaces, long totalAnomalies, const std::vector<FaceComparison> &faceComparisons, const std::vector<size_t> &unmatched, const DeviationReport &deviation = DeviationReport(), const DistanceReport &distance = DistanceReport())
+        : similar(similar), generalComparison(generalComparison), deltaFaces(deltaFaces), totalAnomalies(totalAnomalies), faceComparisons(faceComparisons), unmatched(unmatched), deviation(deviation), distance(distance) {}
     /**
      * Destructor
      */
@@ -0,0 +1,41 @@
+/**
+ * @file ClassificationReport.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición e implementación de la clase ClassificationReport
+ *
+ */
+
+#ifndef CLASSIFICATIONREPORT_CLASS_H
+#define CLASSIFICATIONREPORT_CLASS_H
+
+#include <string>
+#include <vector>
+
+#include "anomaly_detection/AnomalyReport.hh"
+
+/**
+ * @brief Resultado de la comparación de un objeto contra un conjunto de modelos
+ */
+class ClassificationReport {
+   public:
+    const std::vector<std::string> models;     ///< Modelos comparados, ordenados de más a menos parecido al objeto
+    const std::vector<AnomalyReport> reports;  ///< Informe de anomalías de cada modelo comparado, en el mismo orden
+    const std::vector<std::string> pruned;     ///< Modelos descartados por las comprobaciones previas sin comparar sus caras
+
+    /**
+     * Constructor
+     * @param models Modelos comparados en orden de parecido
+     * @param reports Informe de anomalías de cada modelo comparado
+     * @param pruned Modelos descartados
+     */
+    ClassificationReport(const std::vector<std::string> &models, const std::vector<AnomalyReport> &reports, const std::vector<std::string> &pruned)
+        : models(models), reports(reports), pruned(pruned) {}
+    /**
+     * Destructor
+     */
+    ~ClassificationReport() {}
+};
+
+#endif  // CLASSIFICATIONREPORT_CLASS_H
@@ -0,0 +1,54 @@
+/**
+ * @file DeviationReport.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición e implementación de la clase DeviationReport
+ *
+ */
+
+#ifndef DEVIATIONREPORT_CLASS_H
+#define DEVIATIONREPORT_CLASS_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Desviaciones de la superficie de un objeto respecto a la de un modelo tras registrar sus puntos
+ */
+class DeviationReport {
+   public:
+    const bool computed;                   ///< Se ha realizado el análisis de desviaciones
+    const bool similar;                    ///< Las desviaciones se encuentran dentro de la tolerancia
+    const bool converged;                  ///< El registro de los puntos ha convergido
+    const size_t iterations;               ///< Iteraciones realizadas en el registro
+    const double rms;                      ///< Raíz del error cuadrático medio (mm) de las desviaciones
+    const double max;                      ///< Máxima desviación absoluta (mm)
+    const double percentile;               ///< Percentil DEVIATION_PERCENTILE de la desviación absoluta (mm)
+    const size_t outliers;                 ///< Puntos con una desviación absoluta mayor que DEVIATION_THRESHOLD
+    const std::vector<double> deviations;  ///< Mapa de desviaciones: distancia con signo (mm) de cada punto del objeto registrado a la superficie del modelo, positiva hacia el exterior
+
+    /**
+     * Constructor de un informe sin análisis de desviaciones
+     */
+    DeviationReport() : computed(false), similar(true), converged(false), iterations(0), rms(0), max(0), percentile(0), outliers(0), deviations() {}
+    /**
+     * Constructor
+     * @param similar Resultado final del análisis
+     * @param converged Convergencia del registro
+     * @param iterations Iteraciones del registro
+     * @param rms Raíz del error cuadrático medio de las desviaciones
+     * @param max Máxima desviación absoluta
+     * @param percentile Percentil de la desviación absoluta
+     * @param outliers Puntos fuera de la tolerancia
+     * @param deviations Desviación de cada punto del objeto
+     */
+    DeviationReport(bool similar, bool converged, size_t iterations, double rms, double max, double percentile, size_t outliers, const std::vector<double> &deviations)
+        : computed(true), similar(similar), converged(converged), iterations(iterations), rms(rms), max(max), percentile(percentile), outliers(outliers), deviations(deviations) {}
+    /**
+     * Destructor
+     */
+    ~DeviationReport() {}
+};
+
+#endif  // DEVIATIONREPORT_CLASS_H
@@ -0,0 +1,49 @@
+/**
+ * @file DistanceReport.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición e implementación de la clase DistanceReport
+ *
+ */
+
+#ifndef DISTANCEREPORT_CLASS_H
+#define DISTANCEREPORT_CLASS_H
+
+/**
+ * @brief Distancias de Chamfer y Hausdorff entre los puntos de un objeto registrado y los de un modelo. Solo las
+ * distancias del objeto al modelo deciden la similitud, ya que los puntos del modelo ocultos en el escaneo del
+ * objeto no tienen correspondencia y aumentan las distancias simétricas
+ */
+class DistanceReport {
+   public:
+    const bool computed;             ///< Se han calculado las distancias
+    const bool similar;              ///< La distancia media del objeto al modelo se encuentra dentro de la tolerancia
+    const bool exceeded;             ///< Un punto del objeto ha superado el umbral de la distancia de Hausdorff y se ha detenido el cálculo
+    const double chamfer;            ///< Distancia de Chamfer simétrica (mm): media de las distancias al punto más cercano en ambos sentidos. Infinita si se ha detenido el cálculo
+    const double hausdorff;          ///< Distancia de Hausdorff simétrica (mm), o la primera distancia mayor que el umbral si se ha detenido el cálculo
+    const double directedChamfer;    ///< Media de las distancias (mm) de los puntos del objeto al más cercano del modelo. Infinita si se ha detenido el cálculo
+    const double directedHausdorff;  ///< Máxima distancia (mm) de un punto del objeto al más cercano del modelo, o la primera mayor que el umbral
+
+    /**
+     * Constructor de un informe sin cálculo de distancias
+     */
+    DistanceReport() : computed(false), similar(true), exceeded(false), chamfer(0), hausdorff(0), directedChamfer(0), directedHausdorff(0) {}
+    /**
+     * Constructor
+     * @param similar Resultado final de la comparación de distancias
+     * @param exceeded Superación del umbral de Hausdorff
+     * @param chamfer Distancia de Chamfer simétrica
+     * @param hausdorff Distancia de Hausdorff simétrica
+     * @param directedChamfer Distancia de Chamfer del objeto al modelo
+     * @param directedHausdorff Distancia de Hausdorff del objeto al modelo
+     */
+    DistanceReport(bool similar, bool exceeded, double chamfer, double hausdorff, double directedChamfer, double directedHausdorff)
+        : computed(true), similar(similar), exceeded(exceeded), chamfer(chamfer), hausdorff(hausdorff), directedChamfer(directedChamfer), directedHausdorff(directedHausdorff) {}
+    /**
+     * Destructor
+     */
+    ~DistanceReport() {}
+};
+
+#endif  // DISTANCEREPORT_CLASS_H
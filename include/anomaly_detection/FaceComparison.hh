@@ -23,6 +23,9 @@ class FaceComparison : public Comparison {
    public:
     const size_t modelFace;   ///< Índice de la cara del modelo usada
     const size_t objectFace;  ///< Índice de la cara del objeto usada
+    const bool flat;          ///< Booleano que establece si la cara del objeto es tan plana como la del modelo
+    const double deltaRMS;    ///< Diferencia del residuo medio del ajuste al plano (objeto - modelo)
+    const double deltaMax;    ///< Diferencia del residuo máximo del ajuste al plano (objeto - modelo)
 
     /**
      * Constructor
@@ -31,11 +34,17 @@ class FaceComparison : public Comparison {
      * @param deltas Deltas de los lados de la bounding box mínima de la cara
      * @param desviation Ángulo entre normales de las caras en radianes
      * @param result Resultado final de la comparación
+     * @param flat Resultado de la comparación de los residuos del ajuste al plano
+     * @param deltaRMS Diferencia del residuo medio del ajuste al plano
+     * @param deltaMax Diferencia del residuo máximo del ajuste al plano
      */
-    FaceComparison(bool similar, size_t modelFace, size_t objectFace, const Vector &deltas)
+    FaceComparison(bool similar, size_t modelFace, size_t objectFace, const Vector &deltas, bool flat, double deltaRMS, double deltaMax)
         : Comparison(similar, deltas),
           modelFace(modelFace),
-          objectFace(objectFace) {}
+          objectFace(objectFace),
+          flat(flat),
+          deltaRMS(deltaRMS),
+          deltaMax(deltaMax) {}
     /**
      * Destructor
      */
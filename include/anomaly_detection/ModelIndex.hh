@@ -0,0 +1,104 @@
+/**
+ * @file ModelIndex.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición del objeto ModelIndex
+ *
+ */
+
+#ifndef MODELINDEX_CLASS_H
+#define MODELINDEX_CLASS_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <utility>
+#include <cstddef>
+
+#include "object_characterization/CharacterizedObject.hh"
+#include "app/config.h"
+
+/**
+ * @brief Índice de descriptores de forma de una biblioteca de modelos para obtener los candidatos más parecidos
+ * a un objeto sin compararlo con todos ellos.
+ * Los descriptores se almacenan en un árbol KD que se actualiza con cada inserción y se reconstruye equilibrado
+ * cuando su profundidad crece demasiado
+ */
+class ModelIndex {
+   public:
+    static constexpr size_t kDimensions = 4 + MODEL_INDEX_HISTOGRAM_BINS;  ///< Número de componentes de un descriptor
+    typedef std::array<double, kDimensions> Descriptor;                   ///< Descriptor de forma de un modelo
+
+   private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);  ///< Nodo inexistente
+
+    std::vector<std::string> names;         ///< Nombre de cada modelo, en orden de inserción
+    std::vector<Descriptor> descriptors;    ///< Descriptor de cada modelo
+    std::vector<size_t> left;               ///< Hijo izquierdo del nodo de cada modelo
+    std::vector<size_t> right;              ///< Hijo derecho del nodo de cada modelo
+    std::vector<size_t> axis;               ///< Componente de división del nodo de cada modelo
+    size_t root;                            ///< Nodo raíz del árbol
+
+   public:
+    /**
+     * Constructor de un índice vacío
+     */
+    ModelIndex() : root(kNone) {}
+
+    /**
+     * Calcula el descriptor de forma de un objeto: dimensiones de su bounding box ordenadas de mayor a menor,
+     * número de caras e histograma de áreas de las caras, ponderados para ser comparables en milímetros
+     * @param object Objeto a describir
+     * @return Descriptor del objeto
+     */
+    static Descriptor describe(const CharacterizedObject &object);
+
+    /**
+     * Añade un modelo al índice
+     * @param name Nombre del modelo
+     * @param model Modelo a añadir
+     */
+    void insert(const std::string &name, const CharacterizedObject &model) { insert(name, describe(model)); }
+    /**
+     * Añade un descriptor al índice
+     * @param name Nombre del modelo
+     * @param descriptor Descriptor del modelo
+     */
+    void insert(const std::string &name, const Descriptor &descriptor);
+
+    /**
+     * Busca los modelos con el descriptor más cercano al de un objeto
+     * @param object Objeto a buscar
+     * @param k Número máximo de modelos a devolver
+     * @return Nombre de los modelos y distancia de sus descriptores, de menor a mayor distancia
+     */
+    std::vector<std::pair<std::string, double>> nearest(const CharacterizedObject &object, size_t k) const { return nearest(describe(object), k); }
+    /**
+     * Busca los modelos con el descriptor más cercano al especificado
+     * @param descriptor Descriptor a buscar
+     * @param k Número máximo de modelos a devolver
+     * @return Nombre de los modelos y distancia de sus descriptores, de menor a mayor distancia
+     */
+    std::vector<std::pair<std::string, double>> nearest(const Descriptor &descriptor, size_t k) const;
+
+    ////// Getters
+    /**
+     * Devuelve el número de modelos del índice
+     * @return Número de modelos
+     */
+    size_t size() const { return names.size(); }
+    /**
+     * Devuelve la profundidad actual del árbol
+     * @return Número de niveles del árbol
+     */
+    size_t depth() const;
+
+   private:
+    // Reconstruye el árbol equilibrado dividiendo por la mediana de la componente de mayor dispersión
+    void rebuild();
+    // Construye el subárbol equilibrado de los modelos especificados y devuelve su raíz
+    size_t build(std::vector<size_t> &entries, size_t begin, size_t end);
+};
+
+#endif  // MODELINDEX_CLASS_H
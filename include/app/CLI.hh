@@ -12,11 +12,14 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
+#include <map>
 
 #include "scanner/IScanner.hh"
 #include "scanner/ScannerCSV.hh"
 #include "scanner/ScannerLVX.hh"
 #include "scanner/ScannerLidar.hh"
+#include "scanner/ScannerMerged.hh"
 #include "object_characterization/ObjectCharacterizer.hh"
 #include "anomaly_detection/AnomalyDetector.hh"
 #include "app/ObjectManager.hh"
@@ -92,6 +95,30 @@ class CLI {
 
         execution();
     }
+    /**
+     * Constructor de la CLI para input de varios sensores lidar combinados
+     * @param broadcastCodes Codigos de broadcast de los sensores lidar
+     * @param extrinsics Transformaciones extrínsecas de los sensores indexadas por su codigo de broadcast
+     * @param chronoMode Tipo de mediciones de tiempo a tomar
+     * @param objFrame Milisegundos que debe durar un frame en el caracterizador de objetos
+     * @param backFrame Milisegundos en los que los puntos tomados formarán parte del background
+     * @param minReflectivity Reflectividad mínima que necesitan los puntos para no ser descartados
+     * @param backDistance Distancia mínima a la que tiene que estar un punto para no pertenecer al background
+     */
+    CLI(const std::vector<std::string> &broadcastCodes, const std::map<std::string, SensorExtrinsic> &extrinsics, ChronoMode chronoMode, uint32_t objFrame, uint32_t backFrame, float minReflectivity, float backDistance) {
+        std::vector<std::pair<IScanner *, SensorExtrinsic>> sensors;
+        for (const std::string &code : broadcastCodes) {
+            auto extrinsic = extrinsics.find(code);
+            sensors.push_back({ScannerLidar::create(code.c_str()), extrinsic != extrinsics.end() ? extrinsic->second : SensorExtrinsic()});
+        }
+
+        IScanner *scanner = ScannerMerged::create(sensors);
+        oc = new ObjectCharacterizer(scanner, objFrame, backFrame, minReflectivity, backDistance, chronoMode & kChronoCharacterization);
+        om = new ObjectManager();
+        ad = new AnomalyDetector(chronoMode & kChronoAnomalyDetection);
+
+        execution();
+    }
     /**
      * Destructor de la CLI
      */
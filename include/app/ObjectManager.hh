@@ -16,6 +16,7 @@
 #include <utility>
 
 #include "object_characterization/CharacterizedObject.hh"
+#include "anomaly_detection/ModelIndex.hh"
 
 /**
  * @brief Gestor de modelos y objetos
@@ -24,6 +25,7 @@ class ObjectManager {
    private:
     std::unordered_map<std::string, Model> *models;
     std::unordered_map<std::string, CharacterizedObject> *objects;
+    ModelIndex *index;  ///< Índice de descriptores de forma de los modelos
     uint32_t objID;
 
    public:
@@ -33,6 +35,7 @@ class ObjectManager {
     ObjectManager() : objID(0) {
         models = new std::unordered_map<std::string, Model>();
         objects = new std::unordered_map<std::string, CharacterizedObject>();
+        index = new ModelIndex();
     }
     /**
      * Destructor
@@ -40,6 +43,7 @@ class ObjectManager {
     ~ObjectManager() {
         delete models;
         delete objects;
+        delete index;
     }
 
     /**
@@ -48,18 +52,18 @@ class ObjectManager {
      * @param obj Objeto a guardar
      * @return true si se ha guardado correctamente
      */
-    bool newObject(const std::string &objname, const CharacterizedObject &obj) { return objects->insert({objname, obj}).second; };
+    bool newObject(const std::string &objname, CharacterizedObject &&obj) { return objects->try_emplace(objname, std::move(obj)).second; };
 
     /**
      * Guarda un nuevo objecto bajo un nombre generico
      * @param obj Objeto a guardar
      * @return pair con boolean a false si no se ha guardado o true y el nombre del objeto si se ha guardado correctamente
      */
-    std::pair<bool, std::string> newObject(const CharacterizedObject &obj) {
+    std::pair<bool, std::string> newObject(CharacterizedObject &&obj) {
         std::string name;
         do {
             name = "object-" + std::to_string(objID++);
-        } while (!newObject(name, obj));
+        } while (!newObject(name, std::move(obj)));  // try_emplace no mueve el objeto si el nombre ya existe
 
         return {true, name};
     }
@@ -73,7 +77,7 @@ class ObjectManager {
         if (objects->find(object) == objects->end()) {
             auto m = CharacterizedObject::load(filename);
             if (m.first) {
-                return objects->insert({object, m.second}).second;
+                return objects->try_emplace(object, std::move(m.second)).second;
             }
         }
         return false;
@@ -117,8 +121,12 @@ class ObjectManager {
      */
     bool newModel(const std::string &objname, const std::string &modelname) {
         auto oitr = objects->find(objname);
-        if (oitr != objects->end()) {
-            return models->insert({modelname, oitr->second}).second;
+        if (oitr != objects->end() && models->find(modelname) == models->end()) {
+            auto mitr = models->try_emplace(modelname, oitr->second.clone());
+            if (mitr.second) {
+                index->insert(modelname, mitr.first->second);
+            }
+            return mitr.second;
         }
         return false;
     }
@@ -132,7 +140,11 @@ class ObjectManager {
         if (models->find(model) == models->end()) {
             auto m = Model::load(filename);
             if (m.first) {
-                return models->insert({model, m.second}).second;
+                auto mitr = models->try_emplace(model, std::move(m.second));
+                if (mitr.second) {
+                    index->insert(model, mitr.first->second);
+                }
+                return mitr.second;
             }
         }
         return false;
@@ -174,6 +186,11 @@ class ObjectManager {
      * @return Lista de modelos
      */
     const std::unordered_map<std::string, Model> &getModels() const { return *models; }
+    /**
+     * Obtiene el índice de descriptores de forma de los modelos disponibles
+     * @return Índice de modelos
+     */
+    const ModelIndex &getModelIndex() const { return *index; }
     /**
      * Obtiene la lista de objetos actualmente disponibles
      * @return Lista de objetos
@@ -29,25 +29,68 @@ enum ChronoMode {
     kChronoAll = 0b11,               ///< Ejecución con medida de tiempo en todo el programa
 };
 
+/* Escaneo */
+#define MERGED_SCANNER_BUFFER       24000  ///< Puntos máximos en el buffer de reordenación de cada sensor del escaner combinado (100ms de un LIVOX Horizon)
+
+/* Archivos de objetos */
+#define OBJECT_FILE_VERIFY_CHECKSUMS false  ///< Comprobar la suma de verificación de cada sección al cargar un objeto (la cabecera se comprueba siempre)
+
 /* OpenMP **/
 #define OMP_SCHEDULE_TYPE           guided  ///< Tipo de distribución para los bucles for
 #define OMP_CHUNK_SIZE              1       ///< Tipo de distribución para los bucles for
 
 /* Geometría */
 #define RAD_PER_DEG                 (M_PI / 180.)  ///< Total de radianes correspondientes a un grado
+#define BBOX_SEARCH_MODE            kBBoxGridSearch  ///< Método de búsqueda de las bounding boxes de mínimo volumen (kBBoxGridSearch o kBBoxHullSearch)
+#define BBOX_BATCH_SIZE             64               ///< Rotaciones candidatas evaluadas con un mismo producto de matrices en la búsqueda en rejilla
+#define BBOX_BATCH_MAX_ELEMENTS     (1 << 20)        ///< Número máximo de coordenadas rotadas calculadas por lote, limitando la memoria de cada lote
+#define BBOX_GRID_SCHEDULE          {{6, 1.}, {1, 1.}}  ///< Etapas {separación en grados, fracción de puntos} de la búsqueda en rejilla (p. ej. {{6, 0.05}, {2, 0.25}, {1, 1.}} para submuestrear las primeras etapas)
+#define BBOX_GRID_MIN_SAMPLE        256              ///< Número mínimo de puntos de las submuestras de la búsqueda en rejilla
+#define KDTREE_LEAF_SIZE            8                ///< Número máximo de puntos de las hojas de los árboles KD
 
 /* Caracterización de objetos */
 #define MIN_CLUSTER_POINTS          20                  ///< Número mínimo de puntos que debe tener un cluster inicial para ser considerado
+#define MIN_OBJECT_POINTS           500                 ///< Número mínimo de puntos de un cluster para caracterizarlo como objeto al definir varios objetos a la vez
 #define CLUSTER_POINT_PROXIMITY     20                  ///< Proximidad máxima (mm) de un punto hacia uno origen para pertenecer al mismo cluster
 #define MIN_FACE_POINTS             20                  ///< Número mínimo de puntos que debe tener una cara inicial para ser considerada
 #define NORMAL_CALC_POINT_PROXIMITY 60                  ///< Proximidad máxima (mm) de los puntos vecinos que se usarán para calcular la normal de puntos
+#define NORMAL_ESTIMATION_MODE      kNormalExact        ///< Modo de estimación de las normales de los puntos (kNormalExact o kNormalVoxel)
+#define NORMAL_VOXEL_SIZE           15                  ///< Lado (mm) de los vóxeles en la estimación aproximada de normales
+#define NORMAL_VOXEL_MIN_POINTS     20000               ///< Número mínimo de puntos de una nube para estimar sus normales por vóxeles en lugar de exactamente
 #define FACE_POINT_PROXIMITY        30                  ///< Proximidad máxima (mm) de un punto hacia uno origen para pertenecer a la misma cara
+#define NEIGHBOR_GRAPH_PROXIMITY    60                  ///< Radio (mm) del grafo de vecinos de cada cluster compartido por el cálculo de normales y la detección de caras
 #define MAX_NORMAL_VECT_ANGLE       5 * RAD_PER_DEG     ///< (Parcial 1/2) Radianes máximos de separación angular entre normales para pertenecer a la misma cara
 #define MAX_MEAN_VECT_ANGLE         45 * RAD_PER_DEG  ///< (Parcial 2/2) Radianes máximos de separación angular entre una normal y la normal media del cluster para pertenecer a la misma cara
 #define MAX_MEAN_VECT_ANGLE_SINGLE  25 * RAD_PER_DEG    ///< Radianes máximos de separación angular entre una normal y la normal media del cluster para pertenecer a la misma cara
+#define SURFACE_NORMAL_NEIGHBORS    12                  ///< Vecinos más cercanos usados para estimar la normal de cada punto del índice espacial de un objeto
 
 /* Detección de anomalías */
 #define MAX_DIMENSION_DELTA         40                 ///< Máxima diferencia (mm) entre medidas de una bounding box en la misma dimensión
 #define MAX_NORMAL_VECT_ANGLE_AD    1.5 * RAD_PER_DEG  ///< Radianes máximos de separación angular entre normales de las caras para considerarse similares
+#define MAX_FACE_RMS_DELTA          2                  ///< Máximo aumento (mm) del residuo medio del ajuste al plano de una cara del objeto respecto a la del modelo
+#define MAX_FACE_RESIDUAL_DELTA     40                 ///< Máximo aumento (mm) del residuo máximo del ajuste al plano de una cara del objeto respecto a la del modelo, tolerando puntos de las aristas
+#define FACE_MATCHING_MODE          kFaceMatchingOptimal  ///< Método de emparejamiento de las caras de objetos y modelos (kFaceMatchingGreedy o kFaceMatchingOptimal)
+#define FACE_MATCHING_VOLUME_WEIGHT 1.0                ///< Peso de la diferencia relativa de volumen de las bounding boxes en el coste de emparejar dos caras
+#define FACE_MATCHING_DELTA_WEIGHT  1.0                ///< Peso de la diferencia relativa de dimensiones de las bounding boxes en el coste de emparejar dos caras
+#define FACE_MATCHING_NORMAL_WEIGHT 0.5                ///< Peso del ángulo entre normales (fracción de 90º) en el coste de emparejar dos caras
+#define CLASSIFY_MAX_BBOX_DELTA     (3 * MAX_DIMENSION_DELTA)  ///< Máxima diferencia (mm) entre medidas de las bounding boxes globales para comparar las caras de un modelo candidato
+#define CLASSIFY_MAX_FACE_DELTA     2                  ///< Máxima diferencia en el número de caras para comparar las caras de un modelo candidato
+#define MODEL_INDEX_CANDIDATES      32                 ///< Número de modelos más parecidos según su descriptor de forma que se comparan con el objeto al clasificarlo
+#define MODEL_INDEX_HISTOGRAM_BINS  8                  ///< Intervalos del histograma de áreas de las caras del descriptor de forma (cada uno cuadruplica el área del anterior)
+#define MODEL_INDEX_MIN_FACE_AREA   100                ///< Límite superior (mm²) del primer intervalo del histograma de áreas de las caras
+#define MODEL_INDEX_FACE_WEIGHT     50                 ///< Peso (mm por cara) del número de caras en el descriptor de forma
+#define MODEL_INDEX_HISTOGRAM_WEIGHT 25                ///< Peso (mm por cara) de cada intervalo del histograma de áreas en el descriptor de forma
+#define DEVIATION_ANALYSIS          false              ///< Registrar los puntos del objeto sobre el modelo y analizar sus desviaciones al comparar
+#define DEVIATION_THRESHOLD         10                 ///< Máxima desviación (mm) de un punto registrado respecto a la superficie del modelo
+#define DEVIATION_MAX_OUTLIERS      0.02               ///< Máxima fracción de puntos con una desviación mayor que DEVIATION_THRESHOLD para considerar similares objeto y modelo
+#define DEVIATION_PERCENTILE        0.95               ///< Percentil de la desviación absoluta incluido en el informe de desviaciones
+#define ICP_SAMPLE_POINTS           4000               ///< Número máximo de puntos del objeto usados en cada iteración del registro ICP
+#define ICP_MAX_ITERATIONS          30                 ///< Número máximo de iteraciones del registro ICP
+#define ICP_MAX_CORRESPONDENCE      50                 ///< Máxima distancia (mm) entre un punto del objeto y su correspondiente del modelo en el registro ICP
+#define ICP_CONVERGENCE_ROTATION    (0.01 * RAD_PER_DEG)  ///< Rotación (radianes) por debajo de la cual se considera convergido el registro ICP
+#define ICP_CONVERGENCE_TRANSLATION 0.01               ///< Traslación (mm) por debajo de la cual se considera convergido el registro ICP
+#define DISTANCE_METRICS            false              ///< Calcular las distancias de Chamfer y Hausdorff entre objeto y modelo registrados al comparar
+#define CHAMFER_THRESHOLD           5                  ///< Máxima distancia de Chamfer (mm) del objeto al modelo para considerarlos similares
+#define HAUSDORFF_THRESHOLD         40                 ///< Máxima distancia de Hausdorff (mm) del objeto al modelo, superada la cual se detiene su cálculo
 
 #endif  // CONFIG_DEFINITIONS_H
\ No newline at end of file
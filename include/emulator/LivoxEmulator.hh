@@ -0,0 +1,172 @@
+/**
+ * @file LivoxEmulator.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición del objeto LivoxEmulator
+ *
+ */
+
+#ifndef LIVOXEMULATOR_CLASS_H
+#define LIVOXEMULATOR_CLASS_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <stdint.h>
+#include <netinet/in.h>
+
+#include "livox_def.h"
+
+#define LIVOX_BROADCAST_PORT        55000  ///< Puerto en el que el SDK escucha los mensajes de broadcast
+#define LIVOX_COMMAND_PORT          65000  ///< Puerto en el que el sensor escucha los comandos del SDK
+#define LIVOX_HORIZON_PACKET_RATE   2500   ///< Paquetes por segundo enviados por un LIVOX Horizon (240000 puntos/s en paquetes de 96 puntos)
+#define LIVOX_HEARTBEAT_TIMEOUT     3000   ///< Tiempo (ms) sin recibir comandos tras el cual se considera desconectado el SDK
+
+/**
+ * @brief Emulador de un sensor LiDAR LIVOX que implementa el protocolo UDP del Livox SDK 2.3.
+ * Anuncia el sensor mediante broadcast, responde a los comandos del SDK y reproduce los
+ * paquetes de puntos de un archivo lvx a la frecuencia de envío especificada
+ */
+class LivoxEmulator {
+   private:
+    std::string filename;                    ///< Archivo lvx a reproducir
+    char broadcastCode[kBroadcastCodeSize];  ///< Código de broadcast del sensor emulado
+    std::string hostIp;                      ///< IP a la que se envían los mensajes de broadcast
+    bool loop;                               ///< Reproducción continua del archivo
+
+    std::vector<uint8_t> packets;  ///< Paquetes de puntos cargados del archivo
+    size_t packetSize;             ///< Tamaño de cada paquete de puntos
+    size_t pointsPerPacket;        ///< Puntos contenidos en cada paquete
+
+    int cmdSocket;             ///< Socket de comandos y broadcast
+    int dataSocket;            ///< Socket de envío de puntos
+    sockaddr_in dataAddress;   ///< Dirección a la que se envían los paquetes de puntos
+    std::mutex addressMutex;   ///< Mutex de acceso a la dirección de envío de puntos
+    uint16_t broadcastSeq;     ///< Número de secuencia de los mensajes de broadcast
+
+    std::atomic<double> packetRate;          ///< Paquetes por segundo a enviar
+    std::atomic<bool> running;               ///< Emulador en ejecución
+    std::atomic<bool> connected;             ///< SDK conectado al emulador
+    std::atomic<bool> sampling;              ///< Envío de puntos activado por el SDK
+    std::atomic<int64_t> lastCommand;        ///< Instante (ms) en el que se recibió el último comando
+    std::atomic<uint64_t> sentPackets;       ///< Paquetes de puntos enviados
+    std::atomic<uint64_t> sentPoints;        ///< Puntos enviados
+
+    std::thread broadcastThread;  ///< Hilo de envío de broadcast
+    std::thread commandThread;    ///< Hilo de recepción de comandos
+    std::thread dataThread;       ///< Hilo de envío de puntos
+
+   public:
+    /**
+     * Constructor del objeto LivoxEmulator
+     * @param filename Archivo lvx a reproducir
+     * @param code Código de broadcast del sensor emulado
+     * @param packetRate Paquetes de puntos por segundo a enviar
+     * @param loop Reproducir el archivo de forma continua
+     * @param hostIp IP a la que se envían los mensajes de broadcast
+     */
+    LivoxEmulator(const std::string &filename, const char code[kBroadcastCodeSize], double packetRate = LIVOX_HORIZON_PACKET_RATE, bool loop = true, const std::string &hostIp = "127.0.0.1");
+    /**
+     * Destructor del emulador
+     */
+    ~LivoxEmulator();
+
+    /**
+     * Carga los paquetes del archivo lvx y abre los sockets del emulador
+     * @return true si se ha inicializado el emulador correctamente
+     */
+    bool init();
+
+    /**
+     * Comienza a anunciar el sensor y a atender las peticiones del SDK
+     * @return true si se han lanzado los hilos del emulador
+     */
+    bool start();
+
+    /**
+     * Detiene el emulador y cierra los sockets
+     */
+    void stop();
+
+    ////// Setters
+    /**
+     * Modifica la frecuencia de envío de paquetes de puntos. Un valor nulo detiene el envío
+     * @param rate Paquetes por segundo a enviar
+     */
+    void setPacketRate(double rate) { packetRate = rate; }
+
+    ////// Getters
+    /**
+     * Devuelve la frecuencia de envío de paquetes de puntos
+     * @return Paquetes por segundo a enviar
+     */
+    double getPacketRate() const { return packetRate; }
+    /**
+     * Devuelve el número de paquetes de puntos cargados del archivo
+     * @return Número de paquetes cargados
+     */
+    size_t getLoadedPackets() const { return packetSize ? packets.size() / packetSize : 0; }
+    /**
+     * Devuelve si el SDK está conectado al emulador
+     * @return true si el SDK ha realizado el handshake y mantiene el heartbeat
+     */
+    bool isConnected() const { return connected; }
+    /**
+     * Devuelve si el SDK ha activado el envío de puntos
+     * @return true si el emulador está enviando puntos
+     */
+    bool isSampling() const { return sampling; }
+    /**
+     * Devuelve el número de paquetes de puntos enviados
+     * @return Paquetes enviados
+     */
+    uint64_t getSentPackets() const { return sentPackets; }
+    /**
+     * Devuelve el número de puntos enviados
+     * @return Puntos enviados
+     */
+    uint64_t getSentPoints() const { return sentPoints; }
+
+    /**
+     * Reinicia los contadores de paquetes y puntos enviados
+     */
+    void resetStatistics() {
+        sentPackets = 0;
+        sentPoints = 0;
+    }
+
+   private:
+    /**
+     * Carga en memoria los paquetes de puntos cartesianos del archivo lvx
+     * @return true si se ha cargado al menos un paquete
+     */
+    bool loadPackets();
+
+    /**
+     * Envía periódicamente el mensaje de broadcast mientras el SDK no esté conectado
+     */
+    void broadcastLoop();
+
+    /**
+     * Recibe y responde a los comandos del SDK
+     */
+    void commandLoop();
+
+    /**
+     * Envía los paquetes de puntos a la frecuencia establecida
+     */
+    void dataLoop();
+
+    /**
+     * Procesa un comando del SDK y envía su respuesta
+     * @param buffer Paquete recibido
+     * @param length Longitud del paquete
+     * @param sender Dirección de origen del paquete
+     */
+    void handleCommand(const uint8_t *buffer, size_t length, const sockaddr_in &sender);
+};
+
+#endif  // LIVOXEMULATOR_CLASS_H
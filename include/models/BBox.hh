@@ -15,6 +15,7 @@
 #include "armadillo"
 
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 
 /**
  * @brief Bounding box de un conjunto de puntos
@@ -61,14 +62,14 @@ class BBox {
     }
     /**
      * Constructor
-     * @param points Vector de referencias a los puntos sobre los que construir la bounding box
+     * @param points Vista de los puntos sobre los que construir la bounding box
      */
-    BBox(const std::vector<Point *> &points) {
+    BBox(const PointCloudView &points) {
         if (points.size() > 0) {
-            min = *points[0];
+            min = points[0];
             max = min;
             for (size_t i = 1; i < points.size(); ++i) {
-                const Point &p = *points[i];
+                const Point p = points[i];
                 if (min.getX() > p.getX()) {
                     min.setX(p.getX());
                 } else if (max.getX() < p.getX()) {
@@ -120,15 +121,15 @@ class BBox {
     }
     /**
      * Constructor
-     * @param points Vector de referencias a los puntos sobre los que construirá la bounding box
+     * @param points Vista de los puntos sobre los que construirá la bounding box
      * @param rot Matriz de rotación a aplicar a los puntos
      */
-    BBox(const std::vector<Point *> &points, const arma::mat33 &rot) {
+    BBox(const PointCloudView &points, const arma::mat33 &rot) {
         if (points.size() > 0) {
-            min = points[0]->rotate(rot);
+            min = points[0].rotate(rot);
             max = min;
             for (size_t i = 1; i < points.size(); ++i) {
-                Point p = points[i]->rotate(rot);
+                Point p = points[i].rotate(rot);
                 if (min.getX() > p.getX()) {
                     min.setX(p.getX());
                 } else if (max.getX() < p.getX()) {
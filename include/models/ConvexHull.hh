@@ -0,0 +1,88 @@
+/**
+ * @file ConvexHull.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición del objeto ConvexHull
+ *
+ */
+
+#ifndef CONVEXHULL_CLASS_H
+#define CONVEXHULL_CLASS_H
+
+#include <vector>
+#include <array>
+#include <cstddef>
+
+#include "models/Point.hh"
+#include "models/PointCloud.hh"
+
+/**
+ * @brief Envolvente convexa 3D de un conjunto de puntos calculada mediante el algoritmo Quickhull.
+ * Si los puntos son coplanares, colineales o menos de cuatro la envolvente se considera degenerada
+ * y únicamente se devuelven como vértices todos los puntos
+ */
+class ConvexHull {
+   private:
+    std::vector<Point> vertices;                  ///< Vértices de la envolvente
+    std::vector<size_t> indices;                  ///< Posición de cada vértice en el conjunto de puntos original
+    std::vector<std::array<size_t, 3>> faces;     ///< Caras triangulares, con índices sobre los vértices y orientadas hacia el exterior
+    std::vector<Vector> normals;                  ///< Normal exterior unitaria de cada cara
+    bool degenerate;                              ///< La envolvente no tiene volumen
+
+   public:
+    /**
+     * Constructor de una envolvente vacía
+     */
+    ConvexHull() : degenerate(true) {}
+    /**
+     * Constructor
+     * @param points Vista de los puntos a envolver
+     */
+    ConvexHull(const PointCloudView &points);
+    /**
+     * Constructor
+     * @param points Puntos a envolver
+     */
+    ConvexHull(const std::vector<Point> &points);
+
+    /**
+     * Actualiza los vértices y las normales de las caras tras aplicar una transformación rígida a los puntos
+     * originales, conservando la topología de la envolvente sin volver a calcularla
+     * @param points Puntos originales ya transformados, en el mismo orden
+     */
+    void update(const PointCloudView &points);
+
+    ////// Getters
+    /**
+     * Devuelve los vértices de la envolvente
+     * @return Vértices de la envolvente, o todos los puntos si es degenerada
+     */
+    const std::vector<Point> &getVertices() const { return vertices; }
+    /**
+     * Devuelve la posición de cada vértice en el conjunto de puntos original
+     * @return Índices de los vértices
+     */
+    const std::vector<size_t> &getIndices() const { return indices; }
+    /**
+     * Devuelve las caras triangulares de la envolvente
+     * @return Caras con índices sobre los vértices, vacío si la envolvente es degenerada
+     */
+    const std::vector<std::array<size_t, 3>> &getFaces() const { return faces; }
+    /**
+     * Devuelve las normales exteriores de las caras de la envolvente
+     * @return Normales unitarias de las caras
+     */
+    const std::vector<Vector> &getNormals() const { return normals; }
+    /**
+     * Comprueba si la envolvente es degenerada (puntos coplanares, colineales o insuficientes)
+     * @return true si la envolvente no tiene volumen
+     */
+    bool isDegenerate() const { return degenerate; }
+
+   private:
+    // Calcula la envolvente de los puntos especificados
+    void build(const std::vector<Point> &points);
+};
+
+#endif  // CONVEXHULL_CLASS_H
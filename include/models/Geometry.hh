@@ -16,8 +16,36 @@
 #include "armadillo"
 
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 #include "models/Octree.hh"
+#include "models/NeighborGraph.hh"
+#include "models/ConvexHull.hh"
 #include "models/BBox.hh"
+#include "app/config.h"
+
+/**
+ * Modos de estimación de las normales de una nube de puntos
+ */
+enum NormalMode {
+    kNormalExact,  ///< Covarianza exacta del vecindario de cada punto
+    kNormalVoxel   ///< Covarianza aproximada a partir de los momentos de los vóxeles que cubren el vecindario
+};
+
+/**
+ * Métodos de búsqueda de la bounding box de mínimo volumen
+ */
+enum BBoxMode {
+    kBBoxGridSearch,  ///< Búsqueda en una rejilla de rotaciones sobre los vértices de la envolvente convexa
+    kBBoxHullSearch   ///< Orientaciones candidatas de la envolvente convexa evaluadas sobre sus vértices
+};
+
+/**
+ * Etapa de la búsqueda en rejilla de la bounding box de mínimo volumen
+ */
+struct GridStage {
+    int step;         ///< Separación (grados) entre los ángulos candidatos de la etapa
+    double fraction;  ///< Fracción de los puntos sobre la que se evalúan los candidatos de la etapa
+};
 
 /**
  * @brief Clase utilizada como almacén de métodos geométricos y espaciales
@@ -32,10 +60,10 @@ class Geometry {
     static Point computeCentroid(const std::vector<Point> &points);
     /**
      * Calcula el centroide de los puntos
-     * @param points Referencias a los puntos de los que se calculará el centroide
+     * @param points Vista de los puntos de los que se calculará el centroide
      * @return Centroide
      */
-    static Point computeCentroid(const std::vector<Point *> &points);
+    static Point computeCentroid(const PointCloudView &points);
 
     /**
      * Obtiene la normal de un plano
@@ -44,20 +72,54 @@ class Geometry {
      */
     static Vector computeNormal(const std::vector<Point> &points);
     /**
-     * Obtiene la normal de un plano
-     * @param points Referencias a los puntos del plano sobre los que se calculará la normal
+     * Obtiene la normal de un plano a partir de su matriz de covarianza 3x3, sin construir la matriz de puntos
+     * ni llamar a LAPACK. Equivale numéricamente a la normal obtenida mediante SVD
+     * @param points Vista de los puntos del plano sobre los que se calculará la normal
      * @return Vector normal
      */
-    static Vector computeNormal(const std::vector<Point *> &points);
+    static Vector computeNormal(const PointCloudView &points);
+
+    /**
+     * Calcula la matriz de covarianza, sin normalizar, de los puntos respecto a su centroide
+     * @param points Vista de los puntos
+     * @param cov Matriz simétrica 3x3 en la que se devuelve la covarianza
+     */
+    static void computeCovariance(const PointCloudView &points, double cov[3][3]);
+    /**
+     * Obtiene el vector propio unitario del menor valor propio de una matriz simétrica 3x3 mediante rotaciones de Jacobi
+     * @param m Matriz simétrica, que queda diagonalizada tras la llamada
+     * @return Vector propio
+     */
+    static Vector smallestEigenvector(double m[3][3]);
+    /**
+     * Calcula los residuos de los puntos especificados respecto al plano que pasa por su centroide con la normal dada
+     * @param points Nube de puntos
+     * @param indices Índices de los puntos a evaluar
+     * @param normal Normal del plano
+     * @return Raíz del error cuadrático medio y máxima distancia absoluta de los puntos al plano
+     */
+    static std::pair<double, double> planeResiduals(const PointCloud &points, const std::vector<size_t> &indices, const Vector &normal);
 
     /**
      * Calculo de normales de un grupo de puntos
      * @param points Puntos de los que se calcularán las normales
-     * @param map Octree con los puntos del vector de puntos
+     * @param graph Grafo de vecinos de la nube de puntos, con un radio mayor o igual que la distancia
+     * @param distance Máxima distancia a la que pueden estar los puntos para considerarse vecinos
+     * @param mode Modo de estimación de las normales. En modo kNormalVoxel no se utiliza el grafo de vecinos, salvo en nubes
+     * de menos de NORMAL_VOXEL_MIN_POINTS puntos, en las que se calculan las normales exactas por ser más rápidas
+     * @return vector de normales, siendo 0 aquellas de los puntos que no se les pudo calcular la normal
+     */
+    static std::vector<Vector> computeNormals(const PointCloud &points, const NeighborGraph &graph, double distance, NormalMode mode = kNormalExact);
+    /**
+     * Calculo aproximado de normales de un grupo de puntos. Se acumulan una única vez los momentos de primer y segundo orden
+     * de cada vóxel y la covarianza del vecindario de cada punto se obtiene sumando los momentos de los vóxeles cuyo centro
+     * está a menos de la distancia especificada del centro de su vóxel, con un coste por punto independiente de la densidad
+     * @param points Puntos de los que se calcularán las normales
      * @param distance Máxima distancia a la que pueden estar los puntos para considerarse vecinos
+     * @param voxelSize Lado (mm) de los vóxeles
      * @return vector de normales, siendo 0 aquellas de los puntos que no se les pudo calcular la normal
      */
-    static std::vector<Vector> computeNormals(std::vector<Point> &points, const Octree &map, double distance);
+    static std::vector<Vector> computeVoxelNormals(const PointCloud &points, double distance, double voxelSize = NORMAL_VOXEL_SIZE);
 
     /**
      * Obtiene el plano con el vector normal especificado y que pasa sobre el centroide
@@ -74,10 +136,10 @@ class Geometry {
     static arma::vec4 computePlane(const std::vector<Point> &points);
     /**
      * Calcula el plano de un conjunto de puntos
-     * @param points Referencias a los puntos pertenecientes al plano
+     * @param points Vista de los puntos pertenecientes al plano
      * @return Plano
      */
-    static arma::vec4 computePlane(const std::vector<Point *> &points);
+    static arma::vec4 computePlane(const PointCloudView &points);
 
     /**
      * Calcula la media de un vector de puntos
@@ -111,28 +173,99 @@ class Geometry {
      * Rota los puntos para buscar la bounding box de mínimo volumen que los englobe:
      * todos los puntos se rotarán según los angulos que den como resultado la bounding box de mínimo volumen
      * y posteriormente serán transladados a (0,0,0)
-     * @param points Vector de referencias a los puntos
+     * @param points Nube de puntos a transformar
+     * @param mode Método de búsqueda de la bounding box
      * @return Bounding box de mínimo volumen y vector de los ángulos de rotación utilizados en grados
      */
-    static std::pair<BBox, Vector> minimumBBoxRotTrans(std::vector<Point> &points);
+    static std::pair<BBox, Vector> minimumBBoxRotTrans(PointCloud &points, BBoxMode mode = BBOX_SEARCH_MODE);
+    /**
+     * Rota los puntos para buscar la bounding box de mínimo volumen que los englobe, evaluando las rotaciones candidatas
+     * únicamente sobre los vértices de su envolvente convexa ya calculada
+     * @param points Nube de puntos a transformar
+     * @param hull Envolvente convexa de los puntos
+     * @param mode Método de búsqueda de la bounding box
+     * @return Bounding box de mínimo volumen y vector de los ángulos de rotación utilizados en grados
+     */
+    static std::pair<BBox, Vector> minimumBBoxRotTrans(PointCloud &points, const ConvexHull &hull, BBoxMode mode = BBOX_SEARCH_MODE);
 
     /**
      * Obtiene la bounding box de mínimo volumen que engloba los puntos
      * @param points Vector de puntos
+     * @param mode Método de búsqueda de la bounding box
+     * @return Bounding box de mínimo volumen y vector de los ángulos de rotación utilizados en grados
+     */
+    static std::pair<BBox, Vector> minimumBBox(const std::vector<Point> &points, BBoxMode mode = BBOX_SEARCH_MODE);
+    /**
+     * Obtiene la bounding box de mínimo volumen que engloba los puntos
+     * @param points Vista de los puntos
+     * @param mode Método de búsqueda de la bounding box
      * @return Bounding box de mínimo volumen y vector de los ángulos de rotación utilizados en grados
      */
-    static std::pair<BBox, Vector> minimumBBox(const std::vector<Point> &points);
+    static std::pair<BBox, Vector> minimumBBox(const PointCloudView &points, BBoxMode mode = BBOX_SEARCH_MODE);
+    /**
+     * Obtiene la bounding box de mínimo volumen que engloba los puntos a partir de su envolvente convexa,
+     * ya que solo sus vértices pueden definir los extremos de cualquier bounding box
+     * @param hull Envolvente convexa de los puntos
+     * @param mode Método de búsqueda de la bounding box
+     * @return Bounding box de mínimo volumen y vector de los ángulos de rotación utilizados en grados
+     */
+    static std::pair<BBox, Vector> minimumBBox(const ConvexHull &hull, BBoxMode mode = BBOX_SEARCH_MODE);
 
     /**
-     * Obtiene las bounding box de mínimo volumen que engloban a cada vector de referencias a puntos (caras de un objeto)
-     * @param points Vector de vectores de referencias a puntos
+     * Obtiene las bounding box de mínimo volumen que engloban a cada vista de puntos (caras de un objeto)
+     * @param points Vector de vistas de puntos
+     * @param mode Método de búsqueda de las bounding boxes
+     * @return Vector de bounding boxes de mínimo volumen y vectores de los ángulos de rotación utilizados en grados
+     */
+    static std::vector<std::pair<BBox, Vector>> minimumBBoxes(const std::vector<PointCloudView> &points, BBoxMode mode = BBOX_SEARCH_MODE);
+    /**
+     * Obtiene las bounding box de mínimo volumen que engloban a cada conjunto de puntos a partir de sus envolventes convexas
+     * @param hulls Vector de envolventes convexas
+     * @param mode Método de búsqueda de las bounding boxes
      * @return Vector de bounding boxes de mínimo volumen y vectores de los ángulos de rotación utilizados en grados
      */
-    static std::vector<std::pair<BBox, Vector>> minimumBBoxes(const std::vector<std::vector<Point *>> &points);
+    static std::vector<std::pair<BBox, Vector>> minimumBBoxes(const std::vector<ConvexHull> &hulls, BBoxMode mode = BBOX_SEARCH_MODE);
+
+    /**
+     * Obtiene la bounding box orientada de mínimo volumen de una envolvente convexa. Se evalúan sobre los vértices de la
+     * envolvente las orientaciones con un eje paralelo a la normal de alguna de sus caras o a alguno de sus ejes principales,
+     * tomando para cada eje el rectángulo de área mínima de la proyección de los vértices sobre el plano perpendicular
+     * @param hull Envolvente convexa de los puntos
+     * @return Bounding box de mínimo volumen, con los puntos mínimo y máximo en el sistema rotado, y vector de los ángulos de rotación en grados
+     */
+    static std::pair<BBox, Vector> minimumBBoxHull(const ConvexHull &hull);
+
+    /**
+     * Obtiene los ángulos de rotación en grados que generan una matriz de rotación, inversa de rotationMatrix
+     * @param rot Matriz de rotación
+     * @return Vector con los ángulos de rotación en grados en cada coordenada
+     */
+    static Vector rotationAngles(const arma::mat33 &rot);
+
+    /**
+     * Calcula las bounding boxes de unos puntos rotados según cada una de las matrices de rotación especificadas.
+     * Las rotaciones se agrupan en lotes apilados en una única matriz, de forma que las coordenadas rotadas de todos
+     * los candidatos de un lote se obtienen con un solo producto de matrices, hecho fuera de las regiones paralelas de OpenMP
+     * @param points Vista de los puntos
+     * @param rotations Matrices de rotación candidatas
+     * @return Bounding box de los puntos rotados según cada matriz, en el mismo orden
+     */
+    static std::vector<BBox> rotatedBBoxes(const PointCloudView &points, const std::vector<arma::mat33> &rotations);
+
+    /**
+     * Búsqueda en rejilla de la rotación de menor volumen de cada conjunto de puntos.
+     * La primera etapa recorre ángulos de 0 a 90º y cada etapa siguiente refina alrededor de la mejor rotación de la anterior,
+     * con desplazamientos múltiplos de su propia separación que cubren todos los ángulos hasta los vecinos de la etapa anterior. Cada etapa se evalúa sobre una submuestra de los puntos según su fracción,
+     * salvo la última, que utiliza siempre todos los puntos
+     * @param points Vector de vistas de puntos
+     * @param schedule Etapas de la búsqueda, de la más amplia a la más fina
+     * @return Bounding box de mínimo volumen de cada conjunto, sin reorientar, y vector de los ángulos de rotación utilizados en grados
+     */
+    static std::vector<std::pair<BBox, Vector>> gridSearch(const std::vector<PointCloudView> &points, const std::vector<GridStage> &schedule = BBOX_GRID_SCHEDULE);
 
    private:
     static void computeSVD(const std::vector<Point> &points, arma::mat &U, arma::vec &s, arma::mat &V);
-    static void computeSVD(const std::vector<Point *> &points, arma::mat &U, arma::vec &s, arma::mat &V);
+    static void computeSVD(const PointCloudView &points, arma::mat &U, arma::vec &s, arma::mat &V);
     // Obtención de la rotación necesaria adicional para obtener la bbox cúbica de menor largo, ancho y alto, en ese orden
     static std::pair<BBox, Vector> bestOrientation(const BBox &bbox);
     // Comparación de bounding boxes para comprobar cual tiene una mejor orientación
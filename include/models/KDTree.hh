@@ -0,0 +1,88 @@
+/**
+ * @file KDTree.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición del objeto KDTree
+ *
+ */
+
+#ifndef KDTREE_CLASS_H
+#define KDTREE_CLASS_H
+
+#include <vector>
+#include <utility>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+#include "models/Point.hh"
+#include "models/PointCloud.hh"
+
+/**
+ * @brief Árbol KD estático sobre las coordenadas de una nube de puntos para búsquedas del vecino más cercano.
+ * Las coordenadas se copian reordenadas por hojas, de forma que cada hoja se recorre de forma contigua en memoria
+ */
+class KDTree {
+   private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);  ///< Nodo inexistente
+
+    /**
+     * Nodo del árbol. Los nodos internos dividen sus puntos por un plano perpendicular a un eje
+     */
+    struct Node {
+        float split;   ///< Coordenada del plano de división
+        int axis;      ///< Eje de división (0, 1 o 2), o -1 en las hojas
+        size_t left;   ///< Hijo con coordenadas menores o iguales que la división
+        size_t right;  ///< Hijo con coordenadas mayores o iguales que la división
+        size_t begin;  ///< Primer punto de la hoja
+        size_t end;    ///< Posición siguiente al último punto de la hoja
+    };
+
+    std::vector<Node> nodes;      ///< Nodos del árbol, con la raíz en la primera posición
+    std::vector<size_t> indices;  ///< Índice en la nube original de cada punto reordenado
+    std::vector<float> xs;        ///< Coordenadas x de los puntos reordenados
+    std::vector<float> ys;        ///< Coordenadas y de los puntos reordenados
+    std::vector<float> zs;        ///< Coordenadas z de los puntos reordenados
+
+   public:
+    /**
+     * Constructor de un árbol vacío
+     */
+    KDTree() {}
+    /**
+     * Constructor
+     * @param points Puntos a indexar
+     */
+    KDTree(const PointCloud &points);
+
+    /**
+     * Busca el punto más cercano al especificado
+     * @param p Punto de consulta
+     * @param maxDistance Distancia máxima a la que buscar
+     * @return Índice del punto más cercano en la nube original y su distancia, o el número de puntos del árbol
+     * y una distancia infinita si no existe ningún punto a menos de la distancia máxima
+     */
+    std::pair<size_t, double> nearest(const Point &p, double maxDistance = std::numeric_limits<double>::infinity()) const;
+
+    /**
+     * Busca los k puntos más cercanos al especificado
+     * @param p Punto de consulta
+     * @param k Número de puntos a buscar
+     * @return Índices de los puntos más cercanos en la nube original, de menor a mayor distancia
+     */
+    std::vector<size_t> nearestK(const Point &p, size_t k) const;
+
+    ////// Getters
+    /**
+     * Devuelve el número de puntos del árbol
+     * @return Número de puntos
+     */
+    size_t size() const { return indices.size(); }
+
+   private:
+    // Construye el subárbol de los puntos especificados y devuelve su nodo raíz
+    size_t build(const PointCloud &points, std::vector<size_t> &order, size_t begin, size_t end);
+};
+
+#endif  // KDTREE_CLASS_H
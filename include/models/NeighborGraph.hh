@@ -0,0 +1,107 @@
+/**
+ * @file NeighborGraph.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición del objeto NeighborGraph
+ *
+ */
+
+#ifndef NEIGHBORGRAPH_CLASS_H
+#define NEIGHBORGRAPH_CLASS_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "models/PointCloud.hh"
+#include "models/Octree.hh"
+
+/**
+ * Rango de vecinos de un punto dentro del grafo de vecinos
+ */
+struct NeighborRange {
+    const uint32_t *first;  ///< Primer vecino
+    const uint32_t *last;   ///< Posición siguiente al último vecino
+
+    const uint32_t *begin() const { return first; }
+    const uint32_t *end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    size_t operator[](size_t i) const { return first[i]; }
+};
+
+/**
+ * @brief Grafo de vecindad de una nube de puntos almacenado en formato CSR (compressed sparse row).
+ * Se construye una única vez para el radio máximo requerido, guardando los vecinos de cada punto
+ * ordenados por distancia, de forma que los vecindarios de radio menor se obtienen como prefijos de la fila
+ * sin volver a consultar el índice espacial. Cada arista ocupa 8 bytes (índice uint32_t y distancia float), por lo que
+ * la nube no puede superar 2^32 puntos y el grafo debe construirse con el menor radio que necesite cada etapa
+ */
+class NeighborGraph {
+   private:
+    double radius;                    ///< Radio (mm) con el que se construyó el grafo
+    std::vector<size_t> offsets;      ///< Inicio de la fila de cada punto en el vector de vecinos (tamaño n + 1)
+    std::vector<uint32_t> neighbors;  ///< Vecinos de todos los puntos, incluido el propio punto
+    std::vector<float> distances;     ///< Distancia al cuadrado (mm²) de cada vecino a su punto
+
+   public:
+    /**
+     * Constructor de un grafo vacío
+     */
+    NeighborGraph() : radius(0), offsets(1, 0) {}
+    /**
+     * Constructor del grafo de una nube de puntos
+     * @param points Nube de puntos
+     * @param radius Radio (mm) de vecindad máximo
+     */
+    NeighborGraph(const PointCloud &points, double radius);
+    /**
+     * Constructor del grafo de una nube de puntos a partir de un octree ya construido sobre ella
+     * @param points Nube de puntos
+     * @param map Octree construido sobre la nube de puntos
+     * @param radius Radio (mm) de vecindad máximo
+     */
+    NeighborGraph(const PointCloud &points, const Octree &map, double radius);
+
+    /**
+     * Devuelve los vecinos de un punto dentro del radio del grafo, ordenados por distancia
+     * @param i Índice del punto
+     * @return Rango de vecinos
+     */
+    NeighborRange neighborsOf(size_t i) const { return {neighbors.data() + offsets[i], neighbors.data() + offsets[i + 1]}; }
+    /**
+     * Devuelve los vecinos de un punto dentro de un radio menor o igual que el del grafo, ordenados por distancia
+     * @param i Índice del punto
+     * @param r Radio (mm) de vecindad
+     * @return Rango de vecinos
+     */
+    NeighborRange neighborsOf(size_t i, double r) const;
+
+    /**
+     * Devuelve la distancia al cuadrado entre un punto y uno de sus vecinos
+     * @param i Índice del punto
+     * @param k Posición del vecino dentro de la fila del punto
+     * @return Distancia al cuadrado (mm²)
+     */
+    double squaredDistance(size_t i, size_t k) const { return distances[offsets[i] + k]; }
+
+    ////// Getters
+    /**
+     * Devuelve el número de puntos del grafo
+     * @return Número de puntos
+     */
+    size_t size() const { return offsets.size() - 1; }
+    /**
+     * Devuelve el número total de aristas del grafo
+     * @return Número de aristas
+     */
+    size_t edges() const { return neighbors.size(); }
+    /**
+     * Devuelve el radio con el que se construyó el grafo
+     * @return Radio (mm)
+     */
+    double getRadius() const { return radius; }
+};
+
+#endif  // NEIGHBORGRAPH_CLASS_H
@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 #include "models/Kernel.hh"
 
 class Box {
@@ -50,9 +51,15 @@ class Octree {
     Point min_{};
     Point max_{};
     std::vector<Point *> points_{};
+    std::vector<size_t> indices_{};  // Indices of the points when built over a PointCloud
+    const float *xs_{};              // Coordinate columns of the PointCloud
+    const float *ys_{};
+    const float *zs_{};
     unsigned int numPoints_{};
     float radius_{};
 
+    Point indexedPoint(size_t i) const { return Point(xs_[i], ys_[i], zs_[i]); }
+
    public:
     Octree();
 
@@ -62,6 +69,7 @@ class Octree {
     void setMin(const Point &min) { min_ = min; }
     void setMax(const Point &max) { max_ = max; }
     const std::vector<Point *> &getPoints() const { return points_; }
+    const std::vector<size_t> &getIndices() const { return indices_; }
     void setPoints(const std::vector<Point *> &points) { points_ = points; }
     unsigned int getNumPoints() const { return numPoints_; }
     void setNumPoints(unsigned int numPoints) { numPoints_ = numPoints; }
@@ -73,12 +81,14 @@ class Octree {
     Octree(const Vector &center, const float radius);
     Octree(Vector center, float radius, std::vector<Point *> &points);
     Octree(Vector center, float radius, std::vector<Point> &points);
+    Octree(const PointCloud &cloud);
 
     void computeOctreeLimits();
     bool isInside2D(Point &p) const;
     void insertPoints(std::vector<Point> &points);
     void insertPoints(std::vector<Point *> &points);
     void insertPoint(Point *p);
+    void insertIndex(size_t i);
     void createOctants();
     void fillOctants();
     int octantIdx(Point *p);
@@ -86,6 +96,7 @@ class Octree {
     bool isEmpty() const;
     void buildOctree(std::vector<Point> &points);
     void buildOctree(std::vector<Point *> &points);
+    void buildOctree(const PointCloud &cloud);
     const Vector &getCenter() const;
     float getRadius() const;
     static void makeBox(const Point &p, double radius, Vector &min, Vector &max);
@@ -107,6 +118,8 @@ class Octree {
 
     std::vector<Point *> searchNeighbors(const Point &p, double radius, const Kernel_t &k_t) const;
     std::vector<Point *> neighbors(std::unique_ptr<AbstractKernel> &k, std::vector<Point *> &ptsInside) const;
+    std::vector<size_t> searchNeighborIndices(const Point &p, double radius, const Kernel_t &k_t) const;
+    void neighborIndices(std::unique_ptr<AbstractKernel> &k, std::vector<size_t> &idxInside) const;
     std::vector<Point *> searchNeighbors2D(const Point &p, double radius);
     std::vector<Point *> searchNeighbors2D(Point &p, double radius);
     std::vector<Point *> searchNeighbors2DUntilGround(const Point &p, double radius);
@@ -140,4 +153,5 @@ class Octree {
 // Functions
 Vector mbbCenter(Vector &min, Vector &radius);
 Vector mbbRadii(Vector &min, Vector &max, float &maxRadius);
-Vector mbb(const std::vector<Point> &points, float &maxRadius);
\ No newline at end of file
+Vector mbb(const std::vector<Point> &points, float &maxRadius);
+Vector mbb(const PointCloud &points, float &maxRadius);
\ No newline at end of file
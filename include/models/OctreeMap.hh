@@ -17,6 +17,7 @@
 
 #include "models/Octree.hh"
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 #include "models/LidarPoint.hh"
 #include "models/Timestamp.hh"
 
@@ -28,7 +29,7 @@ class OctreeMap {
     std::pair<bool, Timestamp> startTime;  ///< Timestamp del primer punto
     Octree map;                            ///< Mapa de puntos
     std::set<std::string> keys;            ///< Claves de unicidad de las coordenadas
-    std::vector<Point> points;             ///< Buffer de almacenaje de puntos
+    PointCloud points;                     ///< Buffer de almacenaje de puntos
 
    public:
     /**
@@ -39,6 +40,8 @@ class OctreeMap {
      * Destructor
      */
     ~OctreeMap() {}
+    OctreeMap(OctreeMap &&) = default;
+    OctreeMap &operator=(OctreeMap &&) = default;
 
     /**
      * Inserta un punto nuevo en el vector de puntos. Si el punto ya se encuentra en el vector, se descarta
@@ -79,9 +82,9 @@ class OctreeMap {
     const Octree &getMap() const { return map; }
     /**
      * Devuelve el vector de puntos
-     * @return Vector de puntos del objeto
+     * @return Nube de puntos del objeto
      */
-    const std::vector<Point> &getPoints() const { return points; }
+    const PointCloud &getPoints() const { return points; }
 };
 
 #endif  // OCTREEMAP_CLASS_H
\ No newline at end of file
@@ -19,46 +19,35 @@
 #include "armadillo"
 
 /**
- * Enum de tipos de cluster
- */
-enum PointCluster {
-    cUnclassified = -1,  ///< Punto no clasificado
-    cCorePoint = -2,     ///< Punto core
-    cBorderPoint = -3,   ///< Punto frontera
-    cNoise = -4          ///< Ruido
-};
-
-/**
- * @brief Representación de un punto perteneciente a una nube de puntos tridimensional
+ * @brief Representación de un punto perteneciente a una nube de puntos tridimensional.
+ * Las coordenadas se mantienen en precisión doble para su uso como vectores (normales, ángulos); el almacenamiento
+ * compacto en precisión simple se limita a las columnas de PointCloud
  */
 class Point {
    private:
     double x;  ///< Localización en el eje x del punto
     double y;  ///< Localización en el eje y del punto
     double z;  ///< Localización en el eje z del punto
-    int cID;   ///< Cluster ID
 
    public:
     /**
      * Constructor
      */
-    Point() : x(), y(), z(), cID(cUnclassified) {}
+    Point() : x(), y(), z() {}
     /**
      * Constructor
      * @param x Posición en x del punto
      * @param y Posición en y del punto
      * @param z Posición en z del punto
-     * @param cID Cluster ID
      */
-    Point(double x, double y, double z, int cID = cUnclassified) : x(x), y(y), z(z), cID(cID) {}
+    Point(double x, double y, double z) : x(x), y(y), z(z) {}
     /**
      * Constructor
      * @param x Posición en x del punto
      * @param y Posición en y del punto
      * @param z Posición en z del punto
-     * @param cID Cluster ID
      */
-    Point(int x, int y, int z, int cID = cUnclassified) : x((double)x), y((double)y), z((double)z), cID(cID) {}
+    Point(int x, int y, int z) : x((double)x), y((double)y), z((double)z) {}
 
     ////// Operaciones tridimensionales
     /**
@@ -124,11 +113,6 @@ class Point {
      * @return Posición en z del punto
      */
     double getZ() const { return z; }
-    /**
-     * Devuelve el ID del cluster al que pertenece el punto
-     * @return ID del cluster
-     */
-    int getClusterID() const { return cID; }
 
     ////// Setters
     /**
@@ -146,11 +130,6 @@ class Point {
      * @param z Valor de z a establecer
      */
     void setZ(double z) { this->z = z; }
-    /**
-     * Setter del ID del cluster al que pertenece el punto
-     * @param cID ID del nuevo cluster
-     */
-    void setClusterID(int cID) { this->cID = cID; }
 
     ////// Strings e impresión
     /**
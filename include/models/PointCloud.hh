@@ -0,0 +1,485 @@
+/**
+ * @file PointCloud.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición e implementación de los objetos PointCloud y PointCloudView
+ *
+ */
+
+#ifndef POINTCLOUD_CLASS_H
+#define POINTCLOUD_CLASS_H
+
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <memory>
+#include <stdint.h>
+
+#include "models/Point.hh"
+#include "models/LidarPoint.hh"
+#include "models/Timestamp.hh"
+
+class PointCloudView;
+
+/**
+ * @brief Nube de puntos almacenada por columnas (x, y, z, reflectividad y timestamp).
+ * Los atributos LiDAR son opcionales: solo existen si se ha insertado algún LidarPoint.
+ * La nube no es copiable de forma implícita para evitar copias accidentales de los puntos entre etapas,
+ * siendo necesario llamar a clone() para duplicarla.
+ * Las coordenadas pueden residir en memoria externa de solo lectura (por ejemplo, un archivo proyectado en memoria),
+ * que se copia a la propia nube la primera vez que se modifica
+ */
+class PointCloud {
+   private:
+    std::vector<float> x;                ///< Coordenadas x de los puntos
+    std::vector<float> y;                ///< Coordenadas y de los puntos
+    std::vector<float> z;                ///< Coordenadas z de los puntos
+    std::vector<uint32_t> reflectivity;  ///< Reflectividad de los puntos (vacío si la nube no tiene atributos)
+    std::vector<Timestamp> timestamps;   ///< Timestamps de los puntos (vacío si la nube no tiene atributos)
+
+    std::shared_ptr<const void> storage;  ///< Memoria externa con las coordenadas, nula si la nube almacena sus propios puntos
+    const float *ex = nullptr;            ///< Coordenadas x de los puntos en la memoria externa
+    const float *ey = nullptr;            ///< Coordenadas y de los puntos en la memoria externa
+    const float *ez = nullptr;            ///< Coordenadas z de los puntos en la memoria externa
+    size_t en = 0;                        ///< Número de puntos en la memoria externa
+
+   public:
+    /**
+     * Iterador de lectura de los puntos de la nube
+     */
+    class const_iterator {
+       private:
+        const PointCloud *cloud;  ///< Nube recorrida
+        size_t i;                 ///< Índice del punto actual
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Point *;
+        using reference = Point;
+
+        const_iterator(const PointCloud *cloud, size_t i) : cloud(cloud), i(i) {}
+        Point operator*() const { return (*cloud)[i]; }
+        const_iterator &operator++() {
+            ++i;
+            return *this;
+        }
+        bool operator==(const const_iterator &it) const { return i == it.i; }
+        bool operator!=(const const_iterator &it) const { return i != it.i; }
+    };
+
+    /**
+     * Constructor
+     */
+    PointCloud() {}
+    /**
+     * Constructor
+     * @param points Puntos de la nube
+     */
+    explicit PointCloud(const std::vector<Point> &points) {
+        reserve(points.size());
+        for (const Point &p : points) {
+            push_back(p);
+        }
+    }
+    /**
+     * Constructor
+     * @param points Puntos LiDAR de la nube
+     */
+    explicit PointCloud(const std::vector<LidarPoint> &points) {
+        reserve(points.size());
+        for (const LidarPoint &p : points) {
+            push_back(p);
+        }
+    }
+    PointCloud(const PointCloud &) = delete;
+    PointCloud &operator=(const PointCloud &) = delete;
+    PointCloud(PointCloud &&) = default;
+    PointCloud &operator=(PointCloud &&) = default;
+    /**
+     * Destructor
+     */
+    ~PointCloud() {}
+
+    /**
+     * Crea una nube sobre coordenadas almacenadas en memoria externa, sin copiarlas
+     * @param storage Propietario de la memoria externa, que se mantiene mientras exista alguna nube que la utilice
+     * @param x Coordenadas x de los puntos
+     * @param y Coordenadas y de los puntos
+     * @param z Coordenadas z de los puntos
+     * @param n Número de puntos
+     * @return Nube de solo lectura sobre la memoria externa, sin atributos LiDAR
+     */
+    static PointCloud external(std::shared_ptr<const void> storage, const float *x, const float *y, const float *z, size_t n) {
+        PointCloud c;
+        c.storage = std::move(storage);
+        c.ex = x;
+        c.ey = y;
+        c.ez = z;
+        c.en = n;
+        return c;
+    }
+
+    /**
+     * Crea una copia de la nube
+     * @return Nube con los mismos puntos y atributos. Si la nube utiliza memoria externa, la copia la comparte
+     */
+    PointCloud clone() const {
+        PointCloud c;
+        if (storage) {
+            c.storage = storage;
+            c.ex = ex;
+            c.ey = ey;
+            c.ez = ez;
+            c.en = en;
+            return c;
+        }
+        c.x = x;
+        c.y = y;
+        c.z = z;
+        c.reflectivity = reflectivity;
+        c.timestamps = timestamps;
+        return c;
+    }
+
+    /**
+     * Crea una nueva nube con los puntos especificados
+     * @param indices Índices de los puntos a copiar
+     * @return Nube con los puntos especificados en el orden dado
+     */
+    PointCloud subset(const std::vector<size_t> &indices) const {
+        PointCloud c;
+        c.reserve(indices.size(), hasAttributes());
+        const float *px = xData(), *py = yData(), *pz = zData();
+        for (size_t i : indices) {
+            c.x.push_back(px[i]);
+            c.y.push_back(py[i]);
+            c.z.push_back(pz[i]);
+            if (hasAttributes()) {
+                c.reflectivity.push_back(reflectivity[i]);
+                c.timestamps.push_back(timestamps[i]);
+            }
+        }
+        return c;
+    }
+
+    /**
+     * Reserva memoria para el número de puntos especificado
+     * @param n Número de puntos
+     * @param attributes Reservar también memoria para los atributos LiDAR
+     */
+    void reserve(size_t n, bool attributes = false) {
+        detach();
+        x.reserve(n);
+        y.reserve(n);
+        z.reserve(n);
+        if (attributes) {
+            reflectivity.reserve(n);
+            timestamps.reserve(n);
+        }
+    }
+
+    /**
+     * Añade un punto a la nube
+     * @param p Punto a añadir
+     */
+    void push_back(const Point &p) {
+        detach();
+        x.push_back((float)p.getX());
+        y.push_back((float)p.getY());
+        z.push_back((float)p.getZ());
+        if (hasAttributes()) {
+            reflectivity.push_back(0);
+            timestamps.push_back(Timestamp(0, 0));
+        }
+    }
+    /**
+     * Añade un punto LiDAR a la nube
+     * @param p Punto a añadir
+     */
+    void push_back(const LidarPoint &p) {
+        detach();
+        // Los puntos anteriores sin atributos toman valores nulos
+        if (reflectivity.size() < x.size()) {
+            reflectivity.resize(x.size(), 0);
+            timestamps.resize(x.size(), Timestamp(0, 0));
+        }
+        x.push_back((float)p.getX());
+        y.push_back((float)p.getY());
+        z.push_back((float)p.getZ());
+        reflectivity.push_back(p.getReflectivity());
+        timestamps.push_back(p.getTimestamp());
+    }
+
+    /**
+     * Vacía la nube
+     */
+    void clear() {
+        storage.reset();
+        x.clear();
+        y.clear();
+        z.clear();
+        reflectivity.clear();
+        timestamps.clear();
+    }
+
+    /**
+     * Devuelve el número de puntos de la nube
+     * @return Número de puntos
+     */
+    size_t size() const { return storage ? en : x.size(); }
+    /**
+     * Comprueba si la nube está vacía
+     * @return true si la nube no tiene puntos
+     */
+    bool empty() const { return size() == 0; }
+    /**
+     * Comprueba si la nube almacena los atributos LiDAR de los puntos
+     * @return true si existen reflectividades y timestamps
+     */
+    bool hasAttributes() const { return !reflectivity.empty(); }
+
+    /**
+     * Devuelve un punto de la nube
+     * @param i Índice del punto
+     * @return Punto con las coordenadas especificadas
+     */
+    Point operator[](size_t i) const { return Point(getX(i), getY(i), getZ(i)); }
+    /**
+     * Devuelve un punto de la nube junto con sus atributos LiDAR
+     * @param i Índice del punto
+     * @return Punto LiDAR, con atributos nulos si la nube no los almacena
+     */
+    LidarPoint lidarPoint(size_t i) const {
+        return hasAttributes() ? LidarPoint(timestamps[i], reflectivity[i], (*this)[i]) : LidarPoint((*this)[i]);
+    }
+    /**
+     * Establece las coordenadas de un punto de la nube
+     * @param i Índice del punto
+     * @param p Nuevas coordenadas
+     */
+    void set(size_t i, const Point &p) {
+        detach();
+        x[i] = (float)p.getX();
+        y[i] = (float)p.getY();
+        z[i] = (float)p.getZ();
+    }
+
+    /**
+     * Devuelve todos los puntos de la nube
+     * @return Vector de puntos
+     */
+    std::vector<Point> toPoints() const {
+        std::vector<Point> points;
+        points.reserve(size());
+        for (size_t i = 0; i < size(); ++i) {
+            points.push_back((*this)[i]);
+        }
+        return points;
+    }
+
+    ////// Getters
+    /**
+     * Devuelve la coordenada x de un punto
+     * @param i Índice del punto
+     * @return Coordenada x
+     */
+    float getX(size_t i) const { return xData()[i]; }
+    /**
+     * Devuelve la coordenada y de un punto
+     * @param i Índice del punto
+     * @return Coordenada y
+     */
+    float getY(size_t i) const { return yData()[i]; }
+    /**
+     * Devuelve la coordenada z de un punto
+     * @param i Índice del punto
+     * @return Coordenada z
+     */
+    float getZ(size_t i) const { return zData()[i]; }
+    /**
+     * Devuelve la reflectividad de un punto
+     * @param i Índice del punto
+     * @return Reflectividad, 0 si la nube no tiene atributos
+     */
+    uint32_t getReflectivity(size_t i) const { return hasAttributes() ? reflectivity[i] : 0; }
+    /**
+     * Devuelve el timestamp de un punto
+     * @param i Índice del punto
+     * @return Timestamp, nulo si la nube no tiene atributos
+     */
+    Timestamp getTimestamp(size_t i) const { return hasAttributes() ? timestamps[i] : Timestamp(0, 0); }
+    /**
+     * Devuelve la columna de coordenadas x
+     * @return Puntero a las coordenadas x de todos los puntos
+     */
+    const float *xData() const { return storage ? ex : x.data(); }
+    /**
+     * Devuelve la columna de coordenadas y
+     * @return Puntero a las coordenadas y de todos los puntos
+     */
+    const float *yData() const { return storage ? ey : y.data(); }
+    /**
+     * Devuelve la columna de coordenadas z
+     * @return Puntero a las coordenadas z de todos los puntos
+     */
+    const float *zData() const { return storage ? ez : z.data(); }
+
+    ////// Iteradores
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    ////// Vistas
+    /**
+     * Crea una vista de toda la nube
+     * @return Vista de la nube
+     */
+    PointCloudView view() const;
+    /**
+     * Crea una vista de un rango de puntos de la nube
+     * @param begin Índice del primer punto
+     * @param end Índice siguiente al último punto
+     * @return Vista del rango de puntos
+     */
+    PointCloudView view(size_t begin, size_t end) const;
+    /**
+     * Crea una vista de un conjunto de puntos de la nube
+     * @param indices Índices de los puntos, que deben existir mientras se utilice la vista
+     * @return Vista de los puntos especificados
+     */
+    PointCloudView view(const std::vector<size_t> &indices) const;
+
+    /**
+     * Comprueba si las coordenadas de la nube residen en memoria externa
+     * @return true si la nube no almacena sus propios puntos
+     */
+    bool isExternal() const { return (bool)storage; }
+
+   private:
+    // Copia las coordenadas de la memoria externa a la nube antes de modificarla
+    void detach() {
+        if (storage) {
+            x.assign(ex, ex + en);
+            y.assign(ey, ey + en);
+            z.assign(ez, ez + en);
+            storage.reset();
+        }
+    }
+};
+
+/**
+ * @brief Vista de solo lectura sobre un rango o un conjunto de índices de una PointCloud, sin copia de puntos.
+ * La nube (y el vector de índices, si existe) deben existir mientras se utilice la vista
+ */
+class PointCloudView {
+   private:
+    const PointCloud *cloud;  ///< Nube de puntos
+    const size_t *indices;    ///< Índices de los puntos en la nube o nullptr si la vista es un rango
+    size_t first;             ///< Primer punto del rango
+    size_t count;             ///< Número de puntos de la vista
+
+   public:
+    /**
+     * Iterador de lectura de los puntos de la vista
+     */
+    class const_iterator {
+       private:
+        const PointCloudView *view;  ///< Vista recorrida
+        size_t i;                    ///< Posición actual en la vista
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Point;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Point *;
+        using reference = Point;
+
+        const_iterator(const PointCloudView *view, size_t i) : view(view), i(i) {}
+        Point operator*() const { return (*view)[i]; }
+        const_iterator &operator++() {
+            ++i;
+            return *this;
+        }
+        bool operator==(const const_iterator &it) const { return i == it.i; }
+        bool operator!=(const const_iterator &it) const { return i != it.i; }
+    };
+
+    /**
+     * Constructor de una vista de toda la nube
+     * @param cloud Nube de puntos
+     */
+    PointCloudView(const PointCloud &cloud) : cloud(&cloud), indices(nullptr), first(0), count(cloud.size()) {}
+    PointCloudView(PointCloud &&) = delete;  // La vista no puede sobrevivir a una nube temporal
+    /**
+     * Constructor de una vista de un rango de la nube
+     * @param cloud Nube de puntos
+     * @param begin Índice del primer punto
+     * @param end Índice siguiente al último punto
+     */
+    PointCloudView(const PointCloud &cloud, size_t begin, size_t end) : cloud(&cloud), indices(nullptr), first(begin), count(end > begin ? end - begin : 0) {}
+    /**
+     * Constructor de una vista de un conjunto de puntos de la nube
+     * @param cloud Nube de puntos
+     * @param indices Índices de los puntos
+     */
+    PointCloudView(const PointCloud &cloud, const std::vector<size_t> &indices) : cloud(&cloud), indices(indices.data()), first(0), count(indices.size()) {}
+    /**
+     * Constructor de una vista de un conjunto de puntos de la nube
+     * @param cloud Nube de puntos
+     * @param indices Índices de los puntos
+     * @param count Número de índices
+     */
+    PointCloudView(const PointCloud &cloud, const size_t *indices, size_t count) : cloud(&cloud), indices(indices), first(0), count(count) {}
+
+    /**
+     * Devuelve el número de puntos de la vista
+     * @return Número de puntos
+     */
+    size_t size() const { return count; }
+    /**
+     * Comprueba si la vista está vacía
+     * @return true si la vista no tiene puntos
+     */
+    bool empty() const { return count == 0; }
+    /**
+     * Devuelve el índice en la nube de un punto de la vista
+     * @param i Posición del punto en la vista
+     * @return Índice del punto en la nube
+     */
+    size_t index(size_t i) const { return indices ? indices[i] : first + i; }
+    /**
+     * Devuelve un punto de la vista
+     * @param i Posición del punto en la vista
+     * @return Punto
+     */
+    Point operator[](size_t i) const { return (*cloud)[index(i)]; }
+    /**
+     * Devuelve la nube sobre la que se define la vista
+     * @return Nube de puntos
+     */
+    const PointCloud &getCloud() const { return *cloud; }
+
+    /**
+     * Copia los puntos de la vista a una nueva nube
+     * @return Nube con los puntos de la vista
+     */
+    PointCloud subset() const {
+        std::vector<size_t> idx(count);
+        for (size_t i = 0; i < count; ++i) {
+            idx[i] = index(i);
+        }
+        return cloud->subset(idx);
+    }
+
+    ////// Iteradores
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
+
+inline PointCloudView PointCloud::view() const { return PointCloudView(*this); }
+inline PointCloudView PointCloud::view(size_t begin, size_t end) const { return PointCloudView(*this, begin, end); }
+inline PointCloudView PointCloud::view(const std::vector<size_t> &indices) const { return PointCloudView(*this, indices); }
+
+#endif  // POINTCLOUD_CLASS_H
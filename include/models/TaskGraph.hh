@@ -0,0 +1,214 @@
+/**
+ * @file TaskGraph.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición e implementación del objeto TaskGraph
+ *
+ */
+
+#ifndef TASKGRAPH_CLASS_H
+#define TASKGRAPH_CLASS_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <stdexcept>
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+#include <omp.h>
+
+/**
+ * @brief Grafo de dependencias entre tareas ejecutado por un conjunto de hilos trabajadores.
+ * Cada tarea comienza en cuanto terminan todas sus dependencias, de forma que las tareas independientes se solapan.
+ * Las dependencias solo pueden referirse a tareas añadidas previamente, por lo que el grafo es siempre acíclico.
+ * Los hilos de OpenMP del que llama se reparten entre las tareas que pueden ejecutarse a la vez, para que sus
+ * regiones paralelas no sobresuscriban la máquina
+ */
+class TaskGraph {
+   public:
+    typedef size_t TaskID;  ///< Identificador de una tarea, según su orden de inserción
+
+   private:
+    /**
+     * Tarea del grafo
+     */
+    struct Task {
+        std::string name;                  ///< Nombre de la tarea
+        std::function<void()> work;        ///< Trabajo a realizar
+        std::vector<TaskID> dependencies;  ///< Tareas que deben terminar antes de comenzar esta
+        std::vector<TaskID> successors;    ///< Tareas que dependen de esta
+        double begin;                      ///< Instante de inicio (s) relativo al comienzo de la ejecución
+        double end;                        ///< Instante de finalización (s) relativo al comienzo de la ejecución
+    };
+
+    std::vector<Task> tasks;  ///< Tareas del grafo
+    double wall;              ///< Duración (s) de la última ejecución completa del grafo
+
+   public:
+    /**
+     * Constructor de un grafo vacío
+     */
+    TaskGraph() : wall(0) {}
+
+    /**
+     * Añade una tarea al grafo
+     * @param name Nombre de la tarea
+     * @param work Trabajo a realizar
+     * @param dependencies Tareas ya añadidas que deben terminar antes de comenzar esta
+     * @return Identificador de la tarea
+     */
+    TaskID add(const std::string &name, std::function<void()> work, const std::vector<TaskID> &dependencies = {}) {
+        const TaskID id = tasks.size();
+        for (TaskID d : dependencies) {
+            if (d >= id) {
+                throw std::invalid_argument("TaskGraph: dependency on a task that has not been added yet");
+            }
+            tasks[d].successors.push_back(id);
+        }
+        tasks.push_back({name, std::move(work), dependencies, {}, 0, 0});
+        return id;
+    }
+
+    /**
+     * Ejecuta todas las tareas respetando sus dependencias. El hilo que llama participa como un trabajador más.
+     * Cada tarea dispone para sus regiones paralelas de los hilos de OpenMP del que llama divididos entre las tareas
+     * en ejecución o listas al comenzar, con un mínimo de uno. Si alguna tarea lanza una excepción no se comienzan
+     * nuevas tareas y la excepción se relanza al terminar
+     * @param workers Número de hilos trabajadores, incluido el que llama
+     */
+    void run(size_t workers = std::thread::hardware_concurrency()) {
+        const size_t nworkers = std::min(std::max<size_t>(workers, 1), std::max<size_t>(tasks.size(), 1));
+        const int budget = omp_get_max_threads();  // Hilos de OpenMP a repartir entre las tareas
+
+        std::vector<size_t> pending(tasks.size());  // Dependencias sin terminar de cada tarea
+        std::queue<TaskID> ready;                   // Tareas listas para ejecutarse
+        for (TaskID id = 0; id < tasks.size(); ++id) {
+            pending[id] = tasks[id].dependencies.size();
+            if (pending[id] == 0) {
+                ready.push(id);
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t done = 0;
+        size_t running = 0;  // Tareas en ejecución
+        std::exception_ptr error;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = [&start]() { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+        auto worker = [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                cv.wait(lock, [&]() { return !ready.empty() || done == tasks.size() || error; });
+                if (ready.empty() || error) {
+                    return;
+                }
+                const TaskID id = ready.front();
+                ready.pop();
+                const size_t active = std::min(nworkers, ++running + ready.size());
+                lock.unlock();
+
+                omp_set_num_threads(std::max(1, budget / (int)active));
+                tasks[id].begin = elapsed();
+                try {
+                    tasks[id].work();
+                } catch (...) {
+                    lock.lock();
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    cv.notify_all();
+                    return;
+                }
+                tasks[id].end = elapsed();
+
+                lock.lock();
+                --running;
+                ++done;
+                for (TaskID s : tasks[id].successors) {
+                    if (--pending[s] == 0) {
+                        ready.push(s);
+                    }
+                }
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t w = 1; w < nworkers; ++w) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (std::thread &t : threads) {
+            t.join();
+        }
+        omp_set_num_threads(budget);  // El que llama recupera todos sus hilos
+        wall = elapsed();
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * Obtiene el camino crítico de la última ejecución: la cadena de dependencias con mayor duración acumulada
+     * @return Tareas del camino crítico en orden de ejecución
+     */
+    std::vector<TaskID> criticalPath() const {
+        std::vector<double> finish(tasks.size(), 0);
+        std::vector<TaskID> previous(tasks.size(), tasks.size());
+        TaskID last = 0;
+        for (TaskID id = 0; id < tasks.size(); ++id) {
+            for (TaskID d : tasks[id].dependencies) {
+                if (previous[id] == tasks.size() || finish[d] > finish[previous[id]]) {
+                    previous[id] = d;
+                }
+            }
+            finish[id] = duration(id) + (previous[id] == tasks.size() ? 0 : finish[previous[id]]);
+            if (finish[id] > finish[last]) {
+                last = id;
+            }
+        }
+
+        std::vector<TaskID> path;
+        for (TaskID id = last; id < tasks.size(); id = previous[id]) {
+            path.push_back(id);
+        }
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    ////// Getters
+    /**
+     * Devuelve el número de tareas del grafo
+     * @return Número de tareas
+     */
+    size_t size() const { return tasks.size(); }
+    /**
+     * Devuelve el nombre de una tarea
+     * @param id Identificador de la tarea
+     * @return Nombre de la tarea
+     */
+    const std::string &getName(TaskID id) const { return tasks[id].name; }
+    /**
+     * Devuelve la duración de una tarea en la última ejecución
+     * @param id Identificador de la tarea
+     * @return Duración (s) de la tarea
+     */
+    double duration(TaskID id) const { return tasks[id].end - tasks[id].begin; }
+    /**
+     * Devuelve la duración total de la última ejecución del grafo
+     * @return Duración (s) desde el comienzo de la primera tarea hasta el final de la última
+     */
+    double getWallTime() const { return wall; }
+};
+
+#endif  // TASKGRAPH_CLASS_H
@@ -14,26 +14,37 @@
 #include <vector>
 #include <map>
 #include <utility>
+#include <memory>
 
 #include "object_characterization/Face.hh"
+#include "object_characterization/ModelFeatures.hh"
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 #include "models/BBox.hh"
+#include "models/ConvexHull.hh"
 #include "models/Geometry.hh"
 
 /**
- * @brief Objeto caracterizado a partir de una nube de puntos
+ * @brief Objeto caracterizado a partir de una nube de puntos.
+ * Al igual que su nube de puntos, el objeto solo se puede mover o duplicar explícitamente mediante clone()
  */
 class CharacterizedObject {
    private:
-    std::vector<Point> points;  ///< Puntos del objeto
-    BBox bbox;                  ///< Bounding box que mejor se adapta al objeto
-    std::vector<Face> faces;    ///< Caras del objeto
+    PointCloud points;        ///< Puntos del objeto
+    BBox bbox;                ///< Bounding box que mejor se adapta al objeto
+    std::vector<Face> faces;  ///< Caras del objeto
+
+    mutable std::shared_ptr<const FaceFeatures> faceFeatures;  ///< Descriptores de las caras, construidos bajo demanda
+    mutable std::shared_ptr<const ModelFeatures> features;     ///< Características de la superficie, construidas bajo demanda
+    mutable std::shared_ptr<const ConvexHull> hull;            ///< Envolvente convexa, obtenida en la caracterización o construida bajo demanda
 
    public:
     /**
      * Constructor
      */
     CharacterizedObject() {}
+    CharacterizedObject(CharacterizedObject&&) = default;
+    CharacterizedObject& operator=(CharacterizedObject&&) = default;
     /**
      * Destructor
      */
@@ -46,7 +57,36 @@ class CharacterizedObject {
      * @return true si se ha caracterizado el objeto correctamente junto con un objecto
      * CharacterizedObject o false y un objeto vacio si no se ha podido caracterizar
      */
-    static std::pair<bool, CharacterizedObject> parse(std::vector<Point>& points, bool chrono);
+    static std::pair<bool, CharacterizedObject> parse(const PointCloud& points, bool chrono);
+    /**
+     * Caracteriza un objecto segun un conjunto de puntos buscando clusteres de puntos y distinción de caras
+     * @param points Conjunto de puntos del objeto
+     * @param chrono Indica si se desea recibir mensajes de la duración del proceso
+     * @return true si se ha caracterizado el objeto correctamente junto con un objecto
+     * CharacterizedObject o false y un objeto vacio si no se ha podido caracterizar
+     */
+    static std::pair<bool, CharacterizedObject> parse(const std::vector<Point>& points, bool chrono) { return parse(PointCloud(points), chrono); }
+    /**
+     * Caracteriza por separado cada cluster de puntos con tamaño suficiente para ser un objeto, procesando
+     * todos los clusters de forma concurrente
+     * @param points Conjunto de puntos de la escena
+     * @param chrono Indica si se desea recibir mensajes de la duración del proceso
+     * @return Objetos caracterizados, de mayor a menor número de puntos del cluster. Los clusters en los
+     * que no se detectan caras se descartan
+     */
+    static std::vector<CharacterizedObject> parseAll(const PointCloud& points, bool chrono);
+
+    /**
+     * Crea una copia del objeto
+     * @return Objeto con los mismos puntos, bounding box, caras y envolvente convexa
+     */
+    CharacterizedObject clone() const {
+        CharacterizedObject copy(points.clone(), bbox, faces);
+        copy.faceFeatures = std::atomic_load(&faceFeatures);  // Las características son inmutables y válidas para la copia
+        copy.features = std::atomic_load(&features);
+        copy.hull = std::atomic_load(&hull);
+        return copy;
+    }
 
     /**
      * Devuelve el número de caras del objeto
@@ -55,7 +95,7 @@ class CharacterizedObject {
     int numFaces() const { return faces.size(); }
 
     /**
-     * Guarda el objeto a un archivo
+     * Guarda el objeto a un archivo con el formato ObjectFile
      * @param filename Nombre del archivo
      * @return true si se ha guardado correctamente
      */
@@ -69,24 +109,28 @@ class CharacterizedObject {
     bool writeLivoxCSV(const std::string& filename);
 
     /**
-     * Carga un objeto de un archivo
+     * Carga un objeto de un archivo. Los archivos con el formato ObjectFile se proyectan en memoria sin copiar
+     * sus puntos, y el resto se leen con el formato anterior
      * @param filename Nombre del archivo
      * @return El primer elemento es true si se ha cargado correctamente y
      * false en caso contrario, siendo el segundo elemento el objeto cargado o un objeto vacío
      */
     static std::pair<bool, CharacterizedObject> load(const std::string& filename);
 
-    ////// Getters
     /**
-     * Devuelve los puntos del objeto
-     * @return Vector de puntos del objeto
+     * Convierte un archivo de objeto al formato ObjectFile actual
+     * @param input Archivo de origen, en cualquiera de los formatos soportados por load()
+     * @param output Archivo de destino
+     * @return true si se ha cargado y guardado el objeto correctamente
      */
-    const std::vector<Point>& getPoints() const { return points; }
+    static bool convert(const std::string& input, const std::string& output);
+
+    ////// Getters
     /**
      * Devuelve los puntos del objeto
-     * @return Vector de puntos del objeto
+     * @return Nube de puntos del objeto
      */
-    std::vector<Point>& getPoints() { return points; }
+    const PointCloud& getPoints() const { return points; }
     /**
      * Devuelve las caras del objeto
      * @return Caras del objeto
@@ -97,18 +141,46 @@ class CharacterizedObject {
      * @return Bounding box del objeto
      */
     const BBox& getBBox() const { return bbox; }
-    
+    /**
+     * Devuelve la envolvente convexa de los puntos del objeto. Los objetos caracterizados conservan la envolvente
+     * calculada para su bounding box, y el resto la construyen en la primera llamada. Se conserva hasta que se
+     * modifican los puntos y puede usarse desde varios hilos
+     * @return Envolvente convexa del objeto
+     */
+    std::shared_ptr<const ConvexHull> getHull() const;
+    /**
+     * Devuelve los descriptores de las caras del objeto, construyéndolos en la primera llamada.
+     * Se conservan hasta que se modifican las caras y pueden usarse desde varios hilos. Los descriptores
+     * devueltos siguen siendo válidos tras una modificación posterior del objeto
+     * @return Descriptores de las caras del objeto
+     */
+    std::shared_ptr<const FaceFeatures> getFaceFeatures() const;
+    /**
+     * Devuelve las características de la superficie del objeto, construyéndolas en la primera llamada.
+     * Se conservan hasta que se modifican los puntos y pueden usarse desde varios hilos. Las características
+     * devueltas siguen siendo válidas tras una modificación posterior del objeto
+     * @return Características de la superficie del objeto
+     */
+    std::shared_ptr<const ModelFeatures> getFeatures() const;
+
     ////// Setters
     /**
      * Establece los puntos del objeto
-     * @param points Vector de puntos del objeto
+     * @param points Nube de puntos del objeto
      */
-    void setPoints(const std::vector<Point>& points) { this->points = points; }
+    void setPoints(PointCloud&& points) {
+        this->points = std::move(points);
+        std::atomic_store(&features, std::shared_ptr<const ModelFeatures>());
+        std::atomic_store(&hull, std::shared_ptr<const ConvexHull>());
+    }
     /**
      * Establece las caras del objeto
      * @param faces Caras del objeto
      */
-    void setFaces(const std::vector<Face>& faces) { this->faces = faces; }
+    void setFaces(const std::vector<Face>& faces) {
+        this->faces = faces;
+        std::atomic_store(&faceFeatures, std::shared_ptr<const FaceFeatures>());
+    }
     /**
      * Establece la bounding box del objeto
      * @param bbox Bounding box del objeto
@@ -121,8 +193,18 @@ class CharacterizedObject {
      * @param points Puntos del objeto
      * @param bbox Bounding box
      * @param faces Vector de caras
+     * @param hull Envolvente convexa de los puntos, o nula para construirla bajo demanda
+     */
+    CharacterizedObject(PointCloud&& points, const BBox& bbox, std::vector<Face> faces, std::shared_ptr<const ConvexHull> hull = nullptr)
+        : points(std::move(points)), bbox(bbox), faces(std::move(faces)), hull(std::move(hull)) {}
+
+    /**
+     * Carga un objeto de un archivo en el formato anterior a ObjectFile, sin cabecera ni versión
+     * @param filename Nombre del archivo
+     * @return El primer elemento es true si se ha cargado correctamente y
+     * false en caso contrario, siendo el segundo elemento el objeto cargado o un objeto vacío
      */
-    CharacterizedObject(const std::vector<Point>& points, const BBox& bbox, const std::vector<Face>& faces) : points(points), bbox(bbox), faces(faces) {}
+    static std::pair<bool, CharacterizedObject> loadLegacy(const std::string& filename);
 };
 
 typedef CharacterizedObject Model;  ///< Definición de los modelos
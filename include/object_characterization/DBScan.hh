@@ -13,8 +13,22 @@
 #include <vector>
 #include <cmath>
 #include <utility>
+#include <atomic>
+#include <array>
 
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
+#include "models/NeighborGraph.hh"
+
+/**
+ * Enum de tipos de cluster
+ */
+enum PointCluster {
+    cUnclassified = -1,  ///< Punto no clasificado
+    cCorePoint = -2,     ///< Punto core
+    cBorderPoint = -3,   ///< Punto frontera
+    cNoise = -4          ///< Ruido
+};
 
 /**
  * @brief Implementación del algoritmo DBSCAN para la búsqueda de clusters y caras de un objeto
@@ -22,29 +36,92 @@
 class DBScan {
    public:
    /**
-    * Ejecuta el algoritmo de DBScan estableciendo los clusterIDs correspondientes cada punto del vector de puntos
+    * Ejecuta el algoritmo de DBScan sobre el vector de puntos
     * @param points Vector de puntos sobre los cuales se realizará la distinción de clusteres
     * @return Vector de clusteres representados en forma de vectores de indices de los puntos pertenecientes al cluster
     */
-    static std::vector<std::vector<size_t>> clusters(std::vector<Point> &points);
+    static std::vector<std::vector<size_t>> clusters(const std::vector<Point> &points);
+   /**
+    * Ejecuta el algoritmo de DBScan sobre la nube de puntos
+    * @param points Nube de puntos sobre la cual se realizará la distinción de clusteres
+    * @return Vector de clusteres representados en forma de vectores de indices de los puntos pertenecientes al cluster
+    */
+    static std::vector<std::vector<size_t>> clusters(const PointCloud &points);
+   /**
+    * Ejecuta el algoritmo de DBScan en paralelo sobre la nube de puntos estableciendo el clusterID correspondiente a cada punto.
+    * Los puntos core se identifican de forma concurrente y se unen mediante un union-find atómico. Los clusteres se numeran
+    * según su punto core de menor índice y cada punto frontera se asigna al vecino de menor número, por lo que el resultado
+    * es determinista, independiente del número de hilos e igual al de sequentialClusters()
+    * @param points Nube de puntos sobre la cual se realizará la distinción de clusteres
+    * @param labels Vector en el que se devuelve el clusterID de cada punto, o cNoise si no pertenece a ninguno
+    * @return Vector de clusteres representados en forma de vectores de indices, ordenados, de los puntos pertenecientes al cluster
+    */
+    static std::vector<std::vector<size_t>> clusters(const PointCloud &points, std::vector<int> &labels);
+   /**
+    * Ejecuta el algoritmo de DBScan en paralelo sobre un grafo de vecinos ya construido
+    * @param graph Grafo de vecinos de la nube de puntos, con un radio mayor o igual que CLUSTER_POINT_PROXIMITY
+    * @param labels Vector en el que se devuelve el clusterID de cada punto, o cNoise si no pertenece a ninguno
+    * @return Vector de clusteres representados en forma de vectores de indices, ordenados, de los puntos pertenecientes al cluster
+    */
+    static std::vector<std::vector<size_t>> clusters(const NeighborGraph &graph, std::vector<int> &labels);
+   /**
+    * Ejecuta el algoritmo de DBScan secuencial, expandiendo los clusteres a partir de semillas, sobre la nube de puntos
+    * estableciendo el clusterID correspondiente a cada punto. Un punto es core si tiene al menos MIN_CLUSTER_POINTS vecinos
+    * en total, también como centroide inicial. La versión original solo contaba los vecinos sin cluster del centroide
+    * inicial, lo que hacía depender el resultado del orden de los puntos; ambas coinciden en nubes densas como las de los
+    * tests 3.x, pero en escenas dispersas la actual conserva clusteres pequeños pegados a fronteras de otros
+    * @param points Nube de puntos sobre la cual se realizará la distinción de clusteres
+    * @param labels Vector en el que se devuelve el clusterID de cada punto, o un valor de PointCluster si no pertenece a ninguno
+    * @return Vector de clusteres representados en forma de vectores de indices de los puntos pertenecientes al cluster
+    */
+    static std::vector<std::vector<size_t>> sequentialClusters(const PointCloud &points, std::vector<int> &labels);
 
     /**
-    * Ejecuta el algoritmo de DBScan estableciendo los clusterIDs correspondientes cada punto del vector de puntos según sus normales
+    * Ejecuta el algoritmo de DBScan sobre el vector de puntos según sus normales
     * @param points Vector de puntos sobre los cuales se realizará la distinción de caras
     * @return Vector de caras representadas en forma de vectores de indices de los puntos pertenecientes a la cara
     */
-    static std::vector<std::vector<size_t>> normals(std::vector<Point> &points);
+    static std::vector<std::vector<size_t>> normals(const std::vector<Point> &points);
+    /**
+    * Ejecuta el algoritmo de DBScan sobre la nube de puntos según sus normales
+    * @param points Nube de puntos sobre la cual se realizará la distinción de caras
+    * @return Vector de caras representadas en forma de vectores de indices de los puntos pertenecientes a la cara
+    */
+    static std::vector<std::vector<size_t>> normals(const PointCloud &points);
+    /**
+    * Ejecuta el algoritmo de DBScan sobre la nube de puntos según sus normales estableciendo el ID de cara correspondiente a cada punto
+    * @param points Nube de puntos sobre la cual se realizará la distinción de caras
+    * @param labels Vector en el que se devuelve el ID de la cara de cada punto, o un valor de PointCluster si no pertenece a ninguna
+    * @return Vector de caras representadas en forma de vectores de indices de los puntos pertenecientes a la cara
+    */
+    static std::vector<std::vector<size_t>> normals(const PointCloud &points, std::vector<int> &labels);
+    /**
+    * Ejecuta el algoritmo de DBScan sobre la nube de puntos según sus normales, reutilizando un grafo de vecinos ya construido
+    * @param points Nube de puntos sobre la cual se realizará la distinción de caras
+    * @param graph Grafo de vecinos de la nube de puntos, con un radio mayor o igual que NORMAL_CALC_POINT_PROXIMITY y FACE_POINT_PROXIMITY
+    * @param labels Vector en el que se devuelve el ID de la cara de cada punto, o un valor de PointCluster si no pertenece a ninguna
+    * @return Vector de caras representadas en forma de vectores de indices de los puntos pertenecientes a la cara
+    */
+    static std::vector<std::vector<size_t>> normals(const PointCloud &points, const NeighborGraph &graph, std::vector<int> &labels);
 
    private:
+    // Obtiene la raíz de un punto en el union-find, comprimiendo el camino recorrido
+    static size_t findRoot(std::vector<std::atomic<size_t>> &parent, size_t i);
+    // Une los conjuntos de dos puntos en el union-find, tomando como raíz el punto de menor índice
+    static void unite(std::vector<std::atomic<size_t>> &parent, size_t a, size_t b);
+
 	// Expande un cluster a partir de un centroide y el ID especificado junto con las variables limitantes especificadas
-    static std::pair<bool, std::vector<size_t>> expandCluster(Point &centroid, int clusterID, std::vector<Point> &points, const Octree &map);
+    static std::pair<bool, std::vector<size_t>> expandCluster(size_t centroid, int clusterID, std::vector<int> &labels, const NeighborGraph &graph);
     // Calcula el indice de los puntos pertenecientes al cluster según un centroide dado
-    static std::pair<size_t, std::vector<size_t>> centroidNeighbours(const Point &centroid, const std::vector<Point> &points, const Octree &map);
+    static std::pair<size_t, std::vector<size_t>> centroidNeighbours(size_t centroid, const std::vector<int> &labels, const NeighborGraph &graph);
 
-    // Expande una cara a partir de un centroide y el ID especificado junto con las variables limitantes especificadas
-    static std::pair<bool, std::vector<size_t>> expandNormalCluster(size_t centroid, int clusterID, std::vector<Point> &points, const std::vector<Vector> &normals, const Octree &map);
-    // Calcula el indice de los puntos pertenecientes a la cara según una normal dada
-    static std::pair<size_t, std::vector<size_t>> centroidNormalNeighbours(size_t centroid, const Vector &meanNormal, const std::vector<Point> &points, const std::vector<Vector> &normals, const Octree &map);
+    // Expande una cara a partir de un centroide y el ID especificado, manteniendo la suma de las normales de la cara de forma incremental
+    static std::pair<bool, std::vector<size_t>> expandNormalCluster(size_t centroid, int clusterID, std::vector<int> &labels, std::vector<bool> &assigned, const std::vector<bool> &valid,
+                                                                    const std::vector<Vector> &normals, const NeighborGraph &graph, std::vector<size_t> &candidates);
+    // Obtiene los vecinos compatibles con la normal de un centroide y la suma de normales de la cara. Devuelve el total de vecinos compatibles
+    // y almacena en candidates aquellos aún no asignados a una cara
+    static size_t centroidNormalNeighbours(size_t centroid, const std::array<double, 3> &normalSum, const std::vector<bool> &assigned, const std::vector<bool> &valid,
+                                           const std::vector<Vector> &normals, const NeighborGraph &graph, std::vector<size_t> &candidates);
 };
 
 #endif  // DBSCAN_CLASS_H
\ No newline at end of file
@@ -11,6 +11,7 @@
 #define FACE_CLASS_H
 
 #include <vector>
+#include <utility>
 
 #include "models/BBox.hh"
 #include "models/Point.hh"
@@ -24,24 +25,30 @@ class Face {
     Vector normal;                    ///< Vector normal de la cara
     BBox minBBox;                     ///< Bounding box mínima que engloba a los puntos de la cara
     Vector minBBoxRotAngles;          ///< Ángulos de rotación en grados que dan como resultado la bounding box mínima
+    double planeRMS;                  ///< Raíz del error cuadrático medio (mm) de los puntos de la cara respecto a su plano
+    double planeMaxResidual;          ///< Máxima distancia (mm) de un punto de la cara a su plano
 
    public:
     /**
      * Constructor
      */
-    Face() {}
+    Face() : planeRMS(0), planeMaxResidual(0) {}
     /**
      * Constructor
      * @param indices Índices de los puntos de la cara
      * @param normal Normal de la cara
      * @param minBBox Bounding box mínima que engloba a los puntos de la cara
      * @param minBBoxRotAngles Ángulos de rotación en grados que dan como resultado la bounding box mínima
+     * @param planeRMS Raíz del error cuadrático medio de los puntos de la cara respecto a su plano
+     * @param planeMaxResidual Máxima distancia de un punto de la cara a su plano
      */
-    Face(const std::vector<size_t> &indices, const Vector &normal, const BBox &minBBox, const Vector &minBBoxRotAngles)
-        : indices(indices),
+    Face(std::vector<size_t> indices, const Vector &normal, const BBox &minBBox, const Vector &minBBoxRotAngles, double planeRMS = 0, double planeMaxResidual = 0)
+        : indices(std::move(indices)),
           normal(normal),
           minBBox(minBBox),
-          minBBoxRotAngles(minBBoxRotAngles) {}
+          minBBoxRotAngles(minBBoxRotAngles),
+          planeRMS(planeRMS),
+          planeMaxResidual(planeMaxResidual) {}
     /**
      * Destructor
      */
@@ -68,6 +75,16 @@ class Face {
      * @return Ángulos de rotación
      */
     const Vector &getMinBBoxRotAngles() const { return minBBoxRotAngles; }
+    /**
+     * Devuelve la raíz del error cuadrático medio de los puntos de la cara respecto a su plano
+     * @return Residuo medio (mm) del ajuste al plano
+     */
+    double getPlaneRMS() const { return planeRMS; }
+    /**
+     * Devuelve la máxima distancia de un punto de la cara a su plano
+     * @return Residuo máximo (mm) del ajuste al plano
+     */
+    double getPlaneMaxResidual() const { return planeMaxResidual; }
 };
 
 #endif  // FACE_CLASS_H
\ No newline at end of file
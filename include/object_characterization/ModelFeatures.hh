@@ -0,0 +1,82 @@
+/**
+ * @file ModelFeatures.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición e implementación de los objetos FaceFeatures y ModelFeatures
+ *
+ */
+
+#ifndef MODELFEATURES_CLASS_H
+#define MODELFEATURES_CLASS_H
+
+#include <vector>
+#include <cstddef>
+
+#include "armadillo"
+
+#include "object_characterization/Face.hh"
+#include "models/Point.hh"
+#include "models/KDTree.hh"
+
+/**
+ * Medidas de una cara usadas para emparejarla con las de otro objeto
+ */
+struct FaceDescriptor {
+    double volume;       ///< Volumen de la bounding box mínima de la cara
+    Vector delta;        ///< Dimensiones de la bounding box mínima de la cara
+    double deltaModule;  ///< Módulo de las dimensiones de la bounding box mínima
+    bool oriented;       ///< La cara tiene una normal no nula
+};
+
+/**
+ * @brief Descriptores de un conjunto de caras junto a sus normales unitarias, dispuestas como columnas de una
+ * matriz para obtener los cosenos entre todas las caras de dos objetos con un único producto
+ */
+class FaceFeatures {
+   public:
+    std::vector<FaceDescriptor> descriptors;  ///< Descriptor de cada cara
+    arma::mat normals;                        ///< Normal unitaria de cada cara por columnas (3 x caras), nula si la cara no tiene normal
+
+    /**
+     * Constructor de un conjunto vacío
+     */
+    FaceFeatures() {}
+    /**
+     * Constructor
+     * @param faces Caras a describir
+     */
+    explicit FaceFeatures(const std::vector<Face> &faces) : descriptors(faces.size()) {
+        normals.zeros(3, faces.size());
+        for (size_t i = 0; i < faces.size(); ++i) {
+            const BBox &bbox = faces[i].getMinBBox();
+            const Vector &normal = faces[i].getNormal();
+            const double length = normal.module();
+            descriptors[i] = {bbox.volume(), bbox.getDelta(), bbox.getDelta().module(), length > 0};
+            if (length > 0) {
+                normals(0, i) = normal.getX() / length;
+                normals(1, i) = normal.getY() / length;
+                normals(2, i) = normal.getZ() / length;
+            }
+        }
+    }
+
+    /**
+     * Devuelve el número de caras descritas
+     * @return Número de caras
+     */
+    size_t size() const { return descriptors.size(); }
+};
+
+/**
+ * @brief Características de la superficie de un objeto que solo dependen de sus puntos y que se reutilizan en cada
+ * análisis de la superficie contra él cuando actúa como modelo: índice espacial de sus puntos con la normal de cada
+ * uno. Los descriptores de las caras se guardan aparte en FaceFeatures, ya que el emparejamiento de caras no necesita
+ * el resto
+ */
+struct ModelFeatures {
+    KDTree tree;                  ///< Árbol KD sobre los puntos del objeto
+    std::vector<Vector> normals;  ///< Normal unitaria de cada punto, orientada hacia el exterior del objeto
+};
+
+#endif  // MODELFEATURES_CLASS_H
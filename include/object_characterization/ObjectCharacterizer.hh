@@ -17,6 +17,7 @@
 #include "scanner/IScanner.hh"
 #include "models/LidarPoint.hh"
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 #include "models/OctreeMap.hh"
 #include "object_characterization/CharacterizedObject.hh"
 
@@ -100,6 +101,13 @@ class ObjectCharacterizer {
      */
     std::pair<bool, CharacterizedObject> defineObject();
 
+    /**
+     * Define todos los objetos presentes en la escena, caracterizando por separado cada cluster de puntos
+     * con tamaño suficiente
+     * @return Objetos caracterizados, vacío si no se ha podido caracterizar ninguno
+     */
+    std::vector<CharacterizedObject> defineObjects();
+
     /**
      * Descarta puntos durante la duracion especificada
      * @param miliseconds Milisegundos a esperar
@@ -176,6 +184,11 @@ class ObjectCharacterizer {
      * @return true si el punto pertenece al fondo o false en caso contrario
      */
     bool isBackground(const Point &p) const;
+    /**
+     * Escanea un frame de puntos y descarta los que pertenecen al fondo
+     * @return booleano a false cuando ha ocurrido un error de escaneo o true y los puntos que no pertenecen al fondo
+     */
+    std::pair<bool, PointCloud> scanObject();
 };
 
 #endif  // OBJECTCARACTERIZER_CLASS_H
\ No newline at end of file
@@ -0,0 +1,136 @@
+/**
+ * @file ObjectFile.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definición del formato de archivo de objetos y modelos ObjectFile
+ *
+ */
+
+#ifndef OBJECTFILE_CLASS_H
+#define OBJECTFILE_CLASS_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "object_characterization/Face.hh"
+#include "models/PointCloud.hh"
+#include "models/BBox.hh"
+#include "app/config.h"
+
+/**
+ * @brief Formato de archivo versionado de objetos y modelos, preparado para proyectarse en memoria.
+ * El archivo comienza con una cabecera de tamaño fijo seguida de las secciones de datos, cada una alineada a
+ * kAlignment bytes: coordenadas x, y y z de los puntos como columnas de floats, registros de las caras e índices de
+ * los puntos de todas las caras concatenados. La cabecera almacena la posición, el tamaño y el CRC32 de cada sección.
+ * Los datos se escriben en el orden de bytes de la máquina, que se registra en la cabecera para rechazar los archivos
+ * de máquinas con un orden distinto
+ */
+class ObjectFile {
+   public:
+    static constexpr char kMagic[8] = {'L', 'B', 'A', 'D', 'O', 'B', 'J', '\0'};  ///< Firma del formato
+    static constexpr uint32_t kVersion = 1;                                      ///< Versión actual del formato
+    static constexpr uint32_t kByteOrder = 0x01020304;                           ///< Marca del orden de bytes
+    static constexpr uint64_t kAlignment = 64;                                   ///< Alineamiento (bytes) de las secciones
+
+    /**
+     * Secciones de datos del archivo
+     */
+    enum Section {
+        kSectionX = 0,    ///< Coordenadas x de los puntos (float)
+        kSectionY,        ///< Coordenadas y de los puntos (float)
+        kSectionZ,        ///< Coordenadas z de los puntos (float)
+        kSectionFaces,    ///< Registros de las caras (FaceRecord)
+        kSectionIndices,  ///< Índices de los puntos de las caras (uint64_t)
+        kNumSections,     ///< Número de secciones
+    };
+
+    /**
+     * Localización de una sección de datos en el archivo
+     */
+    struct SectionEntry {
+        uint64_t offset;    ///< Posición (bytes) del inicio de la sección
+        uint64_t size;      ///< Tamaño (bytes) de la sección
+        uint32_t crc;       ///< CRC32 del contenido de la sección
+        uint32_t reserved;  ///< Sin uso
+    };
+
+    /**
+     * Cabecera del archivo
+     */
+    struct Header {
+        char magic[8];                            ///< Firma del formato (kMagic)
+        uint32_t version;                         ///< Versión del formato
+        uint32_t byteOrder;                       ///< Marca del orden de bytes (kByteOrder)
+        uint32_t headerSize;                      ///< Tamaño (bytes) de la cabecera
+        uint32_t headerCRC;                       ///< CRC32 de la cabecera, calculado con este campo a 0
+        uint64_t fileSize;                        ///< Tamaño (bytes) del archivo
+        uint64_t numPoints;                       ///< Número de puntos del objeto
+        uint64_t numFaces;                        ///< Número de caras del objeto
+        uint64_t numIndices;                      ///< Número total de índices de las caras
+        double bboxMin[3];                        ///< Punto mínimo de la bounding box del objeto
+        double bboxMax[3];                        ///< Punto máximo de la bounding box del objeto
+        SectionEntry sections[kNumSections];      ///< Localización de cada sección
+        uint8_t reserved[32];                     ///< Sin uso, completa la cabecera hasta un múltiplo del alineamiento
+    };
+
+    /**
+     * Registro de una cara en el archivo
+     */
+    struct FaceRecord {
+        double normal[3];         ///< Normal de la cara
+        double bboxMin[3];        ///< Punto mínimo de la bounding box mínima de la cara
+        double bboxMax[3];        ///< Punto máximo de la bounding box mínima de la cara
+        double rotation[3];       ///< Ángulos de rotación (grados) de la bounding box mínima de la cara
+        double planeRMS;          ///< Raíz del error cuadrático medio del ajuste al plano
+        double planeMaxResidual;  ///< Residuo máximo del ajuste al plano
+        uint64_t firstIndex;      ///< Posición del primer índice de la cara en la sección de índices
+        uint64_t numIndices;      ///< Número de índices de la cara
+    };
+
+    static_assert(sizeof(Header) % kAlignment == 0, "La cabecera debe mantener el alineamiento de las secciones");
+    static_assert(sizeof(FaceRecord) % sizeof(uint64_t) == 0, "Los registros de las caras no deben desalinear la sección");
+
+    /**
+     * Calcula el CRC32 (polinomio IEEE 802.3) de un bloque de memoria
+     * @param data Inicio del bloque
+     * @param size Tamaño (bytes) del bloque
+     * @param crc CRC32 de los bloques anteriores, para calcularlo de forma incremental
+     * @return CRC32 del bloque
+     */
+    static uint32_t crc32(const void *data, size_t size, uint32_t crc = 0);
+
+    /**
+     * Comprueba si un archivo comienza con la firma del formato
+     * @param filename Nombre del archivo
+     * @return true si el archivo existe y tiene la firma del formato, false si no existe o tiene otro formato
+     */
+    static bool isObjectFile(const std::string &filename);
+
+    /**
+     * Guarda los datos de un objeto en un archivo. Se escribe primero en un archivo temporal que después
+     * reemplaza al de destino, de forma que los puntos pueden provenir de una proyección del propio archivo
+     * @param filename Nombre del archivo
+     * @param points Puntos del objeto
+     * @param bbox Bounding box del objeto
+     * @param faces Caras del objeto
+     * @return true si se ha guardado correctamente
+     */
+    static bool write(const std::string &filename, const PointCloud &points, const BBox &bbox, const std::vector<Face> &faces);
+
+    /**
+     * Carga los datos de un objeto proyectando el archivo en memoria. Los puntos se usan directamente desde la
+     * proyección, que se mantiene mientras exista la nube o alguna copia suya
+     * @param filename Nombre del archivo
+     * @param points Nube donde se devuelven los puntos
+     * @param bbox Bounding box donde se devuelve la del objeto
+     * @param faces Vector donde se devuelven las caras
+     * @param verify Comprobar el CRC32 de cada sección además del de la cabecera
+     * @return true si el archivo es válido y se ha cargado correctamente
+     */
+    static bool read(const std::string &filename, PointCloud &points, BBox &bbox, std::vector<Face> &faces, bool verify = OBJECT_FILE_VERIFY_CHECKSUMS);
+};
+
+#endif  // OBJECTFILE_CLASS_H
@@ -34,7 +34,7 @@ class IScanner {
     std::function<void(const LidarPoint &p)> callback;  ///< Función de callback
     bool scanning;                                 ///< Variable para la finalización del escaneo de puntos
 
-    inline static IScanner *instance = nullptr;  ///< Puntero a la instancia única del escaner
+    inline static IScanner *instance = nullptr;  ///< Puntero a la última instancia creada del escaner
 
    public:
     /**
@@ -14,6 +14,10 @@
 #include <string>
 #include <fstream>
 #include <functional>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <algorithm>
 #include <string.h>
 
 #include "livox_sdk.h"
@@ -44,41 +48,87 @@ typedef enum {
  * Datos del sensor LiDAR
  */
 struct DeviceItem {
-    DeviceItem(const char broadcast_code[kBroadcastCodeSize]) {
+    DeviceItem(const char broadcast_code[kBroadcastCodeSize]) : handle(kInvalidHandle), device_state(kDeviceStateDisconnect) {
+        memset(&info, 0, sizeof(info));
         strncpy(info.broadcast_code, broadcast_code, kBroadcastCodeSize - 1);
         info.broadcast_code[kBroadcastCodeSize - 1] = '\0';
+        info.state = kLidarStateUnknown;
     }
 
+    static constexpr uint8_t kInvalidHandle = 0xFF;  ///< Handler de un sensor no conectado
+
     uint8_t handle;            ///< Handler
     DeviceState device_state;  ///< Estado del sensor
     DeviceInfo info;           ///< Propiedades del sensor
 };
 
 /**
- * @brief Escaner de puntos provenientes de un sensor LiDAR
+ * @brief Escaner de puntos provenientes de un sensor LiDAR.
+ * Pueden existir varios escaneres simultáneos, uno por sensor, compartiendo la inicialización del Livox SDK
  */
 class ScannerLidar : public IScanner {
    private:
     DeviceItem lidar;  ///< Datos del sensor LiDAR
+    bool initialized;  ///< Escaner inicializado y registrado en el Livox SDK
+
+    inline static std::mutex scannersMutex;                      ///< Mutex de acceso a los escaneres existentes
+    inline static std::mutex sdkMutex;                           ///< Mutex de inicialización del Livox SDK
+    inline static unsigned sdkUsers = 0;                         ///< Escaneres inicializados que utilizan el Livox SDK
+    static std::vector<std::unique_ptr<ScannerLidar>> scanners;  ///< Escaneres existentes, propiedad del registro
 
    public:
     /**
-     * Devuelve la instancia única creada del escaner
-     * @return Instancia única del escaner
+     * Devuelve la última instancia creada del escaner
+     * @return Última instancia creada del escaner
      */
     static ScannerLidar *getInstance() { return (ScannerLidar *)instance; }
 
     /**
-     * Crea una instancia unica del escaner si no existe
+     * Crea una instancia del escaner para el sensor especificado si no existe
      * @param code Broadcast del sensor
-     * @return Instancia única del escaner
+     * @return Instancia del escaner asociada al sensor
      */
     static IScanner *create(const char code[kBroadcastCodeSize]) {
-        static ScannerLidar scanner = {code};
-        instance = (IScanner *)&scanner;
+        ScannerLidar *scanner = find(code);
+        if (!scanner) {
+            std::lock_guard<std::mutex> lock(scannersMutex);
+            scanners.emplace_back(new ScannerLidar(code));
+            scanner = scanners.back().get();
+        }
+        instance = (IScanner *)scanner;
         return instance;
     }
 
+    /**
+     * Busca el escaner asociado a un sensor
+     * @param code Broadcast del sensor
+     * @return Escaner del sensor o nullptr si no existe
+     */
+    static ScannerLidar *find(const char code[kBroadcastCodeSize]) {
+        std::lock_guard<std::mutex> lock(scannersMutex);
+        for (const std::unique_ptr<ScannerLidar> &scanner : scanners) {
+            if (strncmp(scanner->lidar.info.broadcast_code, code, kBroadcastCodeSize) == 0) {
+                return scanner.get();
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Busca el escaner asociado a un sensor conectado
+     * @param handle Handler del sensor
+     * @return Escaner del sensor o nullptr si no existe
+     */
+    static ScannerLidar *find(uint8_t handle) {
+        std::lock_guard<std::mutex> lock(scannersMutex);
+        for (const std::unique_ptr<ScannerLidar> &scanner : scanners) {
+            if (scanner->lidar.handle == handle) {
+                return scanner.get();
+            }
+        }
+        return nullptr;
+    }
+
     /**
      * Inicialización del escaner
      * @return Se devolverá true si se ha establecido el escaner correctamente
@@ -116,18 +166,23 @@ class ScannerLidar : public IScanner {
      * Constructor del objeto ScannerLidar
      * @param broadcast_code Codigo de broadcast del sensor
      */
-    ScannerLidar(const char code[kBroadcastCodeSize]) : lidar(code) {}
+    ScannerLidar(const char code[kBroadcastCodeSize]) : lidar(code), initialized(false) {}
+
+   public:
     /**
-     * Destructor del scanner
+     * Destructor del scanner. Los escaneres pertenecen al registro y se destruyen al finalizar el programa
      */
-    ~ScannerLidar() {}
+    ~ScannerLidar() {
+        if (initialized) {
+            stop();
+        }
+    }
 
-   public:
     /**
      * Obtiene los datos del punto enviado por el sensor
      * @param data Paquete contenedor de datos
-     * @param data_num Número de paquete
-     * @param client_data Cliente al que pertenece
+     * @param data_num Número de puntos del paquete
+     * @param client_data Escaner al que pertenece
      */
     friend void getLidarData(uint8_t handle, LivoxEthPacket *data, uint32_t data_num, void *client_data);
 
@@ -150,7 +205,7 @@ class ScannerLidar : public IScanner {
      * @param status Estatus del sensor
      * @param handle Handler del sensor
      * @param response Respuesta del sensor
-     * @param data Datos enviador por el sensor
+     * @param data Escaner al que pertenece
      */
     friend void onSampleCallback(livox_status status, uint8_t handle, uint8_t response, void *data);
 
@@ -159,27 +214,30 @@ class ScannerLidar : public IScanner {
      * @param status Estatus del sensor
      * @param handle Handler del sensor
      * @param response Respuesta del sensor
-     * @param data Datos enviador por el sensor
+     * @param data Escaner al que pertenece
      */
     friend void onStopSampleCallback(livox_status status, uint8_t handle, uint8_t response, void *data);
 
     /**
      * Conecta el sensor
+     * @param scanner Escaner asociado al sensor
      * @param info Información del sensor
      */
-    friend void lidarConnect(const DeviceInfo *info);
+    friend void lidarConnect(ScannerLidar *scanner, const DeviceInfo *info);
 
     /**
      * Desconecta el sensor
+     * @param scanner Escaner asociado al sensor
      * @param info Información del sensor
      */
-    friend void lidarDisConnect(const DeviceInfo *info);
+    friend void lidarDisConnect(ScannerLidar *scanner, const DeviceInfo *info);
 
     /**
      * Cambia el la información de estado del sensor
+     * @param scanner Escaner asociado al sensor
      * @param info Información del sensor
      */
-    friend void lidarStateChange(const DeviceInfo *info);
+    friend void lidarStateChange(ScannerLidar *scanner, const DeviceInfo *info);
 
     /**
      * Callback para cambiar el estado del sensor
@@ -0,0 +1,150 @@
+/**
+ * @file ScannerMerged.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definicion del objeto ScannerMerged
+ *
+ */
+
+#ifndef SCANNERMERGED_CLASS_H
+#define SCANNERMERGED_CLASS_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <utility>
+
+#include "armadillo"
+
+#include "scanner/IScanner.hh"
+#include "models/LidarPoint.hh"
+#include "models/Point.hh"
+#include "app/config.h"
+
+#include "logging/debug.hh"
+
+/**
+ * Transformación del sistema de coordenadas de un sensor al sistema común
+ */
+struct SensorExtrinsic {
+    Vector rotation = {0, 0, 0};     ///< Rotación (grados) en los ejes x, y, z
+    Vector translation = {0, 0, 0};  ///< Traslación (mm) tras la rotación
+};
+
+/**
+ * @brief Escaner que combina los puntos de varios escaneres ordenados por timestamp.
+ * Cada escaner se ejecuta en su propio hilo y deposita sus puntos, ya transformados al sistema común,
+ * en un buffer de reordenación acotado. Se emite siempre el punto más antiguo de entre los buffers,
+ * esperando a que todos los escaneres activos tengan puntos salvo que alguno de los buffers esté lleno
+ */
+class ScannerMerged : public IScanner {
+   private:
+    /**
+     * Sensor combinado
+     */
+    struct Sensor {
+        IScanner *scanner;              ///< Escaner del sensor
+        arma::mat33 rotation;           ///< Matriz de rotación extrínseca
+        Vector translation;             ///< Traslación extrínseca
+        bool identity;                  ///< La transformación extrínseca es la identidad
+        std::deque<LidarPoint> buffer;  ///< Buffer de reordenación
+        bool finished;                  ///< El escaner ha llegado al final de sus puntos
+        bool running;                   ///< El hilo del escaner está escaneando
+        ScanCode code;                  ///< Código devuelto por el último escaneo
+        std::thread thread;             ///< Hilo de escaneo
+    };
+
+    std::vector<Sensor> sensors;  ///< Sensores combinados
+    size_t capacity;              ///< Puntos máximos en cada buffer de reordenación
+
+    std::mutex mutex;                    ///< Mutex de acceso a los buffers
+    std::condition_variable dataReady;   ///< Notificación de nuevos puntos o de final de escaneo de un sensor
+    std::condition_variable spaceReady;  ///< Notificación de espacio libre en los buffers
+
+   public:
+    /**
+     * Devuelve la instancia única creada del escaner
+     * @return Instancia única del escaner
+     */
+    static ScannerMerged *getInstance() { return (ScannerMerged *)instance; }
+
+    /**
+     * Crea una instancia unica del escaner si no existe
+     * @param sensors Escaneres a combinar junto con su transformación extrínseca
+     * @param capacity Puntos máximos en cada buffer de reordenación
+     * @return Instancia única del escaner
+     */
+    static IScanner *create(const std::vector<std::pair<IScanner *, SensorExtrinsic>> &sensors, size_t capacity = MERGED_SCANNER_BUFFER) {
+        static ScannerMerged scanner = {sensors, capacity};
+        instance = (IScanner *)&scanner;
+        return instance;
+    }
+
+    /**
+     * Lee las transformaciones extrínsecas de un archivo con una línea por sensor en el formato
+     * <code>codigo rx ry rz tx ty tz</code>, con la rotación en grados y la traslación en mm
+     * @param filename Archivo de transformaciones
+     * @param extrinsics Transformaciones leídas indexadas por el código del sensor
+     * @return true si se ha leído el archivo correctamente
+     */
+    static bool readExtrinsics(const std::string &filename, std::map<std::string, SensorExtrinsic> &extrinsics);
+
+    /**
+     * Inicialización de los escaneres combinados
+     * @return Se devolverá true si se han establecido todos los escaneres correctamente
+     */
+    bool init();
+
+    /**
+     * Comienza a escanear puntos.
+     * Si no se quiere escanear hasta el final de todos los escaneres será responsabilidad del programador
+     * hacer una llamada a la función pause() cuando se requiera parar el escaneo.
+     * @return Se devolverá un ScanCode respecto a como ha finalizado el escaneo
+     */
+    ScanCode scan();
+
+    /**
+     * Pausa el escaneo de puntos
+     */
+    void pause();
+
+    /**
+     * Establece la función especificada como función de callback a la que se llamará cada vez que
+     * se escanee un nuevo punto
+     * @param func Función de callback a ser llamada por el sensor
+     * @return Se devolverá true si se ha establecido el callback correctamente
+     */
+    bool setCallback(const std::function<void(const LidarPoint &p)> func);
+
+    /**
+     * Finaliza los escaneres combinados
+     */
+    void stop();
+
+   protected:
+    /**
+     * Constructor del objeto ScannerMerged
+     * @param sensors Escaneres a combinar junto con su transformación extrínseca
+     * @param capacity Puntos máximos en cada buffer de reordenación
+     */
+    ScannerMerged(const std::vector<std::pair<IScanner *, SensorExtrinsic>> &sensors, size_t capacity = MERGED_SCANNER_BUFFER);
+    /**
+     * Destructor del scanner. Detiene y espera a los hilos de escaneo que sigan activos
+     */
+    ~ScannerMerged();
+
+    /**
+     * Transforma y almacena un punto escaneado por un sensor. Bloquea el hilo del sensor mientras su buffer esté lleno
+     * @param sensor Índice del sensor
+     * @param p Punto escaneado
+     */
+    void push(size_t sensor, const LidarPoint &p);
+};
+
+#endif  // SCANNERMERGED_CLASS_H
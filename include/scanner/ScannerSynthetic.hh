@@ -0,0 +1,187 @@
+/**
+ * @file ScannerSynthetic.hh
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Definicion del objeto ScannerSynthetic
+ *
+ */
+
+#ifndef SCANNERSYNTHETIC_CLASS_H
+#define SCANNERSYNTHETIC_CLASS_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+#include "scanner/IScanner.hh"
+#include "models/LidarPoint.hh"
+#include "models/Timestamp.hh"
+#include "models/Point.hh"
+
+#include "logging/debug.hh"
+
+#define SYNTHETIC_POINTS_PER_PACKET 96  ///< Puntos por paquete de un sensor LIVOX en coordenadas cartesianas extendidas
+
+/**
+ * Caras de una caja sintética, utilizadas como máscara de bits
+ */
+enum SyntheticFace {
+    kFaceNegX = 0b000001,  ///< Cara en -x
+    kFacePosX = 0b000010,  ///< Cara en +x
+    kFaceNegY = 0b000100,  ///< Cara en -y
+    kFacePosY = 0b001000,  ///< Cara en +y
+    kFaceNegZ = 0b010000,  ///< Cara en -z
+    kFacePosZ = 0b100000,  ///< Cara en +z
+};
+
+/**
+ * Abolladura esférica sobre una cara de una caja sintética
+ */
+struct SyntheticDent {
+    int face;       ///< Índice de la cara (0: -x, 1: +x, 2: -y, 3: +y, 4: -z, 5: +z)
+    double u;       ///< Posición relativa [0, 1] en el primer eje de la cara
+    double v;       ///< Posición relativa [0, 1] en el segundo eje de la cara
+    double radius;  ///< Radio (mm) de la abolladura
+    double depth;   ///< Profundidad (mm) de la abolladura
+};
+
+/**
+ * Caja paramétrica de una escena sintética
+ */
+struct SyntheticBox {
+    Point center;                       ///< Centro (mm) de la caja
+    Vector dimensions;                  ///< Dimensiones (mm) de la caja
+    Vector rotation = {0, 0, 0};        ///< Rotación (grados) en los ejes x, y, z
+    int missingFaces = kFaceNegZ;       ///< Máscara de caras no visibles por el sensor
+    std::vector<SyntheticDent> dents;   ///< Abolladuras de la caja
+    uint32_t reflectivity = 100;        ///< Reflectividad de los puntos de la caja
+};
+
+/**
+ * Escena sintética compuesta por un fondo (suelo y paredes) y cajas paramétricas.
+ * El sensor se sitúa en el origen mirando hacia +x
+ */
+struct SyntheticScene {
+    double roomDepth = 6000;               ///< Distancia (mm) del sensor a la pared del fondo
+    double roomWidth = 4000;               ///< Ancho (mm) de la habitación
+    double roomHeight = 3000;              ///< Alto (mm) de la habitación
+    double sensorHeight = 1000;            ///< Altura (mm) del sensor sobre el suelo
+    bool floor = true;                     ///< Generar el suelo
+    bool walls = true;                     ///< Generar las paredes
+    uint32_t backgroundReflectivity = 20;  ///< Reflectividad de los puntos del fondo
+
+    std::vector<SyntheticBox> boxes;  ///< Cajas de la escena
+
+    double density = 5000;        ///< Puntos por metro cuadrado de superficie
+    double noise = 2;             ///< Desviación típica (mm) del ruido en la distancia al sensor
+    uint32_t pointRate = 240000;  ///< Puntos por segundo emitidos (LIVOX Horizon)
+    uint32_t objectDelay = 5000;  ///< Milisegundos de escaneo tras los que aparecen las cajas
+    uint32_t duration = 0;        ///< Milisegundos de escaneo hasta el final de la escena (0: sin final)
+    uint32_t seed = 42;           ///< Semilla del generador de números aleatorios
+};
+
+/**
+ * @brief Escaner que genera proceduralmente los puntos de una escena sintética
+ */
+class ScannerSynthetic : public IScanner {
+   private:
+    SyntheticScene scene;  ///< Escena a escanear
+
+    std::vector<LidarPoint> backgroundCloud;  ///< Nube de puntos del fondo
+    std::vector<LidarPoint> sceneCloud;       ///< Nube de puntos del fondo y las cajas
+
+    Timestamp startTime;         ///< Timestamp del primer punto emitido
+    uint64_t emitted;            ///< Puntos emitidos desde el inicio de la escena
+    size_t backgroundOffset;     ///< Siguiente punto a emitir de la nube del fondo
+    size_t sceneOffset;          ///< Siguiente punto a emitir de la nube de la escena
+
+   public:
+    /**
+     * Devuelve la instancia única creada del escaner
+     * @return Instancia única del escaner
+     */
+    static ScannerSynthetic *getInstance() { return (ScannerSynthetic *)instance; }
+
+    /**
+     * Crea una instancia unica del escaner si no existe
+     * @param scene Escena a escanear
+     * @return Instancia única del escaner
+     */
+    static IScanner *create(const SyntheticScene &scene) {
+        static ScannerSynthetic scanner = {scene};
+        instance = (IScanner *)&scanner;
+        return instance;
+    }
+
+    /**
+     * Genera la nube de puntos de la escena
+     * @return Se devolverá true si se ha establecido el escaner correctamente
+     */
+    bool init();
+
+    /**
+     * Comienza a escanear puntos.
+     * Si no se quiere escanear hasta el final de la escena será responsabilidad del programador
+     * hacer una llamada a la función pause() cuando se requiera parar el escaneo.
+     * @return Se devolverá un ScanCode respecto a como ha finalizado el escaneo
+     */
+    ScanCode scan();
+
+    /**
+     * Pausa el escaneo de puntos
+     */
+    void pause();
+
+    /**
+     * Establece la función especificada como función de callback a la que se llamará cada vez que
+     * se escanee un nuevo punto
+     * @param func Función de callback a ser llamada por el sensor
+     * @return Se devolverá true si se ha establecido el callback correctamente
+     */
+    bool setCallback(const std::function<void(const LidarPoint &p)> func);
+
+    /**
+     * Finaliza el escaner
+     */
+    void stop();
+
+    /**
+     * Genera un número exacto de puntos repartidos uniformemente sobre las superficies de la escena
+     * @param scene Escena a muestrear
+     * @param points Número de puntos a generar
+     * @param background Incluir el suelo y las paredes
+     * @param objects Incluir las cajas
+     * @return Puntos generados, sin timestamp
+     */
+    static std::vector<LidarPoint> generate(const SyntheticScene &scene, size_t points, bool background = true, bool objects = true);
+
+    /**
+     * Calcula el área de las superficies visibles de la escena
+     * @param scene Escena a medir
+     * @param background Incluir el suelo y las paredes
+     * @param objects Incluir las cajas
+     * @return Área (mm²) de las superficies
+     */
+    static double area(const SyntheticScene &scene, bool background = true, bool objects = true);
+
+   protected:
+    /**
+     * Constructor del objeto ScannerSynthetic
+     * @param scene Escena a escanear
+     */
+    ScannerSynthetic(const SyntheticScene &scene) : scene(scene), startTime(0, 0), emitted(0), backgroundOffset(0), sceneOffset(0) {}
+    /**
+     * Destructor del scanner
+     */
+    ~ScannerSynthetic() {}
+
+    /**
+     * Emite los puntos de la escena con timestamps de paquete LIVOX
+     * @return Devuelve un ScanCode según la finalización de la escena
+     */
+    ScanCode readData();
+};
+
+#endif  // SCANNERSYNTHETIC_CLASS_H
@@ -9,15 +9,484 @@
 
 #include <iomanip>
 #include <list>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
 #include <cmath>
+#include <atomic>
 
 #include "armadillo"
 
 #include "anomaly_detection/AnomalyDetector.hh"
 #include "object_characterization/CharacterizedObject.hh"
+#include "models/KDTree.hh"
 #include "app/CLI.hh"
 #include "app/config.h"
 
+// Emparejamiento voraz: en cada iteración se escoge el par de filas y columnas libres de menor coste. Ante costes iguales
+// se escoge el primero por filas. Devuelve los pares (fila, columna) en el orden en que se emparejan
+static std::vector<std::pair<size_t, size_t>> greedyMatching(const std::vector<double> &cost, size_t n, size_t m) {
+    std::vector<bool> rowUsage(n, false), colUsage(m, false);
+    std::vector<std::pair<size_t, size_t>> matches;
+
+    for (size_t comp = 0; comp < std::min(n, m); ++comp) {
+        size_t bi = n, bj = m;
+        for (size_t i = 0; i < n; ++i) {
+            if (rowUsage[i]) {
+                continue;
+            }
+            for (size_t j = 0; j < m; ++j) {
+                if (!colUsage[j] && (bi == n || cost[i * m + j] < cost[bi * m + bj])) {
+                    bi = i;
+                    bj = j;
+                }
+            }
+        }
+        rowUsage[bi] = true;
+        colUsage[bj] = true;
+        matches.push_back({bi, bj});
+    }
+
+    return matches;
+}
+
+// Asignación de coste total mínimo de las filas de una matriz de costes n x m (n <= m) a columnas distintas mediante el
+// algoritmo húngaro con potenciales (Jonker-Volgenant) en O(n^2 m). Devuelve la columna asignada a cada fila
+static std::vector<size_t> hungarian(const std::vector<double> &cost, size_t n, size_t m) {
+    const double inf = std::numeric_limits<double>::infinity();
+
+    // Índices desde 1; la columna 0 es ficticia y guarda la fila que se está insertando
+    std::vector<double> u(n + 1, 0), v(m + 1, 0), minv(m + 1);
+    std::vector<size_t> p(m + 1, 0), way(m + 1, 0);
+    std::vector<bool> used(m + 1);
+
+    for (size_t i = 1; i <= n; ++i) {
+        p[0] = i;
+        size_t j0 = 0;
+        std::fill(minv.begin(), minv.end(), inf);
+        std::fill(used.begin(), used.end(), false);
+
+        // Camino de aumento de coste reducido mínimo desde la nueva fila hasta una columna libre
+        do {
+            used[j0] = true;
+            const size_t i0 = p[j0];
+            size_t j1 = 0;
+            double delta = inf;
+            for (size_t j = 1; j <= m; ++j) {
+                if (!used[j]) {
+                    const double reduced = cost[(i0 - 1) * m + j - 1] - u[i0] - v[j];
+                    if (reduced < minv[j]) {
+                        minv[j] = reduced;
+                        way[j] = j0;
+                    }
+                    if (minv[j] < delta) {
+                        delta = minv[j];
+                        j1 = j;
+                    }
+                }
+            }
+            for (size_t j = 0; j <= m; ++j) {
+                if (used[j]) {
+                    u[p[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    minv[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (p[j0] != 0);
+
+        // Intercambio de las asignaciones a lo largo del camino
+        do {
+            const size_t j1 = way[j0];
+            p[j0] = p[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    std::vector<size_t> assignment(n);
+    for (size_t j = 1; j <= m; ++j) {
+        if (p[j] != 0) {
+            assignment[p[j] - 1] = j - 1;
+        }
+    }
+    return assignment;
+}
+
+// Asignación de coste total mínimo entre filas y columnas de una matriz de costes n x m. Devuelve los pares
+// (fila, columna) ordenados por fila
+static std::vector<std::pair<size_t, size_t>> optimalMatching(const std::vector<double> &cost, size_t n, size_t m) {
+    std::vector<std::pair<size_t, size_t>> matches;
+
+    if (n <= m) {
+        std::vector<size_t> assignment = hungarian(cost, n, m);
+        for (size_t i = 0; i < n; ++i) {
+            matches.push_back({i, assignment[i]});
+        }
+    } else {
+        // El algoritmo requiere no más filas que columnas: se asignan las columnas sobre la matriz traspuesta
+        std::vector<double> transposed(m * n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < m; ++j) {
+                transposed[j * n + i] = cost[i * m + j];
+            }
+        }
+        std::vector<size_t> assignment = hungarian(transposed, m, n);
+        for (size_t j = 0; j < m; ++j) {
+            matches.push_back({assignment[j], j});
+        }
+        std::sort(matches.begin(), matches.end());
+    }
+
+    return matches;
+}
+
+// Coste de emparejar dos caras a partir de sus descriptores y del valor absoluto del coseno entre sus normales unitarias
+static double descriptorCost(const FaceDescriptor &obj, const FaceDescriptor &mod, double cosine) {
+    // Diferencias relativas al mayor de ambos valores, en [0, 1]
+    const double maxVolume = std::max(obj.volume, mod.volume);
+    const double volumeCost = maxVolume > 0 ? std::fabs(mod.volume - obj.volume) / maxVolume : 0;
+    const double maxDelta = std::max(obj.deltaModule, mod.deltaModule);
+    const double deltaCost = maxDelta > 0 ? (mod.delta - obj.delta).module() / maxDelta : 0;
+
+    // Ángulo entre las rectas de las normales, independiente de su sentido, como fracción de 90º
+    const double normalCost = obj.oriented && mod.oriented ? std::acos(std::min(1., cosine)) / (M_PI / 2) : 0;
+
+    return FACE_MATCHING_VOLUME_WEIGHT * volumeCost + FACE_MATCHING_DELTA_WEIGHT * deltaCost + FACE_MATCHING_NORMAL_WEIGHT * normalCost;
+}
+
+double AnomalyDetector::matchingCost(const Face& objFace, const Face& modFace) {
+    const FaceFeatures objFeatures({objFace}), modFeatures({modFace});
+    const double *objNormal = objFeatures.normals.colptr(0), *modNormal = modFeatures.normals.colptr(0);
+    const double cosine = std::fabs(objNormal[0] * modNormal[0] + objNormal[1] * modNormal[1] + objNormal[2] * modNormal[2]);
+    return descriptorCost(objFeatures.descriptors[0], modFeatures.descriptors[0], cosine);
+}
+
+std::vector<std::pair<size_t, size_t>> AnomalyDetector::matchFaces(const std::vector<Face>& objFaces, const std::vector<Face>& modFaces, FaceMatching mode) {
+    return matchFaces(FaceFeatures(objFaces), FaceFeatures(modFaces), mode);
+}
+
+std::vector<std::pair<size_t, size_t>> AnomalyDetector::matchFaces(const FaceFeatures& objFaces, const FaceFeatures& modFaces, FaceMatching mode) {
+    const size_t n = objFaces.size(), m = modFaces.size();
+    if (n == 0 || m == 0) {
+        return {};
+    }
+
+    // Cosenos entre las normales de todas las caras del objeto (filas) y del modelo (columnas)
+    const arma::mat cosines = mode == kFaceMatchingGreedy ? arma::mat() : arma::mat(objFaces.normals.t() * modFaces.normals);
+
+    // Matriz de costes con una fila por cara del objeto
+    std::vector<double> cost(n * m);
+#pragma omp parallel for collapse(2) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            cost[i * m + j] = mode == kFaceMatchingGreedy ? std::fabs(modFaces.descriptors[j].volume - objFaces.descriptors[i].volume)
+                                                          : descriptorCost(objFaces.descriptors[i], modFaces.descriptors[j], std::fabs(cosines(i, j)));
+        }
+    }
+
+    return mode == kFaceMatchingGreedy ? greedyMatching(cost, n, m) : optimalMatching(cost, n, m);
+}
+
+/**
+ * Transformación rígida de puntos: rotación seguida de traslación
+ */
+struct RigidTransform {
+    double r[3][3];  ///< Matriz de rotación
+    double t[3];     ///< Traslación
+};
+
+// Aplica una transformación rígida a un punto
+static inline Point transform(const RigidTransform &T, const Point &p) {
+    return Point(T.r[0][0] * p.getX() + T.r[0][1] * p.getY() + T.r[0][2] * p.getZ() + T.t[0],
+                 T.r[1][0] * p.getX() + T.r[1][1] * p.getY() + T.r[1][2] * p.getZ() + T.t[1],
+                 T.r[2][0] * p.getX() + T.r[2][1] * p.getY() + T.r[2][2] * p.getZ() + T.t[2]);
+}
+
+// Composición de dos transformaciones: aplica primero b y después a
+static RigidTransform compose(const RigidTransform &a, const RigidTransform &b) {
+    RigidTransform c;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            c.r[i][j] = a.r[i][0] * b.r[0][j] + a.r[i][1] * b.r[1][j] + a.r[i][2] * b.r[2][j];
+        }
+        c.t[i] = a.r[i][0] * b.t[0] + a.r[i][1] * b.t[1] + a.r[i][2] * b.t[2] + a.t[i];
+    }
+    return c;
+}
+
+// Transformación a partir de un vector de rotación (fórmula de Rodrigues) y una traslación
+static RigidTransform rigidTransform(const double w[3], const double t[3]) {
+    RigidTransform T;
+    const double theta = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+    const double k[3] = {theta > 0 ? w[0] / theta : 0, theta > 0 ? w[1] / theta : 0, theta > 0 ? w[2] / theta : 0};
+    const double c = std::cos(theta), s = std::sin(theta), v = 1 - c;
+
+    T.r[0][0] = c + k[0] * k[0] * v;
+    T.r[0][1] = k[0] * k[1] * v - k[2] * s;
+    T.r[0][2] = k[0] * k[2] * v + k[1] * s;
+    T.r[1][0] = k[1] * k[0] * v + k[2] * s;
+    T.r[1][1] = c + k[1] * k[1] * v;
+    T.r[1][2] = k[1] * k[2] * v - k[0] * s;
+    T.r[2][0] = k[2] * k[0] * v - k[1] * s;
+    T.r[2][1] = k[2] * k[1] * v + k[0] * s;
+    T.r[2][2] = c + k[2] * k[2] * v;
+    T.t[0] = t[0];
+    T.t[1] = t[1];
+    T.t[2] = t[2];
+    return T;
+}
+
+// Resuelve el sistema 6x6 A x = b por eliminación gaussiana con pivotado parcial. Devuelve false si es singular
+static bool solve6(double A[36], double b[6], double x[6]) {
+    for (int col = 0; col < 6; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < 6; ++row) {
+            if (std::fabs(A[row * 6 + col]) > std::fabs(A[pivot * 6 + col])) {
+                pivot = row;
+            }
+        }
+        if (std::fabs(A[pivot * 6 + col]) < 1e-12) {
+            return false;
+        }
+        if (pivot != col) {
+            for (int k = 0; k < 6; ++k) {
+                std::swap(A[col * 6 + k], A[pivot * 6 + k]);
+            }
+            std::swap(b[col], b[pivot]);
+        }
+        for (int row = col + 1; row < 6; ++row) {
+            const double f = A[row * 6 + col] / A[col * 6 + col];
+            for (int k = col; k < 6; ++k) {
+                A[row * 6 + k] -= f * A[col * 6 + k];
+            }
+            b[row] -= f * b[col];
+        }
+    }
+    for (int row = 5; row >= 0; --row) {
+        double sum = b[row];
+        for (int k = row + 1; k < 6; ++k) {
+            sum -= A[row * 6 + k] * x[k];
+        }
+        x[row] = sum / A[row * 6 + row];
+    }
+    return true;
+}
+
+// Límites de los puntos en cada eje
+static void pointBounds(const PointCloud &points, double lo[3], double hi[3]) {
+    lo[0] = hi[0] = points.getX(0);
+    lo[1] = hi[1] = points.getY(0);
+    lo[2] = hi[2] = points.getZ(0);
+    for (size_t i = 1; i < points.size(); ++i) {
+        const double c[3] = {points.getX(i), points.getY(i), points.getZ(i)};
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], c[a]);
+            hi[a] = std::max(hi[a], c[a]);
+        }
+    }
+}
+
+// Alineación inicial del objeto sobre el modelo: centros de sus límites coincidentes y ejes emparejados por longitud,
+// probando las cuatro rotaciones de 180º que conservan los límites. Se escoge la de menor distancia media a la
+// superficie del modelo sobre una submuestra de puntos del objeto
+static RigidTransform initialAlignment(const PointCloud &objPoints, const PointCloud &modPoints, const KDTree &tree) {
+    double olo[3], ohi[3], mlo[3], mhi[3];
+    pointBounds(objPoints, olo, ohi);
+    pointBounds(modPoints, mlo, mhi);
+
+    // Ejes de cada nube ordenados por longitud
+    int oaxes[3] = {0, 1, 2}, maxes[3] = {0, 1, 2};
+    std::sort(oaxes, oaxes + 3, [&](int a, int b) { return ohi[a] - olo[a] > ohi[b] - olo[b]; });
+    std::sort(maxes, maxes + 3, [&](int a, int b) { return mhi[a] - mlo[a] > mhi[b] - mlo[b]; });
+
+    const size_t stride = std::max<size_t>(1, objPoints.size() / 500);
+    RigidTransform best{};
+    double bestScore = std::numeric_limits<double>::infinity();
+    for (int signs = 0; signs < 8; ++signs) {
+        RigidTransform T{};
+        for (int k = 0; k < 3; ++k) {
+            T.r[maxes[k]][oaxes[k]] = (signs >> k) & 1 ? -1 : 1;
+        }
+        const double det = T.r[0][0] * (T.r[1][1] * T.r[2][2] - T.r[1][2] * T.r[2][1]) -
+                           T.r[0][1] * (T.r[1][0] * T.r[2][2] - T.r[1][2] * T.r[2][0]) +
+                           T.r[0][2] * (T.r[1][0] * T.r[2][1] - T.r[1][1] * T.r[2][0]);
+        if (det < 0) {
+            continue;  // Reflexión
+        }
+        for (int i = 0; i < 3; ++i) {
+            T.t[i] = (mlo[i] + mhi[i]) / 2;
+            for (int j = 0; j < 3; ++j) {
+                T.t[i] -= T.r[i][j] * (olo[j] + ohi[j]) / 2;
+            }
+        }
+
+        double score = 0;
+#pragma omp parallel for reduction(+ : score) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+        for (size_t i = 0; i < objPoints.size(); i += stride) {
+            score += std::min<double>(tree.nearest(transform(T, objPoints[i]), ICP_MAX_CORRESPONDENCE).second, ICP_MAX_CORRESPONDENCE);
+        }
+        if (score < bestScore) {
+            bestScore = score;
+            best = T;
+        }
+    }
+
+    return best;
+}
+
+// Registro punto a plano de los puntos del objeto sobre la superficie del modelo, partiendo de la alineación inicial
+static RigidTransform registration(const PointCloud &objPoints, const PointCloud &modPoints, const ModelFeatures &features, bool &converged, size_t &iterations) {
+    RigidTransform T = initialAlignment(objPoints, modPoints, features.tree);
+
+    const size_t stride = std::max<size_t>(1, objPoints.size() / ICP_SAMPLE_POINTS);
+    converged = false;
+    iterations = 0;
+    while (iterations < ICP_MAX_ITERATIONS && !converged) {
+        ++iterations;
+
+        // Ecuaciones normales del error punto a plano linealizado: (J^T J) x = -J^T r, con x = [rotación, traslación]
+        double ata[36] = {0}, atb[6] = {0};
+        size_t count = 0;
+#pragma omp parallel for reduction(+ : ata[:36], atb[:6], count) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+        for (size_t i = 0; i < objPoints.size(); i += stride) {
+            const Point p = transform(T, objPoints[i]);
+            const std::pair<size_t, double> nn = features.tree.nearest(p, ICP_MAX_CORRESPONDENCE);
+            if (nn.first == features.tree.size()) {
+                continue;  // Sin correspondencia cercana
+            }
+
+            const Vector &n = features.normals[nn.first];
+            const Vector c = p.crossProduct(n);
+            const double J[6] = {c.getX(), c.getY(), c.getZ(), n.getX(), n.getY(), n.getZ()};
+            const double r = (p - modPoints[nn.first]).scalarProduct(n);
+            for (int a = 0; a < 6; ++a) {
+                for (int b = 0; b < 6; ++b) {
+                    ata[a * 6 + b] += J[a] * J[b];
+                }
+                atb[a] -= J[a] * r;
+            }
+            ++count;
+        }
+
+        double x[6];
+        if (count < 6 || !solve6(ata, atb, x)) {
+            break;
+        }
+        T = compose(rigidTransform(x, x + 3), T);
+
+        converged = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]) < ICP_CONVERGENCE_ROTATION &&
+                    std::sqrt(x[3] * x[3] + x[4] * x[4] + x[5] * x[5]) < ICP_CONVERGENCE_TRANSLATION;
+    }
+
+    return T;
+}
+
+// Puntos transformados por una transformación rígida
+static PointCloud transform(const RigidTransform &T, const PointCloud &points) {
+    PointCloud moved;
+    moved.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        moved.push_back(transform(T, points[i]));
+    }
+    return moved;
+}
+
+// Mapa y estadísticas de las desviaciones de los puntos registrados del objeto respecto a la superficie del modelo
+static DeviationReport deviationMap(const PointCloud &registered, const PointCloud &modPoints, const ModelFeatures &features, bool converged, size_t iterations) {
+    std::vector<double> deviation(registered.size());
+    double squares = 0, max = 0;
+    size_t outliers = 0;
+#pragma omp parallel for reduction(+ : squares, outliers) reduction(max : max) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < registered.size(); ++i) {
+        const Point p = registered[i];
+        const size_t nn = features.tree.nearest(p).first;
+        deviation[i] = (p - modPoints[nn]).scalarProduct(features.normals[nn]);
+
+        const double d = std::fabs(deviation[i]);
+        squares += d * d;
+        max = std::max(max, d);
+        outliers += d > DEVIATION_THRESHOLD;
+    }
+
+    std::vector<double> absolute(deviation.size());
+    for (size_t i = 0; i < deviation.size(); ++i) {
+        absolute[i] = std::fabs(deviation[i]);
+    }
+    const size_t rank = std::min(absolute.size() - 1, static_cast<size_t>(DEVIATION_PERCENTILE * absolute.size()));
+    std::nth_element(absolute.begin(), absolute.begin() + rank, absolute.end());
+
+    return DeviationReport(outliers <= DEVIATION_MAX_OUTLIERS * registered.size(), converged, iterations, std::sqrt(squares / registered.size()), max, absolute[rank], outliers, deviation);
+}
+
+// Suma y máximo de las distancias de cada punto al más cercano del árbol. Si alguna distancia supera el umbral
+// se abandonan los puntos restantes, se marca exceeded y el máximo pasa a ser la distancia que lo ha superado
+static std::pair<double, double> nearestDistances(const PointCloud &points, const KDTree &tree, double threshold, std::atomic<bool> &exceeded) {
+    double sum = 0, max = 0;
+#pragma omp parallel for reduction(+ : sum) reduction(max : max) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (exceeded.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        const double d = tree.nearest(points[i]).second;
+        sum += d;
+        max = std::max(max, d);
+        if (d > threshold) {
+            exceeded.store(true, std::memory_order_relaxed);
+        }
+    }
+    return {sum, max};
+}
+
+// Distancias de Chamfer y Hausdorff entre los puntos registrados del objeto y los del modelo. El umbral y la
+// similitud solo se aplican a las distancias del objeto al modelo, de forma que las oclusiones no son anomalías
+static DistanceReport surfaceDistances(const PointCloud &registered, const PointCloud &modPoints, const ModelFeatures &features, double threshold) {
+    std::atomic<bool> exceeded(false);
+    std::pair<double, double> objToMod = nearestDistances(registered, features.tree, threshold, exceeded);
+    if (exceeded) {
+        const double inf = std::numeric_limits<double>::infinity();
+        return DistanceReport(false, true, inf, objToMod.second, inf, objToMod.second);
+    }
+
+    std::atomic<bool> unbounded(false);
+    std::pair<double, double> modToObj = nearestDistances(modPoints, KDTree(registered), std::numeric_limits<double>::infinity(), unbounded);  // Índice temporal del objeto registrado
+
+    const double directedChamfer = objToMod.first / registered.size();
+    const double chamfer = (directedChamfer + modToObj.first / modPoints.size()) / 2;
+    return DistanceReport(directedChamfer <= CHAMFER_THRESHOLD, false, chamfer, std::max(objToMod.second, modToObj.second), directedChamfer, objToMod.second);
+}
+
+DeviationReport AnomalyDetector::deviations(const CharacterizedObject& obj, const Model& model) {
+    const PointCloud &objPoints = obj.getPoints(), &modPoints = model.getPoints();
+    if (objPoints.size() == 0 || modPoints.size() == 0) {
+        return DeviationReport();
+    }
+
+    const std::shared_ptr<const ModelFeatures> features = model.getFeatures();
+    bool converged;
+    size_t iterations;
+    RigidTransform T = registration(objPoints, modPoints, *features, converged, iterations);
+    return deviationMap(transform(T, objPoints), modPoints, *features, converged, iterations);
+}
+
+DistanceReport AnomalyDetector::distances(const CharacterizedObject& obj, const Model& model, double threshold) {
+    const PointCloud &objPoints = obj.getPoints(), &modPoints = model.getPoints();
+    if (objPoints.size() == 0 || modPoints.size() == 0) {
+        return DistanceReport();
+    }
+
+    const std::shared_ptr<const ModelFeatures> features = model.getFeatures();
+    bool converged;
+    size_t iterations;
+    RigidTransform T = registration(objPoints, modPoints, *features, converged, iterations);
+    return surfaceDistances(transform(T, objPoints), modPoints, *features, threshold);
+}
+
 AnomalyReport AnomalyDetector::compare(const CharacterizedObject& obj, const Model& mod) {
     std::chrono::system_clock::time_point start, end;
     if (chrono) {
@@ -52,80 +521,72 @@ AnomalyReport AnomalyDetector::compare(const CharacterizedObject& obj, const Mod
     // Comparación de caras //
     //////////////////////////
 
-    std::vector<FaceComparison>
-        faceComparisons;
-
-    double deltaVolumes[obj.getFaces().size()][mod.getFaces().size()];  // Matriz de deltas de volumenes
-    std::vector<bool> objFaceUsage(obj.getFaces().size(), false);       // Caras del objeto ya usadas
-    std::vector<bool> modFaceUsage(mod.getFaces().size(), false);       // Caras del modelo ya usadas
-
-    size_t tcomp = deltaFaces < 0 ? mod.getFaces().size() : obj.getFaces().size();  // Máximo de iteraciones posibles en la comparación de caras
-    size_t objFaceIndex, modFaceIndex;
-    double minDeltaVolume;
-#pragma omp parallel
-    {
-#pragma omp for collapse(2) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-        for (size_t i = 0; i < obj.getFaces().size(); ++i) {
-            for (size_t j = 0; j < mod.getFaces().size(); ++j) {
-                deltaVolumes[i][j] = std::fabs(mod.getFaces()[j].getMinBBox().volume() - obj.getFaces()[i].getMinBBox().volume());
-            }
-        }
-        // Buscamos en cada iteración el delta mínimo de las caras restantes
-        for (size_t comp = 0; comp < tcomp; ++comp) {
-#pragma omp single
-            {
-                for (objFaceIndex = 0; objFaceUsage[objFaceIndex] && objFaceIndex < objFaceUsage.size(); ++objFaceIndex) {}
-                for (modFaceIndex = 0; modFaceUsage[modFaceIndex] && modFaceIndex < modFaceUsage.size(); ++modFaceIndex) {}
-                minDeltaVolume = deltaVolumes[objFaceIndex][modFaceIndex];
-            }
-            // Implicit barrier
-            // Recorremos los elementos restantes de la matriz en busca del mínimo
-#pragma omp for collapse(2) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-            for (size_t oi = 0; oi < obj.getFaces().size(); ++oi) {
-                for (size_t mi = 0; mi < mod.getFaces().size(); ++mi) {
-                    // El primer elemento es el mínimo por defecto
-                    // Pasamos las caras ya comparadas
-                    if (objFaceUsage[oi] || modFaceUsage[mi] || (oi == objFaceIndex && mi == modFaceIndex)) {
-                        continue;
-                    } else {
-#pragma omp critical
-                        if (deltaVolumes[oi][mi] < minDeltaVolume) {
-                            objFaceIndex = oi;
-                            modFaceIndex = mi;
-                            minDeltaVolume = deltaVolumes[objFaceIndex][modFaceIndex];
-                        }
-                    }
-                }
-            }
+    std::vector<FaceComparison> faceComparisons;
+    std::vector<bool> objFaceUsage(obj.getFaces().size(), false);  // Caras del objeto ya usadas
+    std::vector<bool> modFaceUsage(mod.getFaces().size(), false);  // Caras del modelo ya usadas
 
-#pragma omp single
-            {
-                // Eliminamos caras
-                modFaceUsage[modFaceIndex] = true;
-                objFaceUsage[objFaceIndex] = true;
-
-                // Comparación
-                Vector faceDelta = mod.getFaces()[modFaceIndex].getMinBBox().getDelta() - obj.getFaces()[objFaceIndex].getMinBBox().getDelta();
-                faceComparisons.push_back(FaceComparison((std::fabs(faceDelta.getX()) <= MAX_DIMENSION_DELTA &&
-                                                          std::fabs(faceDelta.getY()) <= MAX_DIMENSION_DELTA &&
-                                                          std::fabs(faceDelta.getZ()) <= MAX_DIMENSION_DELTA)
-                                                             ? true
-                                                             : false,
-                                                         modFaceIndex,
-                                                         objFaceIndex,
-                                                         faceDelta));
-
-                if (similar) {
-                    similar = faceComparisons.back().similar;
-                }
-                if (!faceComparisons.back().similar) {
-                    ++totalAnomalies;
-                }
-            }
-            // Implicit barrier
+    // Descriptores del modelo precalculados y del objeto calculados en cada comparación
+    const std::shared_ptr<const FaceFeatures> modFaceFeatures = mod.getFaceFeatures();
+    const FaceFeatures &modFeatures = *modFaceFeatures;
+    const FaceFeatures objFeatures(obj.getFaces());
+
+    for (const std::pair<size_t, size_t> &match : matchFaces(objFeatures, modFeatures, matching)) {
+        const size_t objFaceIndex = match.first, modFaceIndex = match.second;
+        objFaceUsage[objFaceIndex] = true;
+        modFaceUsage[modFaceIndex] = true;
+
+        // Comparación
+        const Face &objFace = obj.getFaces()[objFaceIndex], &modFace = mod.getFaces()[modFaceIndex];
+        Vector faceDelta = modFeatures.descriptors[modFaceIndex].delta - objFeatures.descriptors[objFaceIndex].delta;
+        double deltaRMS = objFace.getPlaneRMS() - modFace.getPlaneRMS();  // Solo una cara del objeto menos plana es anómala
+        double deltaMax = objFace.getPlaneMaxResidual() - modFace.getPlaneMaxResidual();
+        bool flat = deltaRMS <= MAX_FACE_RMS_DELTA && deltaMax <= MAX_FACE_RESIDUAL_DELTA;
+        faceComparisons.push_back(FaceComparison((std::fabs(faceDelta.getX()) <= MAX_DIMENSION_DELTA &&
+                                                  std::fabs(faceDelta.getY()) <= MAX_DIMENSION_DELTA &&
+                                                  std::fabs(faceDelta.getZ()) <= MAX_DIMENSION_DELTA &&
+                                                  flat)
+                                                     ? true
+                                                     : false,
+                                                 modFaceIndex,
+                                                 objFaceIndex,
+                                                 faceDelta,
+                                                 flat,
+                                                 deltaRMS,
+                                                 deltaMax));
+
+        if (similar) {
+            similar = faceComparisons.back().similar;
+        }
+        if (!faceComparisons.back().similar) {
+            ++totalAnomalies;
         }
     }
 
+    ///////////////////////////////////
+    // Desviaciones de la superficie //
+    ///////////////////////////////////
+
+    // Un único registro compartido por el análisis de desviaciones y el cálculo de distancias. Las características
+    // de la superficie del modelo solo se construyen si alguno de los dos está activado
+    const PointCloud &objPoints = obj.getPoints(), &modPoints = mod.getPoints();
+    const bool surfaceAnalysis = (deviationAnalysis || distanceMetrics) && objPoints.size() > 0 && modPoints.size() > 0;
+    const std::shared_ptr<const ModelFeatures> features = surfaceAnalysis ? mod.getFeatures() : nullptr;
+    bool converged = false;
+    size_t iterations = 0;
+    PointCloud registered = surfaceAnalysis ? transform(registration(objPoints, modPoints, *features, converged, iterations), objPoints) : PointCloud();
+
+    DeviationReport deviation = surfaceAnalysis && deviationAnalysis ? deviationMap(registered, modPoints, *features, converged, iterations) : DeviationReport();
+    if (!deviation.similar) {
+        similar = false;
+        ++totalAnomalies;
+    }
+
+    DistanceReport distance = surfaceAnalysis && distanceMetrics ? surfaceDistances(registered, modPoints, *features, HAUSDORFF_THRESHOLD) : DistanceReport();
+    if (!distance.similar) {
+        similar = false;
+        ++totalAnomalies;
+    }
+
     // Guardado de caras sin emparejar
     std::vector<size_t> unmatched;
     std::vector<bool>& faceUsage = deltaFaces < 0 ? objFaceUsage : modFaceUsage;
@@ -143,5 +604,98 @@ AnomalyReport AnomalyDetector::compare(const CharacterizedObject& obj, const Mod
         CLI_STDOUT("Anomaly detection lasted " << std::setprecision(6) << duration << std::setprecision(2) << " s");
     }
 
-    return AnomalyReport(similar, generalComparison, deltaFaces, totalAnomalies, faceComparisons, unmatched);
-}
\ No newline at end of file
+    return AnomalyReport(similar, generalComparison, deltaFaces, totalAnomalies, faceComparisons, unmatched, deviation, distance);
+}
+
+// Distancia media (mm) entre las bounding boxes global y de las caras emparejadas de un informe de anomalías
+static double reportDistance(const AnomalyReport& report) {
+    double faces = 0;
+    for (const FaceComparison& fc : report.faceComparisons) {
+        faces += fc.deltas.module();
+    }
+    return report.generalComparison.deltas.module() + (report.faceComparisons.size() > 0 ? faces / report.faceComparisons.size() : 0);
+}
+
+ClassificationReport AnomalyDetector::classify(const CharacterizedObject& obj, const std::unordered_map<std::string, Model>& models) {
+    std::vector<std::pair<std::string, const Model*>> candidates;
+    for (const std::pair<const std::string, Model>& m : models) {
+        candidates.push_back({m.first, &m.second});
+    }
+    return classify(obj, candidates);
+}
+
+ClassificationReport AnomalyDetector::classify(const CharacterizedObject& obj, const std::vector<std::pair<std::string, const Model*>>& models) {
+    std::chrono::system_clock::time_point start, end;
+    if (chrono) {
+        start = std::chrono::high_resolution_clock::now();
+    }
+
+    /////////////////////
+    // Filtrado previo //
+    /////////////////////
+
+    // Comprobaciones baratas de la bounding box global y del número de caras
+    std::vector<std::pair<std::string, const Model*>> candidates;
+    std::vector<std::string> pruned;
+    for (const std::pair<std::string, const Model*>& m : models) {
+        Vector delta = m.second->getBBox().getDelta() - obj.getBBox().getDelta();
+        long deltaFaces = static_cast<long>(m.second->getFaces().size()) - static_cast<long>(obj.getFaces().size());
+
+        if (std::fabs(delta.getX()) > CLASSIFY_MAX_BBOX_DELTA ||
+            std::fabs(delta.getY()) > CLASSIFY_MAX_BBOX_DELTA ||
+            std::fabs(delta.getZ()) > CLASSIFY_MAX_BBOX_DELTA ||
+            std::labs(deltaFaces) > CLASSIFY_MAX_FACE_DELTA) {
+            pruned.push_back(m.first);
+        } else {
+            candidates.push_back(m);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());  // Orden independiente del de entrada
+    std::sort(pruned.begin(), pruned.end());
+
+    ////////////////////////////
+    // Comparación de modelos //
+    ////////////////////////////
+
+    AnomalyDetector detector(*this);  // Misma configuración, sin mensajes de cronometraje por cada modelo
+    detector.chrono = false;
+    std::vector<std::unique_ptr<AnomalyReport>> results(candidates.size());
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t k = 0; k < candidates.size(); ++k) {
+        results[k] = std::make_unique<AnomalyReport>(detector.compare(obj, *candidates[k].second));
+    }
+
+    // Orden por similitud, número de anomalías y distancia entre bounding boxes
+    std::vector<double> distances(results.size());
+    for (size_t k = 0; k < results.size(); ++k) {
+        distances[k] = reportDistance(*results[k]);
+    }
+    std::vector<size_t> order(results.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&results, &distances](size_t a, size_t b) {
+        if (results[a]->similar != results[b]->similar) {
+            return results[a]->similar;
+        }
+        if (results[a]->totalAnomalies != results[b]->totalAnomalies) {
+            return results[a]->totalAnomalies < results[b]->totalAnomalies;
+        }
+        return distances[a] < distances[b];
+    });
+
+    std::vector<std::string> ranked;
+    std::vector<AnomalyReport> reports;
+    for (size_t k : order) {
+        ranked.push_back(candidates[k].first);
+        reports.push_back(*results[k]);
+    }
+
+    if (chrono) {
+        end = std::chrono::high_resolution_clock::now();
+
+        double duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / 1.e9;
+
+        CLI_STDOUT("Classification against " << models.size() << " models (" << pruned.size() << " pruned) lasted " << std::setprecision(6) << duration << std::setprecision(2) << " s");
+    }
+
+    return ClassificationReport(ranked, reports, pruned);
+}
@@ -0,0 +1,180 @@
+/**
+ * @file ModelIndex.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del objeto ModelIndex
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cmath>
+
+#include "anomaly_detection/ModelIndex.hh"
+#include "object_characterization/CharacterizedObject.hh"
+#include "object_characterization/Face.hh"
+#include "app/config.h"
+
+// Distancia euclídea al cuadrado entre dos descriptores
+static double squaredDistance(const ModelIndex::Descriptor &a, const ModelIndex::Descriptor &b) {
+    double d = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        d += (a[i] - b[i]) * (a[i] - b[i]);
+    }
+    return d;
+}
+
+ModelIndex::Descriptor ModelIndex::describe(const CharacterizedObject &object) {
+    Descriptor descriptor{};
+
+    // Dimensiones de la bounding box de mayor a menor, independientes de su orientación
+    const Vector &delta = object.getBBox().getDelta();
+    std::array<double, 3> dims = {delta.getX(), delta.getY(), delta.getZ()};
+    std::sort(dims.begin(), dims.end(), std::greater<double>());
+    descriptor[0] = dims[0];
+    descriptor[1] = dims[1];
+    descriptor[2] = dims[2];
+
+    descriptor[3] = object.getFaces().size() * MODEL_INDEX_FACE_WEIGHT;
+
+    // Histograma de áreas de las caras, aproximadas por los dos lados mayores de su bounding box
+    for (const Face &f : object.getFaces()) {
+        const Vector &fdelta = f.getMinBBox().getDelta();
+        std::array<double, 3> fdims = {fdelta.getX(), fdelta.getY(), fdelta.getZ()};
+        std::sort(fdims.begin(), fdims.end(), std::greater<double>());
+        const double area = fdims[0] * fdims[1];
+
+        size_t bin = 0;
+        if (area > MODEL_INDEX_MIN_FACE_AREA) {
+            bin = std::min<size_t>(MODEL_INDEX_HISTOGRAM_BINS - 1, 1 + static_cast<size_t>(std::log(area / MODEL_INDEX_MIN_FACE_AREA) / std::log(4.)));
+        }
+        descriptor[4 + bin] += MODEL_INDEX_HISTOGRAM_WEIGHT;
+    }
+
+    return descriptor;
+}
+
+void ModelIndex::insert(const std::string &name, const Descriptor &descriptor) {
+    const size_t entry = names.size();
+    names.push_back(name);
+    descriptors.push_back(descriptor);
+    left.push_back(kNone);
+    right.push_back(kNone);
+    axis.push_back(0);
+
+    if (root == kNone) {
+        root = entry;
+        return;
+    }
+
+    // Descenso hasta la hoja correspondiente. Los empates se reparten entre ambos lados según un bit distinto del índice
+    // del modelo en cada nivel, de forma que muchos descriptores iguales no forman una cadena
+    size_t node = root, levels = 1;
+    while (true) {
+        const double value = descriptor[axis[node]], pivot = descriptors[node][axis[node]];
+        const bool goLeft = value < pivot || (value == pivot && ((entry >> ((levels - 1) % 64)) & 1));
+        ++levels;
+        std::vector<size_t> &child = goLeft ? left : right;
+        if (child[node] == kNone) {
+            child[node] = entry;
+            axis[entry] = (axis[node] + 1) % kDimensions;
+            break;
+        }
+        node = child[node];
+    }
+
+    // Reconstrucción si el árbol deja de estar aproximadamente equilibrado
+    if (levels > 2 * std::log2(static_cast<double>(names.size())) + 2) {
+        rebuild();
+    }
+}
+
+std::vector<std::pair<std::string, double>> ModelIndex::nearest(const Descriptor &descriptor, size_t k) const {
+    std::priority_queue<std::pair<double, size_t>> best;  // Mejores candidatos, con el más lejano en la cima
+
+    // Búsqueda con poda de las ramas más lejanas que el peor candidato
+    std::function<void(size_t)> search = [&](size_t node) {
+        if (node == kNone) {
+            return;
+        }
+
+        const double d = squaredDistance(descriptor, descriptors[node]);
+        if (best.size() < k) {
+            best.push({d, node});
+        } else if (d < best.top().first) {
+            best.pop();
+            best.push({d, node});
+        }
+
+        const double diff = descriptor[axis[node]] - descriptors[node][axis[node]];
+        const size_t near = diff < 0 ? left[node] : right[node];
+        const size_t far = diff < 0 ? right[node] : left[node];
+        search(near);
+        if (best.size() < k || diff * diff < best.top().first) {
+            search(far);
+        }
+    };
+    if (k > 0) {
+        search(root);
+    }
+
+    std::vector<std::pair<std::string, double>> result(best.size());
+    for (size_t i = best.size(); i > 0; --i) {
+        result[i - 1] = {names[best.top().second], std::sqrt(best.top().first)};
+        best.pop();
+    }
+    return result;
+}
+
+size_t ModelIndex::depth() const {
+    std::function<size_t(size_t)> levels = [&](size_t node) -> size_t {
+        return node == kNone ? 0 : 1 + std::max(levels(left[node]), levels(right[node]));
+    };
+    return levels(root);
+}
+
+void ModelIndex::rebuild() {
+    std::vector<size_t> entries(names.size());
+    std::iota(entries.begin(), entries.end(), 0);
+    root = build(entries, 0, entries.size());
+}
+
+size_t ModelIndex::build(std::vector<size_t> &entries, size_t begin, size_t end) {
+    if (begin == end) {
+        return kNone;
+    }
+
+    // Componente de mayor dispersión
+    Descriptor lo = descriptors[entries[begin]], hi = lo;
+    for (size_t i = begin + 1; i < end; ++i) {
+        for (size_t c = 0; c < kDimensions; ++c) {
+            lo[c] = std::min(lo[c], descriptors[entries[i]][c]);
+            hi[c] = std::max(hi[c], descriptors[entries[i]][c]);
+        }
+    }
+    size_t split = 0;
+    for (size_t c = 1; c < kDimensions; ++c) {
+        if (hi[c] - lo[c] > hi[split] - lo[split]) {
+            split = c;
+        }
+    }
+
+    // Mediana como raíz del subárbol, desempatando por el índice del modelo para que los valores iguales a ella
+    // se repartan entre ambos lados y el subárbol quede equilibrado aunque todos los descriptores coincidan
+    std::sort(entries.begin() + begin, entries.begin() + end, [&](size_t a, size_t b) {
+        return descriptors[a][split] < descriptors[b][split] || (descriptors[a][split] == descriptors[b][split] && a < b);
+    });
+    const size_t middle = begin + (end - begin) / 2;
+
+    const size_t node = entries[middle];
+    axis[node] = split;
+    left[node] = build(entries, begin, middle);
+    right[node] = build(entries, middle + 1, end);
+    return node;
+}
@@ -83,6 +83,7 @@ void printHelp(CLICommandType ct) {
             CLI_STDOUT("                   Definition and characterization of objects and background:");
             CLI_STDOUT("  - background                    Defines the background");
             CLI_STDOUT("  - object [name]                 Defines an object with a specified name or an automatic generated one");
+            CLI_STDOUT("  - objects [prefix]              Defines every object in the scene, named with a prefix and an index or automatically");
             if (doBreak) {
                 break;
             }
@@ -118,6 +119,7 @@ void printHelp(CLICommandType ct) {
             CLI_STDOUT("  - load <name> <file>            Loads the contents of a file as a new object with the given name");
             CLI_STDOUT("  - save <name> <file>            Saves the object with the given name into a file");
             CLI_STDOUT("  - csv <name> <file>             Saves the object with the given name into a file in csv format");
+            CLI_STDOUT("  - convert <file> <new_file>     Converts an object file into the current file format");
             if (doBreak) {
                 break;
             }
@@ -132,6 +134,7 @@ void printHelp(CLICommandType ct) {
             CLI_STDOUT("  - load <name> <file>            Loads the contents of a file as a new model with the given name");
             CLI_STDOUT("  - save <name> <file>            Saves the model with the given name into a file");
             CLI_STDOUT("  - csv <name> <file>             Saves the model with the given name into a file in csv format");
+            CLI_STDOUT("  - convert <file> <new_file>     Converts a model file into the current file format");
             if (doBreak) {
                 break;
             }
@@ -161,6 +164,8 @@ void printHelp(CLICommandType ct) {
         case kAnalyze: {
             CLI_STDOUT_NO_NL(bold("analyze <object> <model>"));
             CLI_STDOUT("       Analizes the diferences between the specified object and model");
+            CLI_STDOUT_NO_NL(bold("analyze <object> *"));
+            CLI_STDOUT("             Compares the specified object against every model and ranks them by similarity");
             if (doBreak) {
                 break;
             }
@@ -237,9 +242,9 @@ void CLI::cli() {
                     if (obj.first) {
                         std::pair<bool, std::string> p;
                         if (command.numParams() == 2) {
-                            p = {om->newObject(command[1], obj.second), command[1]};
+                            p = {om->newObject(command[1], std::move(obj.second)), command[1]};
                         } else {
-                            p = om->newObject(obj.second);
+                            p = om->newObject(std::move(obj.second));
                         }
 
                         if (p.first) {
@@ -251,6 +256,30 @@ void CLI::cli() {
                         CLI_STDERR("Scanned object points are too sparse to correctly define an object");
                     }
 
+                } else if (command[0] == "objects" && command.numParams() <= 2) {
+                    CLI_STDOUT("Starting multiple object definition");
+                    std::vector<CharacterizedObject> objs = oc->defineObjects();
+
+                    if (objs.size() > 0) {
+                        for (size_t i = 0; i < objs.size(); ++i) {
+                            std::pair<bool, std::string> p;
+                            if (command.numParams() == 2) {
+                                std::string name = command[1] + "-" + std::to_string(i);
+                                p = {om->newObject(name, std::move(objs[i])), name};
+                            } else {
+                                p = om->newObject(std::move(objs[i]));
+                            }
+
+                            if (p.first) {
+                                CLI_STDOUT("Object " << p.second << " created");
+                            } else {
+                                CLI_STDERR("Could not create object " << p.second);
+                            }
+                        }
+                    } else {
+                        CLI_STDERR("Scanned points are too sparse to correctly define any object");
+                    }
+
                 } else {
                     unknownCommand("define");
                 }
@@ -336,6 +365,12 @@ void CLI::cli() {
                         } else {
                             CLI_STDERR("Could not save object " << command[1] << " into csv file " << command[2]);
                         }
+                    } else if (command[0] == "convert") {
+                        if (CharacterizedObject::convert(command[1], command[2])) {
+                            CLI_STDOUT("Object file " << command[1] << " converted into file " << command[2]);
+                        } else {
+                            CLI_STDERR("Could not convert object file " << command[1] << " into file " << command[2]);
+                        }
                     } else {
                         unknownCommand("object");
                     }
@@ -351,7 +386,7 @@ void CLI::cli() {
                         CLI_STDOUT("  Depth  / x_delta: " << co.getBBox().getDeltaX());
                         CLI_STDOUT("  Normal vectors:");
                         for (auto &f : co.getFaces()) {
-                            CLI_STDOUT("    [" << f.getNormal() << "]");
+                            CLI_STDOUT("    [" << f.getNormal() << "]  plane RMS " << f.getPlaneRMS() << "mm, max " << f.getPlaneMaxResidual() << "mm");
                         }
                     } else {
                         CLI_STDERR("Could not locate object " << command[1]);
@@ -382,6 +417,12 @@ void CLI::cli() {
                         } else {
                             CLI_STDERR("Could not load model " << command[1] << " from file " << command[2]);
                         }
+                    } else if (command[0] == "convert") {
+                        if (Model::convert(command[1], command[2])) {
+                            CLI_STDOUT("Model file " << command[1] << " converted into file " << command[2]);
+                        } else {
+                            CLI_STDERR("Could not convert model file " << command[1] << " into file " << command[2]);
+                        }
                     } else {
                         unknownCommand("model");
                     }
@@ -397,7 +438,7 @@ void CLI::cli() {
                         CLI_STDOUT("  Depth  / x_delta: " << m.getBBox().getDeltaX());
                         CLI_STDOUT("  Normal vectors:");
                         for (auto &f : m.getFaces()) {
-                            CLI_STDOUT("    [" << f.getNormal() << "]");
+                            CLI_STDOUT("    [" << f.getNormal() << "]  plane RMS " << f.getPlaneRMS() << "mm, max " << f.getPlaneMaxResidual() << "mm");
                         }
                     } else {
                         CLI_STDERR("Could not locate model " << command[1]);
@@ -447,7 +488,37 @@ void CLI::cli() {
 
             // ANALYZE
             case kAnalyze: {
-                if (command.numParams() == 2) {
+                if (command.numParams() == 2 && command[1] == "*") {
+                    if (om->existsObject(command[0])) {
+                        const CharacterizedObject &object = om->getObjects().at(command[0]);
+
+                        // Candidatos con el descriptor de forma más cercano al del objeto
+                        std::vector<std::pair<std::string, const Model *>> candidates;
+                        for (const std::pair<std::string, double> &c : om->getModelIndex().nearest(object, MODEL_INDEX_CANDIDATES)) {
+                            candidates.push_back({c.first, &om->getModels().at(c.first)});
+                        }
+                        ClassificationReport cr = ad->classify(object, candidates);
+
+                        CLI_STDOUT("-------------------- CLASSIFICATION REPORT ---------------------");
+                        CLI_STDOUT(" Candidate models: " << candidates.size() << " of " << om->getModels().size() << " (closest shape descriptors)");
+                        CLI_STDOUT(" Compared models: " << cr.models.size() << " (" << cr.pruned.size() << " discarded by bounding box or number of faces)");
+                        for (size_t i = 0; i < cr.models.size(); ++i) {
+                            const AnomalyReport &ar = cr.reports[i];
+                            Vector delta = ar.generalComparison.deltas;
+                            CLI_STDOUT(" " << i + 1 << ". " << cr.models[i] << ": " << (ar.similar ? "SIMILAR" : "DIFFERENT")
+                                           << ", " << ar.totalAnomalies << " anomalies, BoundBox(model) - BoundBox(object) = ["
+                                           << (int)delta.getX() << "mm, " << (int)delta.getY() << "mm, " << (int)delta.getZ() << "mm]");
+                        }
+                        if (cr.models.size() > 0 && cr.reports[0].similar) {
+                            CLI_STDOUT(bold(" In summary, the given object is classified as " << cr.models[0] << ""));
+                        } else {
+                            CLI_STDOUT(bold(" In summary, the given object is not SIMILAR to any model"));
+                        }
+                        CLI_STDOUT("----------------------------------------------------------------");
+                    } else {
+                        CLI_STDERR("Could not locate object " << command[0]);
+                    }
+                } else if (command.numParams() == 2) {
                     if (om->existsObject(command[0])) {
                         if (om->existsModel(command[1])) {
                             const CharacterizedObject &object = om->getObjects().at(command[0]);
@@ -508,6 +579,8 @@ void CLI::cli() {
                                 CLI_STDOUT(" BBox(fmodel) - BBox(fobject) = [" << (int)delta.getX() << "mm, "
                                                                                << (int)delta.getY() << "mm, "
                                                                                << (int)delta.getZ() << "mm]");
+                                CLI_STDOUT(" PlaneRMS(fobject) - PlaneRMS(fmodel) = " << fc.deltaRMS << "mm");
+                                CLI_STDOUT(" PlaneMax(fobject) - PlaneMax(fmodel) = " << fc.deltaMax << "mm" << (fc.flat ? "" : " (face is warped or dented)"));
                                 CLI_STDOUT(bold(" Both faces are " << (fc.similar ? "similar" : "different") << ""));
                             }
                             // Unmatched faces
@@ -524,6 +597,27 @@ void CLI::cli() {
                                 }
                                 CLI_STDOUT(bold(" There is a total of " << (ar.deltaFaces < 0 ? -ar.deltaFaces : ar.deltaFaces) << " unmatched faces"));
                             }
+                            // Surface deviations
+                            if (ar.deviation.computed) {
+                                CLI_STDOUT("\n // SURFACE DEVIATIONS //");
+                                CLI_STDOUT(" Registration " << (ar.deviation.converged ? "converged" : "did not converge") << " after " << ar.deviation.iterations << " iterations");
+                                CLI_STDOUT(" RMS deviation = " << ar.deviation.rms << "mm");
+                                CLI_STDOUT(" Max deviation = " << ar.deviation.max << "mm");
+                                CLI_STDOUT(" " << (int)(DEVIATION_PERCENTILE * 100) << "th percentile deviation = " << ar.deviation.percentile << "mm");
+                                CLI_STDOUT(" Points deviating more than " << DEVIATION_THRESHOLD << "mm = " << ar.deviation.outliers << " of " << ar.deviation.deviations.size());
+                                CLI_STDOUT(bold(" Object surface is " << (ar.deviation.similar ? "similar" : "different") << " to the model surface"));
+                            }
+                            // Surface distances
+                            if (ar.distance.computed) {
+                                CLI_STDOUT("\n // SURFACE DISTANCES //");
+                                if (ar.distance.exceeded) {
+                                    CLI_STDOUT(" Hausdorff distance (object to model) > " << HAUSDORFF_THRESHOLD << "mm (computation stopped at " << ar.distance.directedHausdorff << "mm)");
+                                } else {
+                                    CLI_STDOUT(" Chamfer distance   = " << ar.distance.chamfer << "mm (object to model = " << ar.distance.directedChamfer << "mm)");
+                                    CLI_STDOUT(" Hausdorff distance = " << ar.distance.hausdorff << "mm (object to model = " << ar.distance.directedHausdorff << "mm)");
+                                }
+                                CLI_STDOUT(bold(" Object and model point sets are " << (ar.distance.similar ? "similar" : "different") << ""));
+                            }
                             // Conclusion
                             CLI_STDOUT("\n // CONCLUSION //");
                             if (ar.deltaFaces > 0) {
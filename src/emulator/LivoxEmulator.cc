@@ -0,0 +1,427 @@
+/**
+ * @file LivoxEmulator.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del objeto LivoxEmulator
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "livox_def.h"
+#include "lvx_file.h"
+#include "lds.h"
+
+#include "emulator/LivoxEmulator.hh"
+
+#include "logging/debug.hh"
+
+/* Protocolo de comandos del Livox SDK 2.3 */
+#define SDK_SOF             0xAA        ///< Byte de inicio de paquete
+#define SDK_VERSION         1           ///< Versión del protocolo
+#define SDK_PREAMBLE_SIZE   7           ///< Bytes del preámbulo sin su CRC16
+#define SDK_HEADER_SIZE     9           ///< Bytes del preámbulo con su CRC16
+#define SDK_CRC32_SIZE      4           ///< Bytes del CRC32 final
+#define SDK_CRC16_SEED      0x4c49      ///< Semilla del CRC16 del preámbulo
+#define SDK_CRC32_SEED      0x564f580a  ///< Semilla del CRC32 del paquete
+
+/* Tipos de paquete */
+#define SDK_PACKET_CMD 0x00  ///< Comando
+#define SDK_PACKET_ACK 0x01  ///< Respuesta a un comando
+#define SDK_PACKET_MSG 0x02  ///< Mensaje
+
+/* Comandos */
+#define SDK_SET_GENERAL          0x00  ///< Conjunto de comandos generales
+#define SDK_SET_LIDAR            0x01  ///< Conjunto de comandos del LiDAR
+#define SDK_CMD_BROADCAST        0x00  ///< Mensaje de broadcast
+#define SDK_CMD_HANDSHAKE        0x01  ///< Handshake
+#define SDK_CMD_DEVICE_INFO      0x02  ///< Petición de información del sensor
+#define SDK_CMD_HEARTBEAT        0x03  ///< Heartbeat
+#define SDK_CMD_SAMPLING         0x04  ///< Comienzo/fin del muestreo
+#define SDK_CMD_DISCONNECT       0x06  ///< Desconexión
+
+/* Utilidades */
+// CRC16 MCRF4XX (polinomio 0x1021 reflejado) utilizado en el preámbulo
+static uint16_t crc16(const uint8_t *data, size_t length) {
+    uint16_t crc = SDK_CRC16_SEED;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+// CRC32 (polinomio 0x04C11DB7 reflejado) utilizado en el paquete completo
+static uint32_t crc32(const uint8_t *data, size_t length) {
+    uint32_t crc = SDK_CRC32_SEED;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+// Escribe un entero de 16 bits en Little Endian
+static inline void putU16(uint8_t *dst, uint16_t v) {
+    dst[0] = v & 0xFF;
+    dst[1] = (v >> 8) & 0xFF;
+}
+
+// Escribe un entero de 32 bits en Little Endian
+static inline void putU32(uint8_t *dst, uint32_t v) {
+    for (int i = 0; i < 4; ++i) dst[i] = (v >> (8 * i)) & 0xFF;
+}
+
+// Lee un entero de 16 bits en Little Endian
+static inline uint16_t getU16(const uint8_t *src) { return src[0] | (src[1] << 8); }
+
+// Lee un entero de 32 bits en Little Endian
+static inline uint32_t getU32(const uint8_t *src) { return src[0] | (src[1] << 8) | (src[2] << 16) | ((uint32_t)src[3] << 24); }
+
+// Milisegundos de reloj monótono
+static inline int64_t nowMillis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Construye un paquete del protocolo de comandos
+static std::vector<uint8_t> buildPacket(uint8_t type, uint16_t seq, uint8_t cmdSet, uint8_t cmdId, const std::vector<uint8_t> &payload) {
+    std::vector<uint8_t> packet(SDK_HEADER_SIZE + 2 + payload.size() + SDK_CRC32_SIZE);
+
+    packet[0] = SDK_SOF;
+    packet[1] = SDK_VERSION;
+    putU16(&packet[2], packet.size());
+    packet[4] = type;
+    putU16(&packet[5], seq);
+    putU16(&packet[7], crc16(packet.data(), SDK_PREAMBLE_SIZE));
+    packet[9] = cmdSet;
+    packet[10] = cmdId;
+    std::copy(payload.begin(), payload.end(), packet.begin() + SDK_HEADER_SIZE + 2);
+    putU32(&packet[packet.size() - SDK_CRC32_SIZE], crc32(packet.data(), packet.size() - SDK_CRC32_SIZE));
+
+    return packet;
+}
+
+LivoxEmulator::LivoxEmulator(const std::string &filename, const char code[kBroadcastCodeSize], double packetRate, bool loop, const std::string &hostIp)
+    : filename(filename),
+      hostIp(hostIp),
+      loop(loop),
+      packetSize(0),
+      pointsPerPacket(0),
+      cmdSocket(-1),
+      dataSocket(-1),
+      broadcastSeq(0),
+      packetRate(packetRate),
+      running(false),
+      connected(false),
+      sampling(false),
+      lastCommand(0),
+      sentPackets(0),
+      sentPoints(0) {
+    strncpy(broadcastCode, code, kBroadcastCodeSize - 1);
+    broadcastCode[kBroadcastCodeSize - 1] = '\0';
+    memset(&dataAddress, 0, sizeof(dataAddress));
+}
+
+LivoxEmulator::~LivoxEmulator() { stop(); }
+
+bool LivoxEmulator::init() {
+    DEBUG_STDOUT("Initializing LIVOX emulator");
+
+    if (!loadPackets()) {
+        DEBUG_STDERR("No cartesian point packets found in " << filename);
+        return false;
+    }
+
+    cmdSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    dataSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (cmdSocket < 0 || dataSocket < 0) {
+        DEBUG_STDERR("Unable to open emulator sockets");
+        stop();
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(cmdSocket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    setsockopt(cmdSocket, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable));
+
+    // El sensor atiende los comandos del SDK en un puerto fijo
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(LIVOX_COMMAND_PORT);
+    if (bind(cmdSocket, (sockaddr *)&address, sizeof(address)) < 0) {
+        DEBUG_STDERR("Unable to bind emulator command port " << LIVOX_COMMAND_PORT);
+        stop();
+        return false;
+    }
+
+    DEBUG_STDOUT("Initialized LIVOX emulator with " << getLoadedPackets() << " point packets");
+
+    return true;
+}
+
+bool LivoxEmulator::start() {
+    if (running || cmdSocket < 0) {
+        return false;
+    }
+
+    running = true;
+    broadcastThread = std::thread(&LivoxEmulator::broadcastLoop, this);
+    commandThread = std::thread(&LivoxEmulator::commandLoop, this);
+    dataThread = std::thread(&LivoxEmulator::dataLoop, this);
+
+    return true;
+}
+
+void LivoxEmulator::stop() {
+    running = false;
+    connected = false;
+    sampling = false;
+
+    if (broadcastThread.joinable()) broadcastThread.join();
+    if (commandThread.joinable()) commandThread.join();
+    if (dataThread.joinable()) dataThread.join();
+
+    if (cmdSocket >= 0) close(cmdSocket);
+    if (dataSocket >= 0) close(dataSocket);
+    cmdSocket = dataSocket = -1;
+}
+
+bool LivoxEmulator::loadPackets() {
+    livox_ros::LvxFileHandle lvx_file;
+    livox_ros::OutPacketBuffer packets_of_frame;
+
+    if (lvx_file.Open(filename.c_str(), std::ios::in) != livox_ros::kLvxFileOk) {
+        return false;
+    }
+
+    const uint32_t kMaxPacketsNumOfFrame = 8192;
+    packets_of_frame.buffer_capacity = kMaxPacketsNumOfFrame * sizeof(livox_ros::LvxFilePacket);
+    packets_of_frame.packet = new uint8_t[kMaxPacketsNumOfFrame * sizeof(livox_ros::LvxFilePacket)];
+
+    packetSize = livox_ros::GetEthPacketLen(kExtendCartesian);
+    pointsPerPacket = livox_ros::GetPointsPerPacket(kExtendCartesian);
+    packets.clear();
+
+    // Copiamos únicamente los paquetes cartesianos, que son los que trata ScannerLidar
+    while (lvx_file.GetPacketsOfFrame(&packets_of_frame) == livox_ros::kLvxFileOk) {
+        uint32_t frameOffset = 0;
+        while (frameOffset < packets_of_frame.data_size) {
+            LivoxEthPacket *eth_packet;
+            if (lvx_file.GetFileVersion() != 0) {
+                eth_packet = (LivoxEthPacket *)(&((livox_ros::LvxFilePacket *)&packets_of_frame.packet[frameOffset])->version);
+            } else {
+                eth_packet = (LivoxEthPacket *)(&((livox_ros::LvxFilePacketV0 *)&packets_of_frame.packet[frameOffset])->version);
+            }
+
+            if (eth_packet->data_type == kExtendCartesian) {
+                packets.insert(packets.end(), (uint8_t *)eth_packet, (uint8_t *)eth_packet + packetSize);
+            }
+
+            frameOffset += (livox_ros::GetEthPacketLen(eth_packet->data_type) + 1);
+        }
+    }
+
+    lvx_file.CloseLvxFile();
+    delete[] packets_of_frame.packet;
+
+    return !packets.empty();
+}
+
+void LivoxEmulator::broadcastLoop() {
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = inet_addr(hostIp.c_str());
+    address.sin_port = htons(LIVOX_BROADCAST_PORT);
+
+    std::vector<uint8_t> payload(kBroadcastCodeSize + 3, 0);
+    memcpy(payload.data(), broadcastCode, kBroadcastCodeSize);
+    payload[kBroadcastCodeSize] = kDeviceTypeLidarHorizon;
+
+    while (running) {
+        // El SDK deja de enviar heartbeats al desconectarse, por lo que volvemos a anunciar el sensor
+        if (connected && nowMillis() - lastCommand > LIVOX_HEARTBEAT_TIMEOUT) {
+            DEBUG_STDERR("Emulator heartbeat timeout");
+            connected = false;
+            sampling = false;
+        }
+
+        if (!connected) {
+            std::vector<uint8_t> packet = buildPacket(SDK_PACKET_MSG, broadcastSeq++, SDK_SET_GENERAL, SDK_CMD_BROADCAST, payload);
+            sendto(cmdSocket, packet.data(), packet.size(), 0, (sockaddr *)&address, sizeof(address));
+        }
+
+        for (int i = 0; running && i < 10; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+}
+
+void LivoxEmulator::commandLoop() {
+    uint8_t buffer[2048];
+    pollfd pfd = {cmdSocket, POLLIN, 0};
+
+    while (running) {
+        if (poll(&pfd, 1, 100) <= 0) {
+            continue;
+        }
+
+        sockaddr_in sender;
+        socklen_t senderLength = sizeof(sender);
+        ssize_t length = recvfrom(cmdSocket, buffer, sizeof(buffer), 0, (sockaddr *)&sender, &senderLength);
+        if (length > 0) {
+            handleCommand(buffer, length, sender);
+        }
+    }
+}
+
+void LivoxEmulator::handleCommand(const uint8_t *buffer, size_t length, const sockaddr_in &sender) {
+    // Validación del paquete
+    if (length < SDK_HEADER_SIZE + 2 + SDK_CRC32_SIZE || buffer[0] != SDK_SOF || getU16(&buffer[2]) != length ||
+        getU16(&buffer[7]) != crc16(buffer, SDK_PREAMBLE_SIZE) ||
+        getU32(&buffer[length - SDK_CRC32_SIZE]) != crc32(buffer, length - SDK_CRC32_SIZE)) {
+        DEBUG_STDERR("Emulator received a malformed packet");
+        return;
+    }
+    if (buffer[4] != SDK_PACKET_CMD) {
+        return;
+    }
+
+    const uint16_t seq = getU16(&buffer[5]);
+    const uint8_t cmdSet = buffer[9];
+    const uint8_t cmdId = buffer[10];
+    const uint8_t *data = &buffer[SDK_HEADER_SIZE + 2];
+    const size_t dataLength = length - SDK_HEADER_SIZE - 2 - SDK_CRC32_SIZE;
+
+    std::vector<uint8_t> response = {0};  // ret_code: kStatusSuccess
+
+    lastCommand = nowMillis();
+
+    if (cmdSet == SDK_SET_GENERAL) {
+        switch (cmdId) {
+            case SDK_CMD_HANDSHAKE:
+                // user_ip (4) | data_port (2) | cmd_port (2) | imu_port (2)
+                if (dataLength >= 10) {
+                    std::lock_guard<std::mutex> lock(addressMutex);
+                    dataAddress.sin_family = AF_INET;
+                    dataAddress.sin_addr = sender.sin_addr;
+                    dataAddress.sin_port = htons(getU16(&data[4]));
+                    connected = true;
+
+                    DEBUG_STDOUT("Emulator handshake with " << inet_ntoa(sender.sin_addr) << ":" << getU16(&data[4]));
+                } else {
+                    response[0] = 1;
+                }
+                break;
+
+            case SDK_CMD_DEVICE_INFO:
+                // ret_code | firmware_version (4)
+                response.insert(response.end(), {6, 4, 0, 0});
+                break;
+
+            case SDK_CMD_HEARTBEAT:
+                // ret_code | work_state | feature | error_code (4)
+                response.insert(response.end(), {kLidarStateNormal, 0, 0, 0, 0, 0});
+                break;
+
+            case SDK_CMD_SAMPLING:
+                if (dataLength >= 1) {
+                    sampling = data[0] != 0;
+                    DEBUG_STDOUT("Emulator sampling " << (sampling ? "started" : "stopped"));
+                }
+                break;
+
+            case SDK_CMD_DISCONNECT:
+                connected = false;
+                sampling = false;
+                break;
+
+            default:
+                break;
+        }
+    }
+    // El resto de comandos (coordenadas, frecuencia IMU, ...) se aceptan sin efecto
+
+    std::vector<uint8_t> packet = buildPacket(SDK_PACKET_ACK, seq, cmdSet, cmdId, response);
+    sendto(cmdSocket, packet.data(), packet.size(), 0, (const sockaddr *)&sender, sizeof(sender));
+}
+
+void LivoxEmulator::dataLoop() {
+    std::vector<uint8_t> packet(packetSize);
+    size_t index = 0;
+    const size_t totalPackets = getLoadedPackets();
+
+    double rate = 0;                                   // Frecuencia del periodo de envío actual
+    uint64_t periodPackets = 0;                        // Paquetes enviados en el periodo actual
+    auto periodStart = std::chrono::steady_clock::now();  // Comienzo del periodo de envío actual
+
+    while (running) {
+        // Reiniciamos el periodo de envío al cambiar la frecuencia o al pausar el muestreo
+        if (!connected || !sampling || packetRate <= 0 || rate != packetRate) {
+            rate = packetRate;
+            periodPackets = 0;
+            periodStart = std::chrono::steady_clock::now();
+
+            if (!connected || !sampling || rate <= 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+        }
+
+        // Enviamos los paquetes pendientes según el tiempo transcurrido
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - periodStart).count();
+        uint64_t due = static_cast<uint64_t>(elapsed * rate);
+
+        sockaddr_in address;
+        {
+            std::lock_guard<std::mutex> lock(addressMutex);
+            address = dataAddress;
+        }
+
+        while (periodPackets < due && sampling) {
+            memcpy(packet.data(), &packets[index * packetSize], packetSize);
+
+            // Timestamp de envío para poder medir la latencia en el receptor
+            LivoxEthPacket *eth_packet = (LivoxEthPacket *)packet.data();
+            uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            eth_packet->timestamp_type = kTimestampTypeNoSync;
+            for (int i = 0; i < 8; ++i) eth_packet->timestamp[i] = (ns >> (8 * i)) & 0xFF;
+
+            sendto(dataSocket, packet.data(), packetSize, 0, (sockaddr *)&address, sizeof(address));
+
+            ++periodPackets;
+            ++sentPackets;
+            sentPoints += pointsPerPacket;
+
+            if (++index == totalPackets) {
+                index = 0;
+                if (!loop) {
+                    DEBUG_STDOUT("Emulator reached the end of " << filename);
+                    sampling = false;
+                }
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
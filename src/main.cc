@@ -9,6 +9,10 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <sstream>
 #include <stdlib.h>
 #include <omp.h>
 
@@ -16,6 +20,7 @@
 
 #include "app/CLI.hh"
 #include "app/InputParser.hh"
+#include "scanner/ScannerMerged.hh"
 #include "app/config.h"
 
 #include "logging/debug.hh"
@@ -43,9 +48,10 @@ struct InputParams {
     bool is_ok;     // Variable para comprobar si se ha introducido el input necesario
     int exit_code;  // Exit code to return when is_ok is false
 
-    bool is_lidar;           // Tipo de escanner a usar: true si es mediante lidar
-    std::string filename;    // Nombre del archivo de datos
-    std::string lidar_code;  // Codigo de broadcast del sensor lidar
+    bool is_lidar;                                       // Tipo de escanner a usar: true si es mediante lidar
+    std::string filename;                                // Nombre del archivo de datos
+    std::vector<std::string> lidar_codes;                // Codigos de broadcast de los sensores lidar
+    std::map<std::string, SensorExtrinsic> extrinsics;  // Transformaciones extrínsecas de los sensores lidar
     ChronoMode chrono_mode;  // Tipo de métricas a tomar
     uint32_t obj_frame_t;    // Tiempo que duraran los puntos en el frame
     uint32_t back_frame_t;   // Tiempo en el cual los puntos formarán parte del background
@@ -73,8 +79,10 @@ int main(int argc, char *argv[]) {
     if (pi.is_ok) {
         omp_set_num_threads(pi.num_threads);  // OMP threads
 
-        if (pi.is_lidar) {
-            CLI(pi.lidar_code.c_str(), pi.chrono_mode, pi.obj_frame_t, pi.back_frame_t, pi.min_reflectivity, pi.back_distance);
+        if (pi.is_lidar && pi.lidar_codes.size() == 1 && pi.extrinsics.empty()) {
+            CLI(pi.lidar_codes[0].c_str(), pi.chrono_mode, pi.obj_frame_t, pi.back_frame_t, pi.min_reflectivity, pi.back_distance);
+        } else if (pi.is_lidar) {
+            CLI(pi.lidar_codes, pi.extrinsics, pi.chrono_mode, pi.obj_frame_t, pi.back_frame_t, pi.min_reflectivity, pi.back_distance);
         } else {
             CLI(pi.filename, pi.chrono_mode, pi.obj_frame_t, pi.back_frame_t, pi.min_reflectivity, pi.back_distance);
         }
@@ -101,25 +109,40 @@ void InputParams::parse(int argc, const char **argv) {
     else if (parser.hasParam("-b")) {
         DEBUG_STDOUT("Param <-b> detected");
 
-        std::string option = parser.getParam("-b");
+        const std::string &option = parser.getParam("-b");
         // No se ha proporcionado valor
         if (option.empty()) {
             missusage();
             return;  // Salimos
         }
-        // Valor por defecto
-        else if (option.compare("default") == 0) {
-            option = DEFAULT_BROADCAST_CODE;
+
+        // Lista de códigos separados por comas
+        std::istringstream codes(option);
+        for (std::string code; std::getline(codes, code, ',');) {
+            // Valor por defecto
+            if (code.compare("default") == 0) {
+                code = DEFAULT_BROADCAST_CODE;
+            }
+            // Valor inválido
+            else if (code.empty() || code.length() >= kBroadcastCodeSize || !is_alphanumeric(code)) {
+                missusage();
+                return;  // Salimos
+            }
+            // Código repetido, que correspondería al mismo sensor
+            if (std::find(lidar_codes.begin(), lidar_codes.end(), code) != lidar_codes.end()) {
+                missusage();
+                return;  // Salimos
+            }
+
+            lidar_codes.push_back(code);  // Código de broadcast
         }
-        // Valor inválido
-        else if (option.length() >= kBroadcastCodeSize || !is_alphanumeric(option)) {
+        if (lidar_codes.empty()) {
             missusage();
             return;  // Salimos
         }
 
-        is_ok = true;         // Input correcto
-        is_lidar = true;      // Sensor lidar
-        lidar_code = option;  // Código de broadcast
+        is_ok = true;     // Input correcto
+        is_lidar = true;  // Sensor lidar
 
         DEBUG_STDOUT("Value of <-b> is " << option);
     }
@@ -151,6 +174,20 @@ void InputParams::parse(int argc, const char **argv) {
         return;  // Salimos
     }
 
+    /* Transformaciones extrínsecas de los sensores */
+    if (parser.hasParam("-e")) {
+        DEBUG_STDOUT("Param <-e> detected");
+
+        const std::string &option = parser.getParam("-e");
+        // No se ha proporcionado valor o archivo inválido
+        if (option.empty() || !is_lidar || !ScannerMerged::readExtrinsics(option, extrinsics)) {
+            missusage();
+            return;  // Salimos
+        }
+
+        DEBUG_STDOUT("Value of <-e> is " << option);
+    }
+
     /* Duración del frame */
     if (parser.hasParam("-t")) {
         DEBUG_STDOUT("Param <-t> detected");
@@ -338,7 +375,7 @@ void InputParams::parse(int argc, const char **argv) {
 void InputParams::usage() const {
     std::cout << std::endl
               << "Usage:" << std::endl
-              << exec_name << " <-b lidar_code | -f filename> [-t obj_frame_t] [-c chrono_mode] [-g back_frame_t] [-r reflectivity_threshold] [-d distance_threshold] [-j threads]" << std::endl
+              << exec_name << " <-b lidar_code[,lidar_code...] | -f filename> [-e extrinsics_file] [-t obj_frame_t] [-c chrono_mode] [-g back_frame_t] [-r reflectivity_threshold] [-d distance_threshold] [-j threads]" << std::endl
               << exec_name << " <-h | --help>" << std::endl
               << std::endl;
 }
@@ -347,7 +384,9 @@ void InputParams::usage() const {
 void InputParams::help() const {
     usage();  // Imprimimos usage
     std::cout << "\t -b                Broadcast code of the lidar sensor composed of " << kBroadcastCodeSize - 1 << " symbols maximum. With 'default' as value it defaults to " << DEFAULT_BROADCAST_CODE << std::endl
+              << "\t                   Several comma separated codes merge the points of all the sensors by timestamp. Each code may appear only once" << std::endl
               << "\t -f                File with the 3D points to get the data from" << std::endl
+              << "\t -e                File with the extrinsics of each lidar sensor, one per line as 'code rx ry rz tx ty tz' (degrees, mm)" << std::endl
               << "\t -t                Miliseconds to use as frame duration time. Defaults to " << DEFAULT_OBJECT_FRAME_T << "ms" << std::endl
               << "\t -c                Type of chronometer to set up and measure time from. Defaults to notime" << std::endl
               << "\t                       notime - No chrono set" << std::endl
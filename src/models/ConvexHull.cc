@@ -0,0 +1,308 @@
+/**
+ * @file ConvexHull.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del objeto ConvexHull
+ *
+ */
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <cstdint>
+
+#include "models/ConvexHull.hh"
+#include "models/Point.hh"
+#include "models/PointCloud.hh"
+
+using Vec3 = std::array<double, 3>;
+
+/**
+ * Cara triangular de la envolvente en construcción
+ */
+struct HullFace {
+    size_t v[3];                  ///< Vértices en orden antihorario visto desde el exterior
+    Vec3 normal;                  ///< Normal exterior unitaria
+    double offset;                ///< Distancia del plano de la cara al origen
+    std::vector<size_t> outside;  ///< Puntos por encima de la cara aún no procesados
+    bool alive;                   ///< La cara pertenece a la envolvente actual
+};
+
+static inline Vec3 sub(const Vec3 &a, const Vec3 &b) { return {a[0] - b[0], a[1] - b[1], a[2] - b[2]}; }
+static inline double dot(const Vec3 &a, const Vec3 &b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+static inline Vec3 cross(const Vec3 &a, const Vec3 &b) { return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]}; }
+
+// Crea una cara con su plano a partir de tres vértices
+static HullFace makeFace(const std::vector<Vec3> &p, size_t a, size_t b, size_t c) {
+    HullFace f;
+    f.v[0] = a;
+    f.v[1] = b;
+    f.v[2] = c;
+    f.normal = cross(sub(p[b], p[a]), sub(p[c], p[a]));
+    const double len = std::sqrt(dot(f.normal, f.normal));
+    if (len > 0) {
+        f.normal = {f.normal[0] / len, f.normal[1] / len, f.normal[2] / len};
+    }
+    f.offset = dot(f.normal, p[a]);
+    f.alive = true;
+    return f;
+}
+
+// Distancia con signo de un punto al plano de una cara
+static inline double distance(const HullFace &f, const Vec3 &p) { return dot(f.normal, p) - f.offset; }
+
+ConvexHull::ConvexHull(const PointCloudView &points) : degenerate(true) {
+    std::vector<Point> copy(points.begin(), points.end());
+    build(copy);
+}
+
+ConvexHull::ConvexHull(const std::vector<Point> &points) : degenerate(true) {
+    build(points);
+}
+
+void ConvexHull::update(const PointCloudView &points) {
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        vertices[v] = points[indices[v]];
+    }
+    for (size_t f = 0; f < faces.size(); ++f) {
+        const Point &a = vertices[faces[f][0]], &b = vertices[faces[f][1]], &c = vertices[faces[f][2]];
+        Vector n = (b - a).crossProduct(c - a);
+        if (n.module() > 0) {
+            normals[f] = n / n.module();
+        }
+    }
+}
+
+void ConvexHull::build(const std::vector<Point> &points) {
+    const size_t n = points.size();
+
+    // Salida degenerada: todos los puntos como vértices
+    auto fallback = [&]() {
+        vertices = points;
+        indices.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            indices[i] = i;
+        }
+        faces.clear();
+        normals.clear();
+        degenerate = true;
+    };
+
+    if (n < 4) {
+        fallback();
+        return;
+    }
+
+    std::vector<Vec3> p(n);
+    Vec3 lo = {points[0].getX(), points[0].getY(), points[0].getZ()}, hi = lo;
+    size_t ilo[3] = {0, 0, 0}, ihi[3] = {0, 0, 0};
+    for (size_t i = 0; i < n; ++i) {
+        p[i] = {points[i].getX(), points[i].getY(), points[i].getZ()};
+        for (int k = 0; k < 3; ++k) {
+            if (p[i][k] < lo[k]) {
+                lo[k] = p[i][k];
+                ilo[k] = i;
+            }
+            if (p[i][k] > hi[k]) {
+                hi[k] = p[i][k];
+                ihi[k] = i;
+            }
+        }
+    }
+
+    // Tolerancia relativa a la extensión de los puntos
+    int axis = 0;
+    for (int k = 1; k < 3; ++k) {
+        if (hi[k] - lo[k] > hi[axis] - lo[axis]) {
+            axis = k;
+        }
+    }
+    const double eps = (hi[axis] - lo[axis]) * 1e-9;
+    if (hi[axis] - lo[axis] <= 0) {
+        fallback();
+        return;
+    }
+
+    ////// Tetraedro inicial
+    const size_t i0 = ilo[axis], i1 = ihi[axis];
+    const Vec3 dir = sub(p[i1], p[i0]);
+
+    size_t i2 = i0;
+    double best = 0;
+    for (size_t i = 0; i < n; ++i) {
+        Vec3 c = cross(dir, sub(p[i], p[i0]));
+        double d = dot(c, c);
+        if (d > best) {
+            best = d;
+            i2 = i;
+        }
+    }
+    if (std::sqrt(best) / std::sqrt(dot(dir, dir)) <= eps) {
+        fallback();  // Puntos colineales
+        return;
+    }
+
+    HullFace base = makeFace(p, i0, i1, i2);
+    size_t i3 = i0;
+    best = 0;
+    for (size_t i = 0; i < n; ++i) {
+        double d = std::fabs(distance(base, p[i]));
+        if (d > best) {
+            best = d;
+            i3 = i;
+        }
+    }
+    if (best <= eps) {
+        fallback();  // Puntos coplanares
+        return;
+    }
+
+    std::vector<HullFace> hull;
+    const Vec3 inner = {(p[i0][0] + p[i1][0] + p[i2][0] + p[i3][0]) / 4, (p[i0][1] + p[i1][1] + p[i2][1] + p[i3][1]) / 4, (p[i0][2] + p[i1][2] + p[i2][2] + p[i3][2]) / 4};
+    const size_t simplex[4][3] = {{i0, i1, i2}, {i0, i3, i1}, {i1, i3, i2}, {i2, i3, i0}};
+    for (const auto &s : simplex) {
+        HullFace f = makeFace(p, s[0], s[1], s[2]);
+        // Orientación hacia el exterior
+        if (distance(f, inner) > 0) {
+            f = makeFace(p, s[0], s[2], s[1]);
+        }
+        hull.push_back(f);
+    }
+
+    // Cara a la que pertenece cada arista dirigida
+    std::unordered_map<uint64_t, size_t> edges;
+    auto edgeKey = [n](size_t a, size_t b) -> uint64_t { return uint64_t(a) * n + b; };
+    for (size_t f = 0; f < hull.size(); ++f) {
+        for (int e = 0; e < 3; ++e) {
+            edges[edgeKey(hull[f].v[e], hull[f].v[(e + 1) % 3])] = f;
+        }
+    }
+
+    // Asignación de los puntos exteriores a la primera cara sobre la que se encuentran
+    for (size_t i = 0; i < n; ++i) {
+        if (i == i0 || i == i1 || i == i2 || i == i3) {
+            continue;
+        }
+        for (HullFace &f : hull) {
+            if (distance(f, p[i]) > eps) {
+                f.outside.push_back(i);
+                break;
+            }
+        }
+    }
+
+    ////// Expansión de la envolvente
+    std::vector<size_t> stamp;  // Última iteración en la que cada cara fue marcada como visible
+    std::vector<size_t> visible, orphans, created;
+    std::vector<std::pair<size_t, size_t>> horizon;
+
+    for (size_t f = 0, iteration = 1; f < hull.size(); ++f) {
+        if (!hull[f].alive || hull[f].outside.empty()) {
+            continue;
+        }
+
+        // Punto más alejado de la cara
+        size_t eye = hull[f].outside[0];
+        double far = distance(hull[f], p[eye]);
+        for (size_t i : hull[f].outside) {
+            double d = distance(hull[f], p[i]);
+            if (d > far) {
+                far = d;
+                eye = i;
+            }
+        }
+
+        // Caras visibles desde el punto y aristas del horizonte
+        stamp.resize(hull.size(), 0);
+        visible.assign(1, f);
+        horizon.clear();
+        stamp[f] = iteration;
+        for (size_t k = 0; k < visible.size(); ++k) {
+            const HullFace &vf = hull[visible[k]];
+            for (int e = 0; e < 3; ++e) {
+                const size_t a = vf.v[e], b = vf.v[(e + 1) % 3];
+                auto it = edges.find(edgeKey(b, a));
+                if (it == edges.end()) {
+                    fallback();  // Topología inconsistente por errores numéricos
+                    return;
+                }
+                const size_t g = it->second;
+                if (stamp[g] == iteration) {
+                    continue;
+                }
+                if (distance(hull[g], p[eye]) > eps) {
+                    stamp[g] = iteration;
+                    visible.push_back(g);
+                } else {
+                    horizon.push_back({a, b});
+                }
+            }
+        }
+
+        // Eliminación de las caras visibles
+        orphans.clear();
+        for (size_t v : visible) {
+            HullFace &vf = hull[v];
+            vf.alive = false;
+            orphans.insert(orphans.end(), vf.outside.begin(), vf.outside.end());
+            std::vector<size_t>().swap(vf.outside);
+            for (int e = 0; e < 3; ++e) {
+                edges.erase(edgeKey(vf.v[e], vf.v[(e + 1) % 3]));
+            }
+        }
+
+        // Nuevas caras formadas por el horizonte y el punto
+        created.clear();
+        for (const std::pair<size_t, size_t> &h : horizon) {
+            created.push_back(hull.size());
+            hull.push_back(makeFace(p, h.first, h.second, eye));
+            const HullFace &nf = hull.back();
+            for (int e = 0; e < 3; ++e) {
+                edges[edgeKey(nf.v[e], nf.v[(e + 1) % 3])] = created.back();
+            }
+        }
+
+        // Reasignación de los puntos exteriores de las caras eliminadas
+        for (size_t i : orphans) {
+            if (i == eye) {
+                continue;
+            }
+            for (size_t c : created) {
+                if (distance(hull[c], p[i]) > eps) {
+                    hull[c].outside.push_back(i);
+                    break;
+                }
+            }
+        }
+
+        ++iteration;
+    }
+
+    ////// Resultado
+    std::vector<size_t> remap(n, n);
+    vertices.clear();
+    indices.clear();
+    faces.clear();
+    normals.clear();
+    for (const HullFace &f : hull) {
+        if (!f.alive) {
+            continue;
+        }
+        std::array<size_t, 3> face;
+        for (int e = 0; e < 3; ++e) {
+            if (remap[f.v[e]] == n) {
+                remap[f.v[e]] = vertices.size();
+                vertices.push_back(points[f.v[e]]);
+                indices.push_back(f.v[e]);
+            }
+            face[e] = remap[f.v[e]];
+        }
+        faces.push_back(face);
+        normals.push_back(Vector(f.normal[0], f.normal[1], f.normal[2]));
+    }
+    degenerate = false;
+}
@@ -9,6 +9,14 @@
 
 #include <vector>
 #include <utility>
+#include <tuple>
+#include <limits>
+#include <set>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <cmath>
 #include <omp.h>
 
 #include "armadillo"
@@ -16,6 +24,9 @@
 #include "object_characterization/Face.hh"
 #include "models/Geometry.hh"
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
+#include "models/NeighborGraph.hh"
+#include "models/ConvexHull.hh"
 #include "models/BBox.hh"
 #include "app/config.h"
 
@@ -36,14 +47,14 @@ Point Geometry::computeCentroid(const std::vector<Point> &points) {
     return Point(x, y, z);
 }
 
-Point Geometry::computeCentroid(const std::vector<Point *> &points) {
+Point Geometry::computeCentroid(const PointCloudView &points) {
     double x = 0., y = 0., z = 0.;
     size_t numPoints = points.size();
 
     for (const auto &p : points) {
-        x += p->getX();
-        y += p->getY();
-        z += p->getZ();
+        x += p.getX();
+        y += p.getY();
+        z += p.getZ();
     }
 
     x /= numPoints;
@@ -73,16 +84,15 @@ void Geometry::computeSVD(const std::vector<Point> &points, arma::mat &U, arma::
     arma::svd_econ(U, s, V, P);
 }
 
-void Geometry::computeSVD(const std::vector<Point *> &points, arma::mat &U, arma::vec &s, arma::mat &V) {
+void Geometry::computeSVD(const PointCloudView &points, arma::mat &U, arma::vec &s, arma::mat &V) {
     arma::mat P(3, points.size());
+    const PointCloud &cloud = points.getCloud();
 
-    size_t idx = 0;
-
-    for (const auto &p : points) {
-        P(0, idx) = p->getX();
-        P(1, idx) = p->getY();
-        P(2, idx) = p->getZ();
-        ++idx;
+    for (size_t idx = 0; idx < points.size(); ++idx) {
+        size_t i = points.index(idx);
+        P(0, idx) = cloud.getX(i);
+        P(1, idx) = cloud.getY(i);
+        P(2, idx) = cloud.getZ(i);
     }
 
     arma::vec m = arma::mean(P, 1);
@@ -105,29 +115,167 @@ Vector Geometry::computeNormal(const std::vector<Point> &points) {
     return Vector(vnormal[0], vnormal[1], vnormal[2]);
 }
 
-Vector Geometry::computeNormal(const std::vector<Point *> &points) {
-    arma::vec vnormal(3);
+Vector Geometry::computeNormal(const PointCloudView &points) {
+    // El menor vector singular izquierdo de la matriz de puntos centrada es el menor vector propio de su covarianza
+    double cov[3][3];
+    computeCovariance(points, cov);
 
-    arma::mat U, V;
-    arma::vec s;
-    computeSVD(points, U, s, V);
+    return smallestEigenvector(cov);
+}
 
-    vnormal = U.col(2);
+// Covarianza sin normalizar de count puntos de una nube, obteniendo la posición en la nube de cada uno mediante index
+template <typename Index>
+static void covariance(const PointCloud &cloud, size_t count, Index index, double cov[3][3]) {
+    const float *xs = cloud.xData(), *ys = cloud.yData(), *zs = cloud.zData();
+
+    // Centroide en una primera pasada para evitar la cancelación de los momentos sin centrar
+    double mx = 0., my = 0., mz = 0.;
+    for (size_t idx = 0; idx < count; ++idx) {
+        size_t i = index(idx);
+        mx += xs[i];
+        my += ys[i];
+        mz += zs[i];
+    }
+    mx /= count;
+    my /= count;
+    mz /= count;
+
+    double xx = 0., xy = 0., xz = 0., yy = 0., yz = 0., zz = 0.;
+    for (size_t idx = 0; idx < count; ++idx) {
+        size_t i = index(idx);
+        const double dx = xs[i] - mx, dy = ys[i] - my, dz = zs[i] - mz;
+        xx += dx * dx;
+        xy += dx * dy;
+        xz += dx * dz;
+        yy += dy * dy;
+        yz += dy * dz;
+        zz += dz * dz;
+    }
 
-    return Vector(vnormal[0], vnormal[1], vnormal[2]);
+    cov[0][0] = xx;
+    cov[0][1] = cov[1][0] = xy;
+    cov[0][2] = cov[2][0] = xz;
+    cov[1][1] = yy;
+    cov[1][2] = cov[2][1] = yz;
+    cov[2][2] = zz;
+}
+
+void Geometry::computeCovariance(const PointCloudView &points, double cov[3][3]) {
+    covariance(points.getCloud(), points.size(), [&points](size_t idx) { return points.index(idx); }, cov);
 }
 
-std::vector<Vector> Geometry::computeNormals(std::vector<Point> &points, const Octree &map, double distance) {
+std::pair<double, double> Geometry::planeResiduals(const PointCloud &points, const std::vector<size_t> &indices, const Vector &normal) {
+    const size_t n = indices.size();
+    if (n == 0) {
+        return {0., 0.};
+    }
+    const float *xs = points.xData(), *ys = points.yData(), *zs = points.zData();
+    const size_t *idx = indices.data();
+
+    double mx = 0., my = 0., mz = 0.;
+#pragma omp simd reduction(+ : mx, my, mz)
+    for (size_t k = 0; k < n; ++k) {
+        mx += xs[idx[k]];
+        my += ys[idx[k]];
+        mz += zs[idx[k]];
+    }
+
+    // Plano nx * x + ny * y + nz * z + d = 0 con normal unitaria y que pasa por el centroide
+    const double length = normal.module();
+    const double nx = normal.getX() / length, ny = normal.getY() / length, nz = normal.getZ() / length;
+    const double d = -(nx * mx + ny * my + nz * mz) / n;
+
+    double squares = 0., max = 0.;
+#pragma omp simd reduction(+ : squares) reduction(max : max)
+    for (size_t k = 0; k < n; ++k) {
+        const double r = nx * xs[idx[k]] + ny * ys[idx[k]] + nz * zs[idx[k]] + d;
+        squares += r * r;
+        max = std::max(max, std::fabs(r));
+    }
+
+    return {std::sqrt(squares / n), max};
+}
+
+// Diagonalización de una matriz simétrica 3x3 mediante barridos cíclicos de Jacobi, con los vectores propios por columnas
+static void jacobiEigen(double m[3][3], double v[3][3]) {
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            v[i][j] = i == j ? 1. : 0.;
+        }
+    }
+
+    // Convergencia cuadrática: en una matriz 3x3 bastan unos pocos barridos
+    for (int sweep = 0; sweep < 16; ++sweep) {
+        const double off = m[0][1] * m[0][1] + m[0][2] * m[0][2] + m[1][2] * m[1][2];
+        const double diag = m[0][0] * m[0][0] + m[1][1] * m[1][1] + m[2][2] * m[2][2];
+        if (off <= 1.e-30 * diag || off == 0.) {
+            break;
+        }
+
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (m[p][q] == 0.) {
+                    continue;
+                }
+
+                // Rotación que anula el elemento (p, q)
+                const double theta = (m[q][q] - m[p][p]) / (2. * m[p][q]);
+                const double t = (theta >= 0. ? 1. : -1.) / (std::fabs(theta) + std::sqrt(theta * theta + 1.));
+                const double c = 1. / std::sqrt(t * t + 1.), s = t * c;
+
+                for (int k = 0; k < 3; ++k) {
+                    const double mkp = m[k][p], mkq = m[k][q];
+                    m[k][p] = c * mkp - s * mkq;
+                    m[k][q] = s * mkp + c * mkq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double mpk = m[p][k], mqk = m[q][k];
+                    m[p][k] = c * mpk - s * mqk;
+                    m[q][k] = s * mpk + c * mqk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const double vkp = v[k][p], vkq = v[k][q];
+                    v[k][p] = c * vkp - s * vkq;
+                    v[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+}
+
+Vector Geometry::smallestEigenvector(double m[3][3]) {
+    double v[3][3];
+    jacobiEigen(m, v);
+
+    int min = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (m[i][i] < m[min][min]) {
+            min = i;
+        }
+    }
+
+    return Vector(v[0][min], v[1][min], v[2][min]);
+}
+
+std::vector<Vector> Geometry::computeNormals(const PointCloud &points, const NeighborGraph &graph, double distance, NormalMode mode) {
+    // Por debajo del umbral el recorrido de los vóxeles cuesta más que las covarianzas exactas
+    if (mode == kNormalVoxel && points.size() >= NORMAL_VOXEL_MIN_POINTS) {
+        return computeVoxelNormals(points, distance);
+    }
+
     std::vector<Vector> normals(points.size(), Vector(0, 0, 0));
 
 #pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
     for (size_t i = 0; i < points.size(); ++i) {
-        std::vector<Point *> neighbours = map.searchNeighbors(points[i], distance, Kernel_t::sphere);
+        NeighborRange neighbours = graph.neighborsOf(i, distance);
 
         // Para el cálculo de la normal se necesitan un mínimo de 3 puntos vecinos
         // En el caso de no cumplir este requerimiento el punto no tendrá una normal válida asignada
         if (neighbours.size() > 2) {
-            normals[i] = Geometry::computeNormal(neighbours);
+            // Covarianza recorriendo directamente la fila del grafo, sin copiar los índices de los vecinos
+            double cov[3][3];
+            covariance(points, neighbours.size(), [&neighbours](size_t idx) { return neighbours[idx]; }, cov);
+            normals[i] = smallestEigenvector(cov);
             if (normals[i].getX() < 0) {
                 normals[i] = normals[i] * -1;
             }
@@ -137,6 +285,138 @@ std::vector<Vector> Geometry::computeNormals(std::vector<Point> &points, const O
     return normals;
 }
 
+/**
+ * Coordenadas enteras de un vóxel
+ */
+struct VoxelKey {
+    int64_t x, y, z;  ///< Índice del vóxel en cada eje
+
+    bool operator==(const VoxelKey &other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+/**
+ * Hash de 64 bits de las tres coordenadas completas de un vóxel
+ */
+struct VoxelKeyHash {
+    size_t operator()(const VoxelKey &k) const {
+        uint64_t h = uint64_t(k.x) * 0x9E3779B97F4A7C15ull;
+        h = (h ^ (h >> 29) ^ uint64_t(k.y)) * 0xBF58476D1CE4E5B9ull;
+        h = (h ^ (h >> 32) ^ uint64_t(k.z)) * 0x94D049BB133111EBull;
+        return size_t(h ^ (h >> 31));
+    }
+};
+
+std::vector<Vector> Geometry::computeVoxelNormals(const PointCloud &points, double distance, double voxelSize) {
+    std::vector<Vector> normals(points.size(), Vector(0, 0, 0));
+    if (points.empty() || voxelSize <= 0) {
+        return normals;
+    }
+
+    // Momentos de los puntos de un vóxel, relativos al mínimo de la nube para evitar cancelaciones
+    struct Moments {
+        double n = 0, x = 0, y = 0, z = 0, xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
+    };
+
+    const float *xs = points.xData(), *ys = points.yData(), *zs = points.zData();
+    const double minX = *std::min_element(xs, xs + points.size());
+    const double minY = *std::min_element(ys, ys + points.size());
+    const double minZ = *std::min_element(zs, zs + points.size());
+
+    // Acumulación de momentos por vóxel, indexados por sus coordenadas completas
+    std::unordered_map<VoxelKey, size_t, VoxelKeyHash> voxelIndex;
+    std::vector<std::array<int64_t, 3>> voxelCoords;
+    std::vector<Moments> moments;
+    std::vector<size_t> pointVoxel(points.size());
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        const double x = xs[i] - minX, y = ys[i] - minY, z = zs[i] - minZ;
+        const int64_t vx = int64_t(x / voxelSize), vy = int64_t(y / voxelSize), vz = int64_t(z / voxelSize);
+
+        auto it = voxelIndex.try_emplace(VoxelKey{vx, vy, vz}, moments.size());
+        if (it.second) {
+            moments.emplace_back();
+            voxelCoords.push_back({vx, vy, vz});
+        }
+        pointVoxel[i] = it.first->second;
+
+        Moments &m = moments[it.first->second];
+        m.n += 1;
+        m.x += x;
+        m.y += y;
+        m.z += z;
+        m.xx += x * x;
+        m.xy += x * y;
+        m.xz += x * z;
+        m.yy += y * y;
+        m.yz += y * z;
+        m.zz += z * z;
+    }
+
+    // Desplazamientos de los vóxeles que cubren la esfera de vecindad
+    const int64_t reach = int64_t(std::ceil(distance / voxelSize));
+    std::vector<std::array<int64_t, 3>> stencil;
+    for (int64_t dx = -reach; dx <= reach; ++dx) {
+        for (int64_t dy = -reach; dy <= reach; ++dy) {
+            for (int64_t dz = -reach; dz <= reach; ++dz) {
+                if ((dx * dx + dy * dy + dz * dz) * voxelSize * voxelSize <= distance * distance) {
+                    stencil.push_back({dx, dy, dz});
+                }
+            }
+        }
+    }
+
+    // Normal de cada vóxel a partir de la suma de los momentos de los vóxeles vecinos
+    std::vector<Vector> voxelNormals(moments.size(), Vector(0, 0, 0));
+
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t v = 0; v < moments.size(); ++v) {
+        Moments sum;
+        for (const std::array<int64_t, 3> &d : stencil) {
+            const int64_t vx = voxelCoords[v][0] + d[0], vy = voxelCoords[v][1] + d[1], vz = voxelCoords[v][2] + d[2];
+            if (vx < 0 || vy < 0 || vz < 0) {
+                continue;
+            }
+            auto it = voxelIndex.find(VoxelKey{vx, vy, vz});
+            if (it != voxelIndex.end()) {
+                const Moments &m = moments[it->second];
+                sum.n += m.n;
+                sum.x += m.x;
+                sum.y += m.y;
+                sum.z += m.z;
+                sum.xx += m.xx;
+                sum.xy += m.xy;
+                sum.xz += m.xz;
+                sum.yy += m.yy;
+                sum.yz += m.yz;
+                sum.zz += m.zz;
+            }
+        }
+
+        // Mínimo de 3 puntos vecinos, igual que en el cálculo exacto
+        if (sum.n > 2) {
+            double cov[3][3];
+            cov[0][0] = sum.xx - sum.x * sum.x / sum.n;
+            cov[0][1] = cov[1][0] = sum.xy - sum.x * sum.y / sum.n;
+            cov[0][2] = cov[2][0] = sum.xz - sum.x * sum.z / sum.n;
+            cov[1][1] = sum.yy - sum.y * sum.y / sum.n;
+            cov[1][2] = cov[2][1] = sum.yz - sum.y * sum.z / sum.n;
+            cov[2][2] = sum.zz - sum.z * sum.z / sum.n;
+
+            voxelNormals[v] = smallestEigenvector(cov);
+            if (voxelNormals[v].getX() < 0) {
+                voxelNormals[v] = voxelNormals[v] * -1;
+            }
+        }
+    }
+
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < points.size(); ++i) {
+        normals[i] = voxelNormals[pointVoxel[i]];
+    }
+
+    return normals;
+}
+
 arma::vec4 Geometry::computePlane(const Vector &vnormal, const Point &centroid) {
     arma::vec4 plane;
 
@@ -161,7 +441,7 @@ arma::vec4 Geometry::computePlane(const std::vector<Point> &points) {
     return plane;
 }
 
-arma::vec4 Geometry::computePlane(const std::vector<Point *> &points) {
+arma::vec4 Geometry::computePlane(const PointCloudView &points) {
     arma::vec4 plane;
     Vector vnormal = computeNormal(points);
     Point centroid = computeCentroid(points);
@@ -214,193 +494,460 @@ arma::mat33 Geometry::rotationMatrix(const Vector &deg) {
              cb * cg}};
 }
 
-std::pair<BBox, Vector> Geometry::minimumBBoxRotTrans(std::vector<Point> &points) {
-    Vector rotmin(0, 0, 0);  // Ángulos de rotación iniciales
-    BBox bbmin(points);      // BBox sin rotacion
-    arma::mat33 rotmatrix, orirotmatrix;
-    Point trans;
-
-#pragma omp parallel
-    {
-        // Rotaciones amplias en las tres dimensiones
-#pragma omp for collapse(3) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-        for (int i = 0; i < 90; i += 6) {
-            for (int j = 0; j < 90; j += 6) {
-                for (int k = 0; k < 90; k += 6) {
-                    // El primer elemento es el mínimo por defecto
-                    if (i == 0 && j == 0 && k == 0) {
-                        continue;
-                    } else {
-                        BBox bb(points, rotationMatrix(i, j, k));
-#pragma omp critical
-                        if (bb < bbmin) {
-                            bbmin = bb;
-                            rotmin = Vector(i, j, k);
-                        }
-                    }
-                }
-            }
+Vector Geometry::rotationAngles(const arma::mat33 &rot) {
+    // Descomposición de rot = Rz * Ry * Rx
+    double alpha, beta, gamma;
+    beta = std::asin(std::max(-1., std::min(1., -rot(2, 0))));
+    if (std::fabs(rot(2, 0)) < 1. - 1e-12) {
+        alpha = std::atan2(rot(1, 0), rot(0, 0));
+        gamma = std::atan2(rot(2, 1), rot(2, 2));
+    }
+    // Bloqueo de cardán: solo se puede determinar la suma de las rotaciones en x y z
+    else {
+        alpha = std::atan2(-rot(0, 1), rot(1, 1));
+        gamma = 0;
+    }
+    return Vector(gamma / RAD_PER_DEG, beta / RAD_PER_DEG, alpha / RAD_PER_DEG);
+}
+
+using Vec3 = std::array<double, 3>;
+
+// Producto escalar de dos vectores
+static inline double dot3(const Vec3 &a, const Vec3 &b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+// Producto vectorial de dos vectores
+static inline Vec3 cross3(const Vec3 &a, const Vec3 &b) { return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]}; }
+
+// Envolvente convexa 2D (monotone chain) en sentido antihorario
+static std::vector<std::array<double, 2>> convexHull2D(std::vector<std::array<double, 2>> pts) {
+    std::sort(pts.begin(), pts.end());
+    pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+    if (pts.size() < 3) {
+        return pts;
+    }
+
+    auto turn = [](const std::array<double, 2> &o, const std::array<double, 2> &a, const std::array<double, 2> &b) {
+        return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+    };
+
+    std::vector<std::array<double, 2>> hull(2 * pts.size());
+    size_t k = 0;
+    for (size_t i = 0; i < pts.size(); ++i) {
+        while (k >= 2 && turn(hull[k - 2], hull[k - 1], pts[i]) <= 0) {
+            --k;
         }
-        // Rotaciones pequeñas dentro del radio de la mejor rotación grande
-#pragma omp for collapse(3) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-        for (int i = (int)rotmin.getX() - 5; i < (int)rotmin.getX() + 6; ++i) {
-            for (int j = (int)rotmin.getY() - 5; j < (int)rotmin.getY() + 6; ++j) {
-                for (int k = (int)rotmin.getZ() - 5; k < (int)rotmin.getZ() + 6; ++k) {
-                    // El primer elemento es el mínimo por defecto
-                    if (i == (int)rotmin.getX() && j == (int)rotmin.getY() && k == (int)rotmin.getZ()) {
-                        continue;
-                    } else {
-                        BBox bb(points, rotationMatrix(i, j, k));
-#pragma omp critical
-                        if (bb < bbmin) {
-                            bbmin = bb;
-                            rotmin = Vector(i, j, k);
-                        }
-                    }
-                }
+        hull[k++] = pts[i];
+    }
+    for (size_t i = pts.size() - 1, t = k + 1; i > 0; --i) {
+        while (k >= t && turn(hull[k - 2], hull[k - 1], pts[i - 1]) <= 0) {
+            --k;
+        }
+        hull[k++] = pts[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+/**
+ * Candidato a bounding box orientada
+ */
+struct OrientedBox {
+    Vec3 axes[3];   ///< Ejes de la bounding box, filas de la matriz de rotación
+    double volume;  ///< Volumen de la bounding box
+    double size;    ///< Suma de las dimensiones, para desempatar bounding boxes de volumen nulo
+};
+
+// Obtiene la bounding box de mínimo volumen con uno de sus ejes fijado, buscando el rectángulo de área mínima
+// de la proyección de los puntos sobre el plano perpendicular con un lado paralelo a alguna arista de su envolvente 2D
+static OrientedBox boxAroundAxis(const std::vector<Vec3> &pts, const Vec3 &n) {
+    // Base ortonormal del plano perpendicular al eje
+    const int least = std::fabs(n[0]) <= std::fabs(n[1]) ? (std::fabs(n[0]) <= std::fabs(n[2]) ? 0 : 2) : (std::fabs(n[1]) <= std::fabs(n[2]) ? 1 : 2);
+    Vec3 a = {0, 0, 0};
+    a[least] = 1;
+    Vec3 u = cross3(n, a);
+    const double ul = std::sqrt(dot3(u, u));
+    u = {u[0] / ul, u[1] / ul, u[2] / ul};
+    const Vec3 v = cross3(n, u);
+
+    double hmin = std::numeric_limits<double>::max(), hmax = -hmin;
+    std::vector<std::array<double, 2>> proj(pts.size());
+    for (size_t i = 0; i < pts.size(); ++i) {
+        proj[i] = {dot3(pts[i], u), dot3(pts[i], v)};
+        hmin = std::min(hmin, dot3(pts[i], n));
+        hmax = std::max(hmax, dot3(pts[i], n));
+    }
+    std::vector<std::array<double, 2>> poly = convexHull2D(proj);
+
+    OrientedBox best;
+    best.volume = std::numeric_limits<double>::max();
+    best.size = std::numeric_limits<double>::max();
+    const double height = hmax - hmin;
+
+    for (size_t i = 0; i < std::max<size_t>(poly.size(), 1); ++i) {
+        // Dirección de la arista (i, i + 1) de la envolvente 2D
+        double ex = 1, ey = 0;
+        if (poly.size() > 1) {
+            const std::array<double, 2> &p0 = poly[i], &p1 = poly[(i + 1) % poly.size()];
+            const double len = std::hypot(p1[0] - p0[0], p1[1] - p0[1]);
+            if (len <= 0) {
+                continue;
             }
+            ex = (p1[0] - p0[0]) / len;
+            ey = (p1[1] - p0[1]) / len;
         }
-#pragma omp single
-        {
-            // Matriz de rotación para obtener la posición de menor volumen
-            rotmatrix = Geometry::rotationMatrix(rotmin);
 
-            // Translación para llevar el centro de la bounding box al (0, 0, 0)
-            trans = Point(0, 0, 0) - ((bbmin.getDelta() / 2) + bbmin.getMin());
+        double wmin = std::numeric_limits<double>::max(), wmax = -wmin, lmin = wmin, lmax = -wmin;
+        for (const std::array<double, 2> &q : poly) {
+            const double w = q[0] * ex + q[1] * ey, l = -q[0] * ey + q[1] * ex;
+            wmin = std::min(wmin, w);
+            wmax = std::max(wmax, w);
+            lmin = std::min(lmin, l);
+            lmax = std::max(lmax, l);
+        }
 
-            // Obtener la mejor orientación de la bounding box con < largo, < ancho y < alto en este orden
-            auto bestOri = bestOrientation(bbmin);
+        const double volume = (wmax - wmin) * (lmax - lmin) * height;
+        const double size = (wmax - wmin) + (lmax - lmin) + height;
+        if (volume < best.volume || (volume == best.volume && size < best.size)) {
+            best.volume = volume;
+            best.size = size;
+            best.axes[0] = {ex * u[0] + ey * v[0], ex * u[1] + ey * v[1], ex * u[2] + ey * v[2]};
+            best.axes[1] = {-ey * u[0] + ex * v[0], -ey * u[1] + ex * v[1], -ey * u[2] + ex * v[2]};
+            best.axes[2] = n;
+        }
+    }
 
-            // Rotación con la bounding box en (0, 0, 0) para obtener la mejor orientación
-            orirotmatrix = Geometry::rotationMatrix(bestOri.second);
+    return best;
+}
 
-            // Calculo de la bounding box despues de las rotacion, translacion y rotación hacia la mejor orientación
-            Point halfDim(bestOri.first.getDelta() / 2);
-            bbmin = {halfDim, Point(0, 0, 0) - halfDim};
+std::pair<BBox, Vector> Geometry::minimumBBoxHull(const ConvexHull &hull) {
+    const std::vector<Point> &vertices = hull.getVertices();
+    if (vertices.empty()) {
+        return {BBox(), Vector(0, 0, 0)};
+    }
+
+    std::vector<Vec3> pts(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        pts[i] = {vertices[i].getX(), vertices[i].getY(), vertices[i].getZ()};
+    }
+
+    // Ejes candidatos: ejes principales de los vértices y normales de las caras de la envolvente
+    std::vector<Vec3> candidates;
+
+    double cov[3][3], pca[3][3];
+    PointCloud cloud(vertices);
+    computeCovariance(cloud.view(), cov);
+    jacobiEigen(cov, pca);
+    for (int k = 0; k < 3; ++k) {
+        candidates.push_back({pca[0][k], pca[1][k], pca[2][k]});
+    }
+
+    // Normales sin repetir, ya que las caras coplanares de la envolvente comparten normal
+    std::set<std::array<long long, 3>> seen;
+    for (const Vector &nv : hull.getNormals()) {
+        Vec3 n = {nv.getX(), nv.getY(), nv.getZ()};
+        const double nl = std::sqrt(dot3(n, n));
+        if (nl <= 0) {
+            continue;
         }
-        // Implicit barrier
-#pragma omp for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-        for (size_t i = 0; i < points.size(); ++i) {
-            Point p = (points[i].rotate(rotmatrix) + trans).rotate(orirotmatrix);
-            points[i] = Point(p.getX(), p.getY(), p.getZ(), points[i].getClusterID());
+        double sign = (n[0] < 0 || (n[0] == 0 && (n[1] < 0 || (n[1] == 0 && n[2] < 0)))) ? -1 : 1;
+        n = {sign * n[0] / nl, sign * n[1] / nl, sign * n[2] / nl};
+        if (seen.insert({std::llround(n[0] * 1e6), std::llround(n[1] * 1e6), std::llround(n[2] * 1e6)}).second) {
+            candidates.push_back(n);
         }
     }
 
-    return {bbmin, rotmin};
+    OrientedBox best;
+    best.volume = std::numeric_limits<double>::max();
+    best.size = std::numeric_limits<double>::max();
+    for (const Vec3 &n : candidates) {
+        OrientedBox box = boxAroundAxis(pts, n);
+        if (box.volume < best.volume || (box.volume == best.volume && box.size < best.size)) {
+            best = box;
+        }
+    }
+
+    // Ángulos de la rotación y bounding box con la rotación reconstruida a partir de ellos
+    arma::mat33 rot = {{best.axes[0][0], best.axes[0][1], best.axes[0][2]},
+                       {best.axes[1][0], best.axes[1][1], best.axes[1][2]},
+                       {best.axes[2][0], best.axes[2][1], best.axes[2][2]}};
+    Vector angles = rotationAngles(rot);
+
+    return {BBox(vertices, rotationMatrix(angles)), angles};
 }
 
-std::pair<BBox, Vector> Geometry::minimumBBox(const std::vector<Point> &points) {
-    Vector rotmin(0, 0, 0);  // Ángulos de rotación iniciales
-    BBox bbmin(points);      // BBox sin rotacion
-    arma::mat33 rotmatrix;
-    Point trans;
-
-#pragma omp parallel
-    {
-        // Rotaciones amplias en las tres dimensiones
-#pragma omp for collapse(3) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-        for (int i = 0; i < 90; i += 6) {
-            for (int j = 0; j < 90; j += 6) {
-                for (int k = 0; k < 90; k += 6) {
-                    // El primer elemento es el mínimo por defecto
-                    if (i == 0 && j == 0 && k == 0) {
-                        continue;
-                    } else {
-                        BBox bb(points, rotationMatrix(i, j, k));
-#pragma omp critical
-                        if (bb < bbmin) {
-                            bbmin = bb;
-                            rotmin = Vector(i, j, k);
-                        }
-                    }
-                }
+// Matriz con uno de cada stride puntos como filas (N/stride x 3)
+static arma::mat pointMatrix(const PointCloudView &points, size_t stride = 1) {
+    arma::mat P((points.size() + stride - 1) / stride, 3);
+    for (size_t i = 0, r = 0; i < points.size(); i += stride, ++r) {
+        const Point p = points[i];
+        P(r, 0) = p.getX();
+        P(r, 1) = p.getY();
+        P(r, 2) = p.getZ();
+    }
+    return P;
+}
+
+// Número de rotaciones por lote para N puntos, limitado por el tamaño de la matriz de coordenadas rotadas
+static size_t batchSize(size_t n) {
+    return std::max<size_t>(1, std::min<size_t>(BBOX_BATCH_SIZE, BBOX_BATCH_MAX_ELEMENTS / (3 * std::max<size_t>(n, 1))));
+}
+
+// Bounding boxes de los puntos (N x 3) rotados según count rotaciones consecutivas, con un único producto de matrices.
+// El producto se hace fuera de cualquier región paralela para que OpenBLAS use sus propios hilos sin anidarse en los de OpenMP,
+// que solo reparten después las reducciones de mínimos y máximos
+static void batchBBoxes(const arma::mat &P, const arma::mat33 *rotations, size_t count, BBox *bboxes) {
+    const size_t n = P.n_rows;
+
+    // Traspuestas de las rotaciones del lote apiladas por columnas (3 x 3K)
+    arma::mat R(3, 3 * count);
+    for (size_t r = 0; r < count; ++r) {
+        for (size_t row = 0; row < 3; ++row) {
+            for (size_t col = 0; col < 3; ++col) {
+                R(col, 3 * r + row) = rotations[r](row, col);
             }
         }
-        // Rotaciones pequeñas dentro del radio de la mejor rotación grande
-#pragma omp for collapse(3) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-        for (int i = (int)rotmin.getX() - 5; i < (int)rotmin.getX() + 6; ++i) {
-            for (int j = (int)rotmin.getY() - 5; j < (int)rotmin.getY() + 6; ++j) {
-                for (int k = (int)rotmin.getZ() - 5; k < (int)rotmin.getZ() + 6; ++k) {
-                    // El primer elemento es el mínimo por defecto
-                    if (i == (int)rotmin.getX() && j == (int)rotmin.getY() && k == (int)rotmin.getZ()) {
-                        continue;
-                    } else {
-                        BBox bb(points, rotationMatrix(i, j, k));
-#pragma omp critical
-                        if (bb < bbmin) {
-                            bbmin = bb;
-                            rotmin = Vector(i, j, k);
-                        }
-                    }
-                }
+    }
+
+    // Coordenadas rotadas de todos los puntos para todas las rotaciones del lote (N x 3K)
+    arma::mat Y = P * R;
+
+    // Mínimo y máximo de cada columna, contiguas en memoria
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE) if (count > 1)
+    for (size_t r = 0; r < count; ++r) {
+        double lo[3], hi[3];
+        for (size_t c = 0; c < 3; ++c) {
+            const double *column = Y.colptr(3 * r + c);
+            double cmin = column[0], cmax = column[0];
+#pragma omp simd reduction(min : cmin) reduction(max : cmax)
+            for (size_t i = 1; i < n; ++i) {
+                cmin = std::min(cmin, column[i]);
+                cmax = std::max(cmax, column[i]);
             }
+            lo[c] = cmin;
+            hi[c] = cmax;
         }
-        // Bounding box de mejor orientación dentro de las 6 posibles
-#pragma omp single
-        {
-            auto temp = bestOrientation(bbmin);
-            bbmin = temp.first;
-            rotmin = rotmin + temp.second;
-        }
+        bboxes[r] = BBox(Point(hi[0], hi[1], hi[2]), Point(lo[0], lo[1], lo[2]));
+    }
+}
+
+std::vector<BBox> Geometry::rotatedBBoxes(const PointCloudView &points, const std::vector<arma::mat33> &rotations) {
+    const size_t n = points.size();
+    std::vector<BBox> bboxes(rotations.size());
+    if (n == 0 || rotations.empty()) {
+        return bboxes;
     }
-    return {BBox(bbmin.getDelta()), rotmin};
+
+    arma::mat P = pointMatrix(points);
+    const size_t batch = batchSize(n);
+
+    for (size_t first = 0; first < rotations.size(); first += batch) {
+        const size_t count = std::min(batch, rotations.size() - first);
+        batchBBoxes(P, rotations.data() + first, count, bboxes.data() + first);
+    }
+
+    return bboxes;
 }
 
-std::vector<std::pair<BBox, Vector>> Geometry::minimumBBoxes(const std::vector<std::vector<Point *>> &points) {
-    std::vector<std::pair<BBox, Vector>> bboxes = {points.size(), {{}, Vector(0, 0, 0)}};
+/**
+ * Mejor candidato de la búsqueda en rejilla de la bounding box de un conjunto de puntos
+ */
+struct GridCandidate {
+    BBox bbox;     ///< Bounding box del candidato
+    size_t index;  ///< Posición del candidato en su lista de rotaciones más uno, o 0 para el mínimo de la etapa anterior
+};
+
+// Orden total entre candidatos: menor volumen y, a igualdad de volumen, el primero de la lista
+static inline bool betterCandidate(const GridCandidate &a, const GridCandidate &b) {
+    return a.bbox < b.bbox || (a.bbox == b.bbox && a.index < b.index);
+}
 
-#pragma omp parallel
-    {
-        for (size_t v = 0; v < points.size(); ++v) {
-#pragma omp single
-            {
-                bboxes[v].first = BBox(points[v]);
-            }
-            // Rotaciones amplias en las tres dimensiones
-#pragma omp for collapse(3) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-            for (int i = 0; i < 90; i += 6) {
-                for (int j = 0; j < 90; j += 6) {
-                    for (int k = 0; k < 90; k += 6) {
-                        // El primer elemento es el mínimo por defecto
-                        if (i == 0 && j == 0 && k == 0) {
-                            continue;
-                        } else {
-                            BBox bb(points[v], rotationMatrix(i, j, k));
-#pragma omp critical
-                            if (bb <= bboxes[v].first) {
-                                bboxes[v].first = bb;
-                                bboxes[v].second = Vector(i, j, k);
-                            }
-                        }
-                    }
+// Evalúa las rotaciones candidatas de cada conjunto de puntos lote a lote, quedándose con el mejor candidato.
+// El mínimo actual de cada conjunto se vuelve a evaluar sobre su muestra para comparar todos los candidatos con los mismos puntos
+static void evaluateGrid(const std::vector<arma::mat> &blocks, const std::vector<std::vector<Vector>> &angles,
+                         const std::vector<std::vector<arma::mat33>> &rotations, std::vector<std::pair<BBox, Vector>> &result) {
+    std::vector<BBox> bboxes;
+    for (size_t v = 0; v < blocks.size(); ++v) {
+        if (blocks[v].n_rows == 0) {
+            continue;
+        }
+
+        GridCandidate best;
+        arma::mat33 rot = Geometry::rotationMatrix(result[v].second);
+        batchBBoxes(blocks[v], &rot, 1, &best.bbox);
+        best.index = 0;
+
+        const size_t batch = batchSize(blocks[v].n_rows);
+        for (size_t first = 0; first < rotations[v].size(); first += batch) {
+            const size_t count = std::min(batch, rotations[v].size() - first);
+            bboxes.resize(count);
+            batchBBoxes(blocks[v], rotations[v].data() + first, count, bboxes.data());
+            for (size_t c = 0; c < count; ++c) {
+                GridCandidate candidate = {bboxes[c], first + c + 1};
+                if (betterCandidate(candidate, best)) {
+                    best = candidate;
                 }
             }
-            // Rotaciones pequeñas dentro del radio de la mejor rotación grande
-#pragma omp for collapse(3) schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-            for (int i = (int)bboxes[v].second.getX() - 5; i < (int)bboxes[v].second.getX() + 6; ++i) {
-                for (int j = (int)bboxes[v].second.getY() - 5; j < (int)bboxes[v].second.getY() + 6; ++j) {
-                    for (int k = (int)bboxes[v].second.getZ() - 5; k < (int)bboxes[v].second.getZ() + 6; ++k) {
-                        if (i == (int)bboxes[v].second.getX() && j == (int)bboxes[v].second.getY() && k == (int)bboxes[v].second.getZ()) {
-                            continue;
-                        } else {
-                            BBox bb(points[v], rotationMatrix(i, j, k));
-#pragma omp critical
-                            if (bb <= bboxes[v].first) {
-                                bboxes[v].first = bb;
-                                bboxes[v].second = Vector(i, j, k);
-                            }
+        }
+
+        result[v].first = best.bbox;
+        if (best.index > 0) {
+            result[v].second = angles[v][best.index - 1];
+        }
+    }
+}
+
+std::vector<std::pair<BBox, Vector>> Geometry::gridSearch(const std::vector<PointCloudView> &points, const std::vector<GridStage> &schedule) {
+    const size_t nsets = points.size();
+    std::vector<std::pair<BBox, Vector>> result(nsets, {BBox(), Vector(0, 0, 0)});  // Sin rotación por defecto
+    std::vector<arma::mat> blocks(nsets);  // Muestra de los puntos de cada conjunto como matriz
+    std::vector<std::vector<Vector>> angles(nsets);
+    std::vector<std::vector<arma::mat33>> rotations(nsets);
+
+    for (size_t s = 0; s < schedule.size(); ++s) {
+        const int step = std::max(1, schedule[s].step);
+        const bool last = s + 1 == schedule.size();
+
+        for (size_t v = 0; v < nsets; ++v) {
+            // Submuestra uniforme de los puntos, completa en la última etapa
+            const size_t n = points[v].size();
+            size_t stride = 1;
+            if (!last && schedule[s].fraction > 0 && schedule[s].fraction < 1) {
+                stride = std::max<size_t>(1, std::min<size_t>(std::llround(1 / schedule[s].fraction), n / BBOX_GRID_MIN_SAMPLE));
+            }
+            blocks[v] = pointMatrix(points[v], stride);
+
+            // Rotaciones de la etapa: de 0 a 90º en la primera y, en las siguientes, desplazamientos múltiplos de la separación
+            // de la etapa que cubren todos los ángulos entre la mejor rotación y sus vecinas de la etapa anterior
+            const int x = (int)result[v].second.getX(), y = (int)result[v].second.getY(), z = (int)result[v].second.getZ();
+            const int radius = s == 0 ? 0 : (std::max(1, schedule[s - 1].step) + step - 2) / step * step;
+            const int lo[3] = {s == 0 ? 0 : x - radius, s == 0 ? 0 : y - radius, s == 0 ? 0 : z - radius};
+            const int hi[3] = {s == 0 ? 89 : x + radius, s == 0 ? 89 : y + radius, s == 0 ? 89 : z + radius};
+            angles[v].clear();
+            rotations[v].clear();
+            for (int i = lo[0]; i <= hi[0]; i += step) {
+                for (int j = lo[1]; j <= hi[1]; j += step) {
+                    for (int k = lo[2]; k <= hi[2]; k += step) {
+                        // La mejor rotación anterior es el mínimo por defecto
+                        if (i != x || j != y || k != z) {
+                            angles[v].push_back(Vector(i, j, k));
+                            rotations[v].push_back(rotationMatrix(i, j, k));
                         }
                     }
                 }
             }
-            // Bounding box de mejor orientación dentro de las 6 posibles
-#pragma omp single
-            {
-                auto temp = bestOrientation(bboxes[v].first);
-                bboxes[v].first = temp.first;
-                bboxes[v].second = bboxes[v].second + temp.second;
-            }
         }
+
+        evaluateGrid(blocks, angles, rotations, result);
+    }
+
+    return result;
+}
+
+std::pair<BBox, Vector> Geometry::minimumBBoxRotTrans(PointCloud &points, BBoxMode mode) {
+    return minimumBBoxRotTrans(points, ConvexHull(points), mode);
+}
+
+std::pair<BBox, Vector> Geometry::minimumBBoxRotTrans(PointCloud &points, const ConvexHull &hull, BBoxMode mode) {
+    Vector rotmin;  // Ángulos de rotación de menor volumen
+    BBox bbmin;     // BBox de menor volumen
+
+    if (mode == kBBoxHullSearch) {
+        // Búsqueda sobre las normales de las caras de la envolvente convexa
+        std::tie(bbmin, rotmin) = minimumBBoxHull(hull);
+    } else {
+        // Búsqueda en rejilla sobre los únicos puntos que pueden definir los extremos de la bounding box
+        PointCloud vertices(hull.getVertices());
+        std::tie(bbmin, rotmin) = gridSearch({vertices.view()})[0];
+    }
+
+    // Matriz de rotación para obtener la posición de menor volumen
+    arma::mat33 rotmatrix = Geometry::rotationMatrix(rotmin);
+
+    // Translación para llevar el centro de la bounding box al (0, 0, 0)
+    Point trans = Point(0, 0, 0) - ((bbmin.getDelta() / 2) + bbmin.getMin());
+
+    // Obtener la mejor orientación de la bounding box con < largo, < ancho y < alto en este orden
+    auto bestOri = bestOrientation(bbmin);
+
+    // Rotación con la bounding box en (0, 0, 0) para obtener la mejor orientación
+    arma::mat33 orirotmatrix = Geometry::rotationMatrix(bestOri.second);
+
+    // Calculo de la bounding box despues de las rotacion, translacion y rotación hacia la mejor orientación
+    Point halfDim(bestOri.first.getDelta() / 2);
+    bbmin = {halfDim, Point(0, 0, 0) - halfDim};
+
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < points.size(); ++i) {
+        points.set(i, (points[i].rotate(rotmatrix) + trans).rotate(orirotmatrix));
+    }
+
+    return {bbmin, rotmin};
+}
+
+std::pair<BBox, Vector> Geometry::minimumBBox(const std::vector<Point> &points, BBoxMode mode) {
+    PointCloud cloud(points);
+    return minimumBBox(cloud.view(), mode);
+}
+
+std::pair<BBox, Vector> Geometry::minimumBBox(const PointCloudView &points, BBoxMode mode) {
+    return minimumBBox(ConvexHull(points), mode);
+}
+
+std::pair<BBox, Vector> Geometry::minimumBBox(const ConvexHull &hull, BBoxMode mode) {
+    std::pair<BBox, Vector> bbmin;
+
+    if (mode == kBBoxHullSearch) {
+        // Búsqueda sobre las normales de las caras de la envolvente convexa
+        bbmin = minimumBBoxHull(hull);
+    } else {
+        // Búsqueda en rejilla sobre los únicos puntos que pueden definir los extremos de la bounding box
+        PointCloud vertices(hull.getVertices());
+        bbmin = gridSearch({vertices.view()})[0];
+    }
+
+    // Bounding box de mejor orientación dentro de las 6 posibles
+    auto temp = bestOrientation(bbmin.first);
+    return {BBox(temp.first.getDelta()), bbmin.second + temp.second};
+}
+
+std::vector<std::pair<BBox, Vector>> Geometry::minimumBBoxes(const std::vector<PointCloudView> &points, BBoxMode mode) {
+    std::vector<ConvexHull> hulls(points.size());
+
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t v = 0; v < points.size(); ++v) {
+        hulls[v] = ConvexHull(points[v]);
+    }
+
+    return minimumBBoxes(hulls, mode);
+}
+
+std::vector<std::pair<BBox, Vector>> Geometry::minimumBBoxes(const std::vector<ConvexHull> &hulls, BBoxMode mode) {
+    std::vector<std::pair<BBox, Vector>> bboxes = {hulls.size(), {{}, Vector(0, 0, 0)}};
+
+    // Búsqueda sobre las normales de las caras de cada envolvente, en paralelo entre envolventes
+    if (mode == kBBoxHullSearch) {
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+        for (size_t v = 0; v < hulls.size(); ++v) {
+            bboxes[v] = minimumBBox(hulls[v], kBBoxHullSearch);
+        }
+        return bboxes;
+    }
+
+    // Búsqueda en rejilla conjunta sobre los únicos puntos que pueden definir los extremos de cada bounding box
+    std::vector<PointCloud> vertices;
+    std::vector<PointCloudView> views;
+    vertices.reserve(hulls.size());
+    views.reserve(hulls.size());
+    for (const ConvexHull &hull : hulls) {
+        vertices.emplace_back(hull.getVertices());
+        views.push_back(vertices.back().view());
+    }
+    bboxes = gridSearch(views);
+
+    // Bounding box de mejor orientación dentro de las 6 posibles
+    for (size_t v = 0; v < bboxes.size(); ++v) {
+        auto temp = bestOrientation(bboxes[v].first);
+        bboxes[v] = {BBox(temp.first.getDelta()), bboxes[v].second + temp.second};
     }
     return bboxes;
 }
@@ -0,0 +1,183 @@
+/**
+ * @file KDTree.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del objeto KDTree
+ *
+ */
+
+#include <vector>
+#include <queue>
+#include <numeric>
+#include <algorithm>
+#include <utility>
+#include <limits>
+#include <cmath>
+
+#include "models/KDTree.hh"
+#include "models/Point.hh"
+#include "models/PointCloud.hh"
+#include "app/config.h"
+
+KDTree::KDTree(const PointCloud &points) {
+    std::vector<size_t> order(points.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (order.size() > 0) {
+        build(points, order, 0, order.size());
+    }
+
+    // Coordenadas contiguas por hojas
+    indices = std::move(order);
+    xs.resize(indices.size());
+    ys.resize(indices.size());
+    zs.resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        xs[i] = points.getX(indices[i]);
+        ys[i] = points.getY(indices[i]);
+        zs[i] = points.getZ(indices[i]);
+    }
+}
+
+size_t KDTree::build(const PointCloud &points, std::vector<size_t> &order, size_t begin, size_t end) {
+    const size_t node = nodes.size();
+    nodes.push_back({0, -1, kNone, kNone, begin, end});
+    if (end - begin <= KDTREE_LEAF_SIZE) {
+        return node;
+    }
+
+    // Eje de mayor extensión de los puntos del nodo
+    float lo[3] = {points.getX(order[begin]), points.getY(order[begin]), points.getZ(order[begin])};
+    float hi[3] = {lo[0], lo[1], lo[2]};
+    for (size_t i = begin + 1; i < end; ++i) {
+        const float c[3] = {points.getX(order[i]), points.getY(order[i]), points.getZ(order[i])};
+        for (int a = 0; a < 3; ++a) {
+            lo[a] = std::min(lo[a], c[a]);
+            hi[a] = std::max(hi[a], c[a]);
+        }
+    }
+    int axis = 0;
+    for (int a = 1; a < 3; ++a) {
+        if (hi[a] - lo[a] > hi[axis] - lo[axis]) {
+            axis = a;
+        }
+    }
+    if (hi[axis] - lo[axis] <= 0) {
+        return node;  // Puntos repetidos: se mantienen en una única hoja
+    }
+
+    auto coordinate = [&points, axis](size_t i) { return axis == 0 ? points.getX(i) : axis == 1 ? points.getY(i) : points.getZ(i); };
+
+    // División por la mediana
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&coordinate](size_t a, size_t b) { return coordinate(a) < coordinate(b); });
+
+    const float split = coordinate(order[middle]);
+    const size_t left = build(points, order, begin, middle);
+    const size_t right = build(points, order, middle, end);
+    nodes[node].split = split;
+    nodes[node].axis = axis;
+    nodes[node].left = left;
+    nodes[node].right = right;
+    return node;
+}
+
+std::pair<size_t, double> KDTree::nearest(const Point &p, double maxDistance) const {
+    const double q[3] = {p.getX(), p.getY(), p.getZ()};
+    double best = maxDistance * maxDistance;  // Distancia al cuadrado del mejor punto encontrado
+    size_t bestIndex = kNone;
+
+    if (nodes.empty()) {
+        return {size(), std::numeric_limits<double>::infinity()};
+    }
+
+    // Pila de nodos pendientes junto a una cota inferior de su distancia al cuadrado
+    std::vector<std::pair<size_t, double>> stack;
+    stack.reserve(64);
+    stack.push_back({0, 0.});
+    while (!stack.empty()) {
+        const std::pair<size_t, double> pending = stack.back();
+        stack.pop_back();
+        if (pending.second >= best) {
+            continue;
+        }
+
+        const Node &n = nodes[pending.first];
+        if (n.axis < 0) {
+            for (size_t i = n.begin; i < n.end; ++i) {
+                const double dx = xs[i] - q[0], dy = ys[i] - q[1], dz = zs[i] - q[2];
+                const double d = dx * dx + dy * dy + dz * dz;
+                if (d < best) {
+                    best = d;
+                    bestIndex = i;
+                }
+            }
+            continue;
+        }
+
+        // Se visita primero el hijo del lado del punto de consulta
+        const double diff = q[n.axis] - n.split;
+        const size_t near = diff < 0 ? n.left : n.right;
+        const size_t far = diff < 0 ? n.right : n.left;
+        if (diff * diff < best) {
+            stack.push_back({far, std::max(pending.second, diff * diff)});
+        }
+        stack.push_back({near, pending.second});
+    }
+
+    if (bestIndex == kNone) {
+        return {size(), std::numeric_limits<double>::infinity()};
+    }
+    return {indices[bestIndex], std::sqrt(best)};
+}
+
+std::vector<size_t> KDTree::nearestK(const Point &p, size_t k) const {
+    const double q[3] = {p.getX(), p.getY(), p.getZ()};
+    std::priority_queue<std::pair<double, size_t>> best;  // Mejores puntos, con el más lejano en la cima
+    auto bound = [&best, k]() { return best.size() < k ? std::numeric_limits<double>::infinity() : best.top().first; };
+
+    if (k == 0 || nodes.empty()) {
+        return {};
+    }
+
+    std::vector<std::pair<size_t, double>> stack;
+    stack.reserve(64);
+    stack.push_back({0, 0.});
+    while (!stack.empty()) {
+        const std::pair<size_t, double> pending = stack.back();
+        stack.pop_back();
+        if (pending.second >= bound()) {
+            continue;
+        }
+
+        const Node &n = nodes[pending.first];
+        if (n.axis < 0) {
+            for (size_t i = n.begin; i < n.end; ++i) {
+                const double dx = xs[i] - q[0], dy = ys[i] - q[1], dz = zs[i] - q[2];
+                const double d = dx * dx + dy * dy + dz * dz;
+                if (d < bound()) {
+                    if (best.size() == k) {
+                        best.pop();
+                    }
+                    best.push({d, i});
+                }
+            }
+            continue;
+        }
+
+        const double diff = q[n.axis] - n.split;
+        const size_t near = diff < 0 ? n.left : n.right;
+        const size_t far = diff < 0 ? n.right : n.left;
+        if (diff * diff < bound()) {
+            stack.push_back({far, std::max(pending.second, diff * diff)});
+        }
+        stack.push_back({near, pending.second});
+    }
+
+    std::vector<size_t> result(best.size());
+    for (size_t i = best.size(); i > 0; --i) {
+        result[i - 1] = indices[best.top().second];
+        best.pop();
+    }
+    return result;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file NeighborGraph.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del objeto NeighborGraph
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <omp.h>
+
+#include "models/NeighborGraph.hh"
+#include "models/PointCloud.hh"
+#include "models/Octree.hh"
+#include "models/Kernel.hh"
+#include "app/config.h"
+
+NeighborGraph::NeighborGraph(const PointCloud &points, double radius) : NeighborGraph(points, Octree(points), radius) {}
+
+NeighborGraph::NeighborGraph(const PointCloud &points, const Octree &map, double radius) : radius(radius), offsets(points.size() + 1, 0) {
+    const size_t n = points.size();
+    if (n > UINT32_MAX) {
+        throw std::length_error("NeighborGraph: point cloud too large for 32-bit neighbor indices");
+    }
+    std::vector<std::vector<size_t>> rows(n);  // Vecinos de cada punto devueltos por el octree
+
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < n; ++i) {
+        rows[i] = map.searchNeighborIndices(points[i], radius, Kernel_t::sphere);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        offsets[i + 1] = offsets[i] + rows[i].size();
+    }
+    neighbors.resize(offsets[n]);
+    distances.resize(offsets[n]);
+
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < n; ++i) {
+        const Point p = points[i];
+        std::vector<std::pair<float, uint32_t>> row;
+        row.reserve(rows[i].size());
+        for (size_t j : rows[i]) {
+            const double dx = points.getX(j) - p.getX(), dy = points.getY(j) - p.getY(), dz = points.getZ(j) - p.getZ();
+            row.push_back({(float)(dx * dx + dy * dy + dz * dz), (uint32_t)j});
+        }
+        std::vector<size_t>().swap(rows[i]);
+
+        // Orden por distancia para obtener los vecindarios de menor radio como prefijos
+        std::sort(row.begin(), row.end());
+        for (size_t k = 0; k < row.size(); ++k) {
+            distances[offsets[i] + k] = row[k].first;
+            neighbors[offsets[i] + k] = row[k].second;
+        }
+    }
+}
+
+NeighborRange NeighborGraph::neighborsOf(size_t i, double r) const {
+    if (r >= radius) {
+        return neighborsOf(i);
+    }
+
+    // Mismo criterio que el kernel esférico: distancia estrictamente menor que el radio
+    const float *first = distances.data() + offsets[i], *last = distances.data() + offsets[i + 1];
+    const size_t count = std::lower_bound(first, last, (float)(r * r)) - first;
+
+    return {neighbors.data() + offsets[i], neighbors.data() + offsets[i] + count};
+}
@@ -39,6 +39,12 @@ Octree::Octree(Vector center, float radius, std::vector<Point> &points)
     buildOctree(points);
 }
 
+Octree::Octree(const PointCloud &cloud) {
+    center_ = mbb(cloud, radius_);
+    octants_.reserve(8);
+    buildOctree(cloud);
+}
+
 void Octree::computeOctreeLimits()
 /**
  * Compute the minimum and maximum coordinates of the octree bounding box.
@@ -102,6 +108,26 @@ void Octree::insertPoint(Point *p) {
     }
 }
 
+void Octree::insertIndex(size_t i) {
+    unsigned int idx = 0;
+    Point p = indexedPoint(i);
+
+    if (isLeaf()) {
+        if (numPoints_ > MAX_POINTS) {
+            createOctants();  // Creation of children octree
+            fillOctants();    // Move points from current Octree to its corresponding children.
+            idx = octantIdx(&p);
+            octants_[idx].insertIndex(i);
+        } else {
+            indices_.emplace_back(i);
+            numPoints_++;
+        }
+    } else {
+        idx = octantIdx(&p);
+        octants_[idx].insertIndex(i);
+    }
+}
+
 void Octree::createOctants() {
     Vector newCenter;
     for (int i = 0; i < 8; i++) {
@@ -110,6 +136,9 @@ void Octree::createOctants() {
         newCenter.setY(newCenter.getY() + radius_ * (i & 2 ? 0.5f : -0.5f));
         newCenter.setX(newCenter.getX() + radius_ * (i & 1 ? 0.5f : -0.5f));
         octants_.emplace_back(Octree(newCenter, 0.5f * radius_));
+        octants_.back().xs_ = xs_;
+        octants_.back().ys_ = ys_;
+        octants_.back().zs_ = zs_;
     }
 }
 
@@ -121,8 +150,15 @@ void Octree::fillOctants() {
         octants_[idx].insertPoint(p);
     }
 
+    for (size_t i : indices_) {
+        Point p = indexedPoint(i);
+        idx = octantIdx(&p);
+        octants_[idx].insertIndex(i);
+    }
+
     numPoints_ = 0;
     points_.clear();
+    indices_.clear();
 }
 
 int Octree::octantIdx(Point *p) {
@@ -159,6 +195,20 @@ void Octree::buildOctree(std::vector<Point *> &points)
     insertPoints(points);
 }
 
+void Octree::buildOctree(const PointCloud &cloud)
+/**
+ * Build the Octree over the indices of a PointCloud
+ */
+{
+    xs_ = cloud.xData();
+    ys_ = cloud.yData();
+    zs_ = cloud.zData();
+    computeOctreeLimits();
+    for (size_t i = 0; i < cloud.size(); ++i) {
+        insertIndex(i);
+    }
+}
+
 const Vector &Octree::getCenter() const { return center_; }
 float Octree::getRadius() const { return radius_; }
 
@@ -389,6 +439,38 @@ std::vector<Point *> Octree::neighbors(std::unique_ptr<AbstractKernel> &k, std::
     return std::move(ptsInside);
 }
 
+std::vector<size_t> Octree::searchNeighborIndices(const Point &p, double radius, const Kernel_t &k_t) const
+/**
+ * @brief Search neighbors function over an Octree built from a PointCloud
+ * @param p Center of the kernel to be used
+ * @param radius Radius of the kernel to be used
+ * @param k_t Kernel type (circle, sphere, square, cube)
+ * @return Indices of the points inside the given kernel type
+ */
+{
+    std::vector<size_t> idxInside{};
+    std::unique_ptr<AbstractKernel> kernel = kernelFactory(p, radius, k_t);
+
+    neighborIndices(kernel, idxInside);
+    return idxInside;
+}
+
+void Octree::neighborIndices(std::unique_ptr<AbstractKernel> &k, std::vector<size_t> &idxInside) const {
+    if (isLeaf()) {
+        for (size_t i : indices_) {
+            if (k->isInside(indexedPoint(i))) {
+                idxInside.emplace_back(i);
+            }
+        }
+    } else {
+        for (const Octree &octant : octants_) {
+            if (k->boxOverlap(octant)) {
+                octant.neighborIndices(k, idxInside);
+            }
+        }
+    }
+}
+
 std::vector<Point *> Octree::searchNeighbors2D(const Point &p, double radius) {
     Vector boxMin, boxMax;
     std::vector<Point *> ptsInside;
@@ -735,6 +817,46 @@ Vector mbb(const std::vector<Point> &points, float &maxRadius)
     return center;
 }
 
+Vector mbb(const PointCloud &points, float &maxRadius)
+/**
+ * Computes the minimum bounding box of a PointCloud
+ * @param points Cloud of points
+ * @param[out] maxRadius Maximum radius of the bounding box
+ * @return (Vector) center of the bounding box
+ */
+{
+    Vector center, min, max, radii;
+
+    min.setX(std::numeric_limits<double>::max());
+    min.setY(std::numeric_limits<double>::max());
+    min.setZ(std::numeric_limits<double>::max());
+
+    max.setX(-std::numeric_limits<double>::max());
+    max.setY(-std::numeric_limits<double>::max());
+    max.setZ(-std::numeric_limits<double>::max());
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points.getX(i) < min.getX())
+            min.setX(points.getX(i));
+        if (points.getX(i) > max.getX())
+            max.setX(points.getX(i));
+        if (points.getY(i) < min.getY())
+            min.setY(points.getY(i));
+        if (points.getY(i) > max.getY())
+            max.setY(points.getY(i));
+        if (points.getZ(i) < min.getZ())
+            min.setZ(points.getZ(i));
+        if (points.getZ(i) > max.getZ())
+            max.setZ(points.getZ(i));
+    }
+
+    radii = mbbRadii(min, max, maxRadius);
+    center = mbbCenter(min, radii);
+    DEBUG_STDOUT("Octree Radius: " << maxRadius);
+
+    return center;
+}
+
 void Octree::writeOctree(std::ofstream &f, size_t index) const {
     index++;
     f << "Depth: " << index << " "
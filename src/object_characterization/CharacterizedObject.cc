@@ -13,15 +13,24 @@
 #include <fstream>
 #include <chrono>
 #include <iomanip>
+#include <string>
+#include <algorithm>
+#include <memory>
 #include <omp.h>
 
 #include "armadillo"
 
 #include "object_characterization/CharacterizedObject.hh"
+#include "object_characterization/ObjectFile.hh"
 #include "models/Geometry.hh"
 #include "object_characterization/DBScan.hh"
+#include "models/ConvexHull.hh"
+#include "models/TaskGraph.hh"
+#include "models/KDTree.hh"
 #include "models/Octree.hh"
+#include "models/NeighborGraph.hh"
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 #include "models/LidarPoint.hh"
 #include "models/Timestamp.hh"
 #include "app/CLI.hh"
@@ -29,180 +38,361 @@
 
 #include "logging/debug.hh"
 
-std::pair<bool, CharacterizedObject> CharacterizedObject::parse(std::vector<Point> &points, bool chrono) {
+/**
+ * Representación de un punto en el formato de archivo anterior a ObjectFile, manteniendo las coordenadas
+ * en precisión doble y el cluster ID de los objetos ya guardados
+ */
+struct FilePoint {
+    double x;  ///< Localización en el eje x del punto
+    double y;  ///< Localización en el eje y del punto
+    double z;  ///< Localización en el eje z del punto
+    int cID;   ///< Cluster ID (sin uso)
+};
+
+// Lee un punto en el formato de archivo anterior
+static Point readPoint(std::ifstream &infile) {
+    FilePoint fp = {};
+    infile.read((char *)&fp, sizeof(FilePoint));
+    return Point(fp.x, fp.y, fp.z);
+}
+
+// Lee una bounding box en el formato de archivo anterior
+static BBox readBBox(std::ifstream &infile) {
+    readPoint(infile);  // Delta, calculado a partir de los puntos máximo y mínimo
+    Point min = readPoint(infile);
+    Point max = readPoint(infile);
+    return BBox(max, min);
+}
+
+/**
+ * Datos intermedios de la caracterización de un cluster de puntos, compartidos por sus etapas
+ */
+struct ClusterStages {
+    PointCloud opoints;                         ///< Puntos del cluster, en su posición original
+    std::vector<int> labels;                    ///< ID de la cara de cada punto
+    std::vector<std::vector<size_t>> clusters;  ///< Caras del cluster
+    PointCloud tpoints;                         ///< Puntos del cluster, en la posición de la bounding box mínima
+    ConvexHull hull;                            ///< Envolvente convexa de los puntos del cluster, en la posición de la bounding box mínima
+    std::pair<BBox, Vector> bbmin;              ///< Bounding box mínima
+    std::vector<Face> faces;                    ///< Caras del objeto
+    TaskGraph::TaskID faceDetection;            ///< Tarea de detección de caras
+    TaskGraph::TaskID objectBBox;               ///< Tarea de cálculo de la bounding box del objeto
+    TaskGraph::TaskID faceBBoxes;               ///< Tarea de cálculo de las bounding boxes de las caras
+};
+
+// Añade al grafo las etapas de caracterización de un cluster cuyos puntos estarán disponibles al terminar las
+// dependencias: {detección de caras, bounding box global} -> bounding boxes de las caras. Si el cluster no tiene
+// puntos las etapas no realizan ningún trabajo
+static void addClusterStages(TaskGraph &stages, ClusterStages &c, const std::vector<TaskGraph::TaskID> &dependencies, const std::string &tag) {
+    //////////////////////////
+    // Cálculo de las caras //
+    //////////////////////////
+
+    c.faceDetection = stages.add("face detection" + tag, [&c, tag]() {
+        if (c.opoints.size() == 0) {
+            return;
+        }
+
+        // Vecindarios de los puntos del cluster para las normales y las caras, liberados al terminar la detección
+        NeighborGraph graph(c.opoints, NEIGHBOR_GRAPH_PROXIMITY);
+        c.clusters = DBScan::normals(c.opoints, graph, c.labels);  // Detección de las caras
+
+        /// DEBUG PRINT CARAS
+        DEBUG_CODE({
+            std::ofstream of("tmp/caras_object" + tag + ".csv");
+            of << LidarPoint::LivoxCSVHeader() << "\n";
+            uint32_t partial = 255 / (c.clusters.size() + 1);
+            for (size_t i = 0; i < c.opoints.size(); ++i) {
+                of << LidarPoint({0, 0}, partial * (c.labels[i] < 0 ? 0 : c.labels[i] + 1), c.opoints[i]).LivoxCSV() << "\n";
+            }
+            of.close();
+        });
+        ///
+    }, dependencies);
+
+    //////////////////////////////////////
+    // Cálculo de la mejor bounding box //
+    //////////////////////////////////////
+
+    // Solo necesita los puntos del cluster, por lo que se solapa con la detección de caras trabajando sobre una copia
+    c.objectBBox = stages.add("object bounding box" + tag, [&c]() {
+        if (c.opoints.size() == 0) {
+            return;
+        }
+
+        c.tpoints = c.opoints.clone();
+        c.hull = ConvexHull(c.tpoints);
+        c.bbmin = Geometry::minimumBBoxRotTrans(c.tpoints, c.hull);  // Bounding box mínima evaluada sobre la envolvente convexa
+        c.hull.update(c.tpoints.view());                              // Misma envolvente sobre los puntos ya recolocados
+
+        DEBUG_STDOUT("Best bounding box rotation angles: " << c.bbmin.second);
+    }, dependencies);
+
+    c.faceBBoxes = stages.add("face bounding boxes" + tag, [&c]() {
+        if (c.opoints.size() == 0 || c.clusters.size() == 0) {
+            return;
+        }
+
+        std::vector<PointCloudView> facepoints;  // Vistas de los puntos de cada cara
+        facepoints.reserve(c.clusters.size());
+        for (size_t i = 0; i < c.clusters.size(); ++i) {
+            facepoints.push_back(c.tpoints.view(c.clusters[i]));
+        }
+
+        std::vector<std::pair<BBox, Vector>> fbbmin = Geometry::minimumBBoxes(facepoints);
+
+        c.faces.resize(c.clusters.size());
+        for (size_t i = 0; i < fbbmin.size(); ++i) {
+            const Vector normal = Geometry::computeNormal(facepoints[i]);
+            const std::pair<double, double> residuals = Geometry::planeResiduals(c.tpoints, c.clusters[i], normal);
+            c.faces[i] = Face(c.clusters[i], normal, fbbmin[i].first, fbbmin[i].second, residuals.first, residuals.second);
+
+            DEBUG_STDOUT("Face " << i << " best bounding box rotation angles: " << c.faces[i].getMinBBoxRotAngles());
+        }
+    }, {c.faceDetection, c.objectBBox});
+}
+
+// Muestra el camino crítico de la última ejecución de un grafo de tareas
+static void printCriticalPath(const TaskGraph &stages) {
+    std::vector<TaskGraph::TaskID> path = stages.criticalPath();
+    double cp_duration = 0;
+    std::string cp_names;
+    for (TaskGraph::TaskID id : path) {
+        cp_duration += stages.duration(id);
+        cp_names += (cp_names.empty() ? "" : " -> ") + stages.getName(id);
+    }
+    CLI_STDOUT("Critical path: " << cp_names << " (" << cp_duration << "s)" << std::setprecision(2));
+}
+
+std::pair<bool, CharacterizedObject> CharacterizedObject::parse(const PointCloud &points, bool chrono) {
     // Salida si no existen puntos en el objeto
     if (points.size() == 0) {
-        return {false, {}};
+        return {false, CharacterizedObject()};
     }
 
-    std::chrono::system_clock::time_point start, end_agrupation, end_face_detection, end;
-
     /// DEBUG PRINT OBJECT
     DEBUG_CODE({
         std::ofstream of("tmp/raw_object.csv");
         of << LidarPoint::LivoxCSVHeader() << "\n";
-        for (auto &p : points)
+        for (const Point p : points)
             of << LidarPoint({0, 0}, 100, p).LivoxCSV() << "\n";
         of.close();
     });
     ///
 
-    if (chrono) {
-        start = std::chrono::high_resolution_clock::now();
-    }
+    // Etapas de la caracterización como grafo de dependencias:
+    // clusterización -> {detección de caras, bounding box global} -> bounding boxes de las caras
+    TaskGraph stages;
+    ClusterStages object;  // Caracterización del cluster de mayor tamaño
 
     //////////////////////////////
     // Clusterización de puntos //
     //////////////////////////////
 
-    std::vector<std::vector<size_t>> clusters = DBScan::clusters(points);  // Clusterización
+    TaskGraph::TaskID clustering = stages.add("clustering", [&]() {
+        std::vector<int> labels;                                                       // ID del cluster de cada punto
+        std::vector<std::vector<size_t>> clusters = DBScan::clusters(points, labels);  // Clusterización
 
-    // Salida si no se han detectado clústeres de puntos
-    if (clusters.size() == 0) {
-        return {false, {}};
-    }
+        // Salida si no se han detectado clústeres de puntos
+        if (clusters.size() == 0) {
+            return;
+        }
 
-    /// DEBUG PRINT CLUSTERS
-    DEBUG_CODE({
-        std::ofstream of("tmp/clusters_object.csv");
-        of << LidarPoint::LivoxCSVHeader() << "\n";
-        uint32_t partial;
-        for (size_t j = 0; j < clusters.size(); ++j) {
-            partial = 255 / clusters.size() * j;
-            for (auto &i : clusters[j]) {
-                of << LidarPoint({0, 0}, partial, points[i]).LivoxCSV() << "\n";
+        /// DEBUG PRINT CLUSTERS
+        DEBUG_CODE({
+            std::ofstream of("tmp/clusters_object.csv");
+            of << LidarPoint::LivoxCSVHeader() << "\n";
+            uint32_t partial;
+            for (size_t j = 0; j < clusters.size(); ++j) {
+                partial = 255 / clusters.size() * j;
+                for (auto &i : clusters[j]) {
+                    of << LidarPoint({0, 0}, partial, points[i]).LivoxCSV() << "\n";
+                }
+            }
+            of.close();
+        });
+        ///
+
+        // Escogemos el grupo de puntos con mayor número de puntos
+        size_t bestGroup = 0;
+        for (size_t i = 1; i < clusters.size(); ++i) {
+            if (clusters[bestGroup].size() < clusters[i].size()) {
+                bestGroup = i;
             }
         }
-        of.close();
+
+        object.opoints = points.subset(clusters[bestGroup]);
     });
-    ///
 
-    // Escogemos el grupo de puntos con mayor número de puntos
-    size_t bestGroup = 0;
-    for (size_t i = 1; i < clusters.size(); ++i) {
-        if (clusters[bestGroup].size() < clusters[i].size()) {
-            bestGroup = i;
-        }
+    addClusterStages(stages, object, {clustering}, "");
+
+    stages.run();
+
+    // Salida si no se han detectado clústeres de puntos o caras del objeto
+    if (object.opoints.size() == 0 || object.faces.size() == 0) {
+        return {false, CharacterizedObject()};
     }
 
+    // Cronometro
     if (chrono) {
-        end_agrupation = std::chrono::high_resolution_clock::now();
-    }
+        double cl_duration = stages.duration(clustering);
+        double fd_duration = stages.duration(object.faceDetection);
+        double bb_duration = stages.duration(object.objectBBox) + stages.duration(object.faceBBoxes);
 
-    //////////////////////////
-    // Cálculo de las caras //
-    //////////////////////////
+        CLI_STDOUT("Object characterization lasted " << std::setprecision(6) << stages.getWallTime() << "s (clustering: " << cl_duration << "s, face detection:  " << fd_duration << "s, bounding box selection: " << bb_duration << "s [object: " << stages.duration(object.objectBBox) << "s, faces: " << stages.duration(object.faceBBoxes) << "s])");
 
-    std::vector<Point> opoints = {clusters[bestGroup].size(), Point()};
-    for (size_t i = 0; i < clusters[bestGroup].size(); ++i) {
-        opoints[i] = points[clusters[bestGroup][i]];
-        opoints[i].setClusterID(cUnclassified);
+        // Camino crítico: cadena de etapas dependientes que determina la duración total
+        printCriticalPath(stages);
     }
 
-    clusters = DBScan::normals(opoints);  // Detección de las caras
+    DEBUG_STDOUT("Characterized object with " << object.faces.size() << " faces");
+
+    return {true, CharacterizedObject(std::move(object.tpoints), object.bbmin.first, object.faces, std::make_shared<const ConvexHull>(std::move(object.hull)))};
+}
+
+std::vector<CharacterizedObject> CharacterizedObject::parseAll(const PointCloud &points, bool chrono) {
+    std::vector<CharacterizedObject> objects;
 
-    // Salida si no se han detectado caras del objeto
-    if (clusters.size() == 0) {
-        return {false, {}};
+    // Salida si no existen puntos en el objeto
+    if (points.size() == 0) {
+        return objects;
     }
 
-    // Guardado de puntos del cluster
-    CharacterizedObject charObject;
-    charObject.setPoints(opoints);
+    //////////////////////////////
+    // Clusterización de puntos //
+    //////////////////////////////
+
+    auto start = std::chrono::steady_clock::now();
 
-    /// DEBUG PRINT CARAS
+    std::vector<int> labels;  // ID del cluster de cada punto
+    std::vector<std::vector<size_t>> clusters = DBScan::clusters(points, labels);
+
+    /// DEBUG PRINT CLUSTERS
     DEBUG_CODE({
-        std::ofstream of("tmp/caras_object.csv");
+        std::ofstream of("tmp/clusters_object.csv");
         of << LidarPoint::LivoxCSVHeader() << "\n";
-        uint32_t partial = 255 / (clusters.size() + 1);
-        for (size_t i = 0; i < opoints.size(); ++i) {
-            of << LidarPoint({0, 0}, partial * (opoints[i].getClusterID() < 0 ? 0 : opoints[i].getClusterID() + 1), opoints[i]).LivoxCSV() << "\n";
+        uint32_t partial;
+        for (size_t j = 0; j < clusters.size(); ++j) {
+            partial = 255 / clusters.size() * j;
+            for (auto &i : clusters[j]) {
+                of << LidarPoint({0, 0}, partial, points[i]).LivoxCSV() << "\n";
+            }
         }
         of.close();
     });
     ///
 
-    /// Caras
-    std::vector<std::vector<Point *>> facepoints(clusters.size(), std::vector<Point *>());  // Vector de vectores de referencias puntos de cada cara
+    // Clusteres con tamaño suficiente para ser un objeto, de mayor a menor
+    std::vector<size_t> selected;
     for (size_t i = 0; i < clusters.size(); ++i) {
-        facepoints[i].reserve(clusters[i].size());
-        for (size_t j = 0; j < clusters[i].size(); ++j) {
-            facepoints[i].push_back(&charObject.getPoints()[clusters[i][j]]);
+        if (clusters[i].size() >= MIN_OBJECT_POINTS) {
+            selected.push_back(i);
         }
     }
-    std::vector<Face> faces(clusters.size(), Face());  // Vector de caras
+    std::stable_sort(selected.begin(), selected.end(), [&clusters](size_t a, size_t b) { return clusters[a].size() > clusters[b].size(); });
 
-    if (chrono) {
-        end_face_detection = std::chrono::high_resolution_clock::now();
-    }
+    double cl_duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-    //////////////////////////////////////
-    // Cálculo de la mejor bounding box //
-    //////////////////////////////////////
+    /////////////////////////////////////
+    // Caracterización de cada cluster //
+    /////////////////////////////////////
 
-    std::pair<BBox, Vector> bbmin = Geometry::minimumBBoxRotTrans(charObject.getPoints());  // Bounding box mínima
+    // Cadenas de etapas independientes por cluster en un único grafo, de forma que los clusters se solapan entre sí
+    TaskGraph stages;
+    std::vector<ClusterStages> cstages(selected.size());  // Tamaño fijo: las etapas guardan referencias a sus elementos
+    for (size_t k = 0; k < selected.size(); ++k) {
+        const std::string tag = "[" + std::to_string(k) + "]";
+        const std::vector<size_t> &cluster = clusters[selected[k]];
+        ClusterStages &c = cstages[k];
 
-    DEBUG_STDOUT("Best bounding box rotation angles: " << bbmin.second);
-
-    std::vector<std::pair<BBox, Vector>> fbbmin = Geometry::minimumBBoxes(facepoints);
+        TaskGraph::TaskID extraction = stages.add("cluster extraction" + tag, [&points, &cluster, &c]() { c.opoints = points.subset(cluster); });
+        addClusterStages(stages, c, {extraction}, tag);
+    }
 
-    for (size_t i = 0; i < fbbmin.size(); ++i) {
-        faces[i] = Face(clusters[i], Geometry::computeNormal(facepoints[i]), fbbmin[i].first, fbbmin[i].second);
+    stages.run();
 
-        DEBUG_STDOUT("Face " << i << " best bounding box rotation angles: " << faces[i].getMinBBoxRotAngles());
+    // Se descartan los clusters en los que no se han detectado caras
+    for (ClusterStages &c : cstages) {
+        if (c.faces.size() > 0) {
+            objects.push_back(CharacterizedObject(std::move(c.tpoints), c.bbmin.first, c.faces, std::make_shared<const ConvexHull>(std::move(c.hull))));
+        }
     }
 
-    // Guardado de caras y bounding boxes
-    charObject.setBBox(bbmin.first);
-    charObject.setFaces(faces);
-
     // Cronometro
     if (chrono) {
-        end = std::chrono::high_resolution_clock::now();
+        CLI_STDOUT("Characterization of " << objects.size() << " objects lasted " << std::setprecision(6) << cl_duration + stages.getWallTime() << "s (clustering: " << cl_duration << "s, cluster characterization: " << stages.getWallTime() << "s)");
+        printCriticalPath(stages);
+    }
+
+    DEBUG_STDOUT("Characterized " << objects.size() << " objects out of " << clusters.size() << " clusters");
 
-        double cl_duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end_agrupation - start).count()) / 1.e9;
-        double fd_duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end_face_detection - end_agrupation).count()) / 1.e9;
-        double bb_duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - end_face_detection).count()) / 1.e9;
+    return objects;
+}
 
-        CLI_STDOUT("Object characterization lasted " << std::setprecision(6) << (cl_duration + fd_duration + bb_duration) << "s (clustering: " << cl_duration << "s, face detection:  " << fd_duration << "s, bounding box selection: " << bb_duration << std::setprecision(2) << "s)");
+// Guarda unas características recién construidas salvo que otro hilo las haya construido a la vez, en cuyo caso
+// se conservan las primeras
+template <typename T>
+static std::shared_ptr<const T> publish(std::shared_ptr<const T> &slot, std::shared_ptr<const T> built) {
+    std::shared_ptr<const T> expected;
+    if (!std::atomic_compare_exchange_strong(&slot, &expected, built)) {
+        return expected;
     }
+    return built;
+}
 
-    DEBUG_STDOUT("Characterized object with " << facepoints.size() << " faces");
+std::shared_ptr<const FaceFeatures> CharacterizedObject::getFaceFeatures() const {
+    std::shared_ptr<const FaceFeatures> current = std::atomic_load(&faceFeatures);
+    if (current) {
+        return current;
+    }
+    return publish(faceFeatures, std::shared_ptr<const FaceFeatures>(std::make_shared<FaceFeatures>(faces)));
+}
 
-    return {true, charObject};
+std::shared_ptr<const ConvexHull> CharacterizedObject::getHull() const {
+    std::shared_ptr<const ConvexHull> current = std::atomic_load(&hull);
+    if (current) {
+        return current;
+    }
+    return publish(hull, std::shared_ptr<const ConvexHull>(std::make_shared<ConvexHull>(points.view())));
 }
 
-bool CharacterizedObject::write(const std::string &filename) {
-    std::ofstream outfile(filename);
-    if (outfile.is_open()) {
-        outfile.write((char *)&bbox, sizeof(BBox));  // Bounding box
-        size_t len = points.size();
-        // Puntos
-        outfile.write((char *)&len, sizeof(size_t));  // Numero de puntos
-        for (auto &p : points) {
-            outfile.write((char *)&p, sizeof(Point));  // Índice del punto de la cara
+std::shared_ptr<const ModelFeatures> CharacterizedObject::getFeatures() const {
+    std::shared_ptr<const ModelFeatures> current = std::atomic_load(&features);
+    if (current) {
+        return current;
+    }
+
+    std::shared_ptr<ModelFeatures> built = std::make_shared<ModelFeatures>();
+    built->tree = KDTree(points);
+    built->normals.resize(points.size());
+
+    Point centroid(0., 0., 0.);  // Centroide de los puntos, en el origen si no hay puntos
+    if (points.size() > 0) {
+        double cx = 0., cy = 0., cz = 0.;
+        for (size_t i = 0; i < points.size(); ++i) {
+            cx += points.getX(i);
+            cy += points.getY(i);
+            cz += points.getZ(i);
         }
-        // Caras
-        len = faces.size();
-        outfile.write((char *)&len, sizeof(size_t));  // Numero de caras
-        for (auto &f : faces) {
-            outfile.write((char *)&f.getNormal(), sizeof(Vector));            // Normal de la cara
-            outfile.write((char *)&f.getMinBBox(), sizeof(BBox));             // Bounding box de la cara
-            outfile.write((char *)&f.getMinBBoxRotAngles(), sizeof(Vector));  // Ángulo de rotación de la cara
-            len = f.getIndices().size();
-            outfile.write((char *)&len, sizeof(size_t));  // Numero de puntos de la cara
-            // Indices de los puntos
-            for (auto &idx : f.getIndices()) {
-                outfile.write((char *)&idx, sizeof(size_t));  // Índice del punto de la cara
-            }
+        centroid = Point(cx / points.size(), cy / points.size(), cz / points.size());
+    }
+
+    // Normal del plano de los vecinos más cercanos de cada punto, orientada en sentido contrario al centroide
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Point p = points[i];
+        Vector normal = Geometry::computeNormal(points.view(built->tree.nearestK(p, SURFACE_NORMAL_NEIGHBORS)));
+        if (normal.scalarProduct(p - centroid) < 0) {
+            normal = normal * -1.;
         }
+        built->normals[i] = normal;
+    }
 
-        outfile.close();
-        return !outfile.fail();
+    return publish(features, std::shared_ptr<const ModelFeatures>(built));
+}
 
-    } else {
-        return false;
-    }
+bool CharacterizedObject::write(const std::string &filename) {
+    return ObjectFile::write(filename, points, bbox, faces);
 }
 
 bool CharacterizedObject::writeLivoxCSV(const std::string &filename) {
@@ -224,12 +414,18 @@ bool CharacterizedObject::writeLivoxCSV(const std::string &filename) {
         }
     }
 
+    // Color de cada punto según la cara a la que pertenece
+    std::vector<unsigned> color(points.size(), 0);
+    for (size_t i = 0; i < faces.size(); ++i) {
+        for (auto &idx : faces[i].getIndices()) {
+            color[idx] = i + 1;
+        }
+    }
+
     // Impresión a archivo
     outfile << LidarPoint::LivoxCSVHeader() << "\n";
-    unsigned color;
-    for (auto &p : points) {
-        color = (p.getClusterID() < 0 ? 0 : p.getClusterID() + 1);
-        outfile << LidarPoint(tmstp, colors[color], p).LivoxCSV() << "\n";
+    for (size_t i = 0; i < points.size(); ++i) {
+        outfile << LidarPoint(tmstp, colors[color[i]], points[i]).LivoxCSV() << "\n";
     }
 
     outfile.close();
@@ -238,16 +434,36 @@ bool CharacterizedObject::writeLivoxCSV(const std::string &filename) {
 }
 
 std::pair<bool, CharacterizedObject> CharacterizedObject::load(const std::string &filename) {
+    if (!ObjectFile::isObjectFile(filename)) {
+        return loadLegacy(filename);
+    }
+
+    PointCloud points;
+    BBox bbox;
+    std::vector<Face> faces;
+    if (ObjectFile::read(filename, points, bbox, faces)) {
+        return {true, CharacterizedObject(std::move(points), bbox, std::move(faces))};
+    } else {
+        return {false, CharacterizedObject()};
+    }
+}
+
+bool CharacterizedObject::convert(const std::string &input, const std::string &output) {
+    auto loaded = load(input);
+    return loaded.first && loaded.second.write(output);
+}
+
+std::pair<bool, CharacterizedObject> CharacterizedObject::loadLegacy(const std::string &filename) {
     std::ifstream infile(filename);
     if (infile.is_open()) {
-        BBox bbox;
-        infile.read((char *)&bbox, sizeof(BBox));  // Bounding box
+        BBox bbox = readBBox(infile);  // Bounding box
         size_t nfaces, npoints;
         // Puntos
         infile.read((char *)&npoints, sizeof(size_t));  // Numero de puntos
-        std::vector<Point> points(npoints, Point());
+        PointCloud points;
+        points.reserve(npoints);
         for (size_t i = 0; i < npoints; ++i) {
-            infile.read((char *)&points[i], sizeof(Point));  // Punto de la cara
+            points.push_back(readPoint(infile));  // Punto del objeto
         }
         // Caras
         infile.read((char *)&nfaces, sizeof(size_t));  // Numero de caras
@@ -256,9 +472,9 @@ std::pair<bool, CharacterizedObject> CharacterizedObject::load(const std::string
         BBox fbbox;
         Vector frotdeg;
         for (size_t i = 0; i < nfaces; ++i) {
-            infile.read((char *)&normal, sizeof(Vector));   // Normal de la cara
-            infile.read((char *)&fbbox, sizeof(BBox));      // Bounding box de la cara
-            infile.read((char *)&frotdeg, sizeof(Vector));  // Ángulo de rotación de la cara
+            normal = readPoint(infile);   // Normal de la cara
+            fbbox = readBBox(infile);     // Bounding box de la cara
+            frotdeg = readPoint(infile);  // Ángulo de rotación de la cara
             // Referencias a los puntos de la cara
             infile.read((char *)&npoints, sizeof(size_t));  // Numero de puntos de la cara
             std::vector<size_t> indices(npoints, 0);
@@ -268,13 +484,18 @@ std::pair<bool, CharacterizedObject> CharacterizedObject::load(const std::string
                 indices[j] = index;
             }
 
-            faces[i] = Face(indices, normal, fbbox, frotdeg);
+            // Residuos del ajuste al plano, no almacenados en el archivo
+            std::pair<double, double> residuals = {0., 0.};
+            if (std::all_of(indices.begin(), indices.end(), [&points](size_t idx) { return idx < points.size(); })) {
+                residuals = Geometry::planeResiduals(points, indices, normal);
+            }
+            faces[i] = Face(std::move(indices), normal, fbbox, frotdeg, residuals.first, residuals.second);
         }
 
         infile.close();
-        return {!infile.fail(), CharacterizedObject(points, bbox, faces)};
+        return {!infile.fail(), CharacterizedObject(std::move(points), bbox, std::move(faces))};
 
     } else {
-        return {false, {}};
+        return {false, CharacterizedObject()};
     }
 }
\ No newline at end of file
@@ -9,23 +9,152 @@
 
 #include <utility>
 #include <vector>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <omp.h>
 
 #include "models/Point.hh"
-#include "models/Octree.hh"
-#include "models/Kernel.hh"
+#include "models/PointCloud.hh"
+#include "models/NeighborGraph.hh"
 #include "object_characterization/DBScan.hh"
 #include "models/Geometry.hh"
 
 #include "app/config.h"
 
-std::vector<std::vector<size_t>> DBScan::clusters(std::vector<Point> &points) {
+static_assert(NEIGHBOR_GRAPH_PROXIMITY >= NORMAL_CALC_POINT_PROXIMITY && NEIGHBOR_GRAPH_PROXIMITY >= FACE_POINT_PROXIMITY,
+              "The shared neighbor graph must cover the normal and face radii");
+
+std::vector<std::vector<size_t>> DBScan::clusters(const std::vector<Point> &points) {
+    PointCloud cloud(points);
+    return clusters(cloud);
+}
+
+std::vector<std::vector<size_t>> DBScan::clusters(const PointCloud &points) {
+    std::vector<int> labels;
+    return clusters(points, labels);
+}
+
+std::vector<std::vector<size_t>> DBScan::clusters(const PointCloud &points, std::vector<int> &labels) {
+    NeighborGraph graph(points, CLUSTER_POINT_PROXIMITY);
+    return clusters(graph, labels);
+}
+
+std::vector<std::vector<size_t>> DBScan::clusters(const NeighborGraph &graph, std::vector<int> &labels) {
+    const size_t n = graph.size();
+
+    std::vector<char> core(n, false);             // Puntos core
+    std::vector<char> border(n, false);           // Puntos no core con algún vecino core
+    std::vector<std::atomic<size_t>> parent(n);  // Union-find de los puntos core
+
+#pragma omp parallel
+    {
+        // Identificación de los puntos core
+#pragma omp for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+        for (size_t i = 0; i < n; ++i) {
+            core[i] = graph.neighborsOf(i, CLUSTER_POINT_PROXIMITY).size() >= MIN_CLUSTER_POINTS;
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+        // Implicit barrier
+
+        // Unión de los puntos core vecinos e identificación de los puntos frontera
+#pragma omp for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j : graph.neighborsOf(i, CLUSTER_POINT_PROXIMITY)) {
+                if (core[j]) {
+                    if (core[i]) {
+                        // La relación de vecindad es simétrica: basta con unir en un sentido
+                        if (j < i) {
+                            unite(parent, i, j);
+                        }
+                    } else {
+                        border[i] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Numeración determinista de los clusteres según su punto de menor índice, que es la raíz de su conjunto
+    std::vector<int> rootID(n, cNoise);
+    int numClusters = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (core[i] && findRoot(parent, i) == i) {
+            rootID[i] = numClusters++;
+        }
+    }
+
+    // Cada punto frontera pertenece al cluster vecino de menor raíz, que es el primero en expandirse en la versión secuencial
+    labels.assign(n, cNoise);
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < n; ++i) {
+        if (core[i]) {
+            labels[i] = rootID[findRoot(parent, i)];
+        } else if (border[i]) {
+            int label = numClusters;
+            for (size_t j : graph.neighborsOf(i, CLUSTER_POINT_PROXIMITY)) {
+                if (core[j]) {
+                    label = std::min(label, rootID[findRoot(parent, j)]);
+                }
+            }
+            labels[i] = label;
+        }
+    }
+
+    // Índices de los puntos de cada cluster
+    std::vector<std::vector<size_t>> clusters(numClusters);
+    for (size_t i = 0; i < n; ++i) {
+        if (labels[i] >= 0) {
+            clusters[labels[i]].push_back(i);
+        }
+    }
+
+    return clusters;
+}
+
+size_t DBScan::findRoot(std::vector<std::atomic<size_t>> &parent, size_t i) {
+    // Los padres siempre tienen un índice menor o igual que sus hijos, por lo que el camino termina en la raíz
+    size_t p = parent[i].load(std::memory_order_relaxed);
+    while (p != i) {
+        size_t gp = parent[p].load(std::memory_order_relaxed);
+        if (gp != p) {
+            parent[i].compare_exchange_weak(p, gp, std::memory_order_relaxed);  // Compresión por división a la mitad
+        }
+        i = p;
+        p = parent[i].load(std::memory_order_relaxed);
+    }
+    return i;
+}
+
+void DBScan::unite(std::vector<std::atomic<size_t>> &parent, size_t a, size_t b) {
+    while (true) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b) {
+            return;
+        }
+        if (a < b) {
+            std::swap(a, b);
+        }
+        // Enlace de la raíz mayor con la menor, solo si sigue siendo raíz
+        size_t expected = a;
+        if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+std::vector<std::vector<size_t>> DBScan::sequentialClusters(const PointCloud &points, std::vector<int> &labels) {
     int clusterID = 0;
     std::vector<std::vector<size_t>> clusters;
-    Octree clustermap(points);
+    NeighborGraph graph(points, CLUSTER_POINT_PROXIMITY);
+
+    labels.assign(points.size(), cUnclassified);
 
-    for (auto &p : points) {
-        if (p.getClusterID() == cUnclassified) {
-            std::pair<bool, std::vector<size_t>> expansion = expandCluster(p, clusterID, points, clustermap);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (labels[i] == cUnclassified) {
+            std::pair<bool, std::vector<size_t>> expansion = expandCluster(i, clusterID, labels, graph);
             if (expansion.first) {
                 clusters.push_back(expansion.second);
                 ++clusterID;
@@ -36,12 +165,13 @@ std::vector<std::vector<size_t>> DBScan::clusters(std::vector<Point> &points) {
     return clusters;
 }
 
-std::pair<bool, std::vector<size_t>> DBScan::expandCluster(Point &centroid, int clusterID, std::vector<Point> &points, const Octree &map) {
-    auto clusterSeeds = centroidNeighbours(centroid, points, map);
+std::pair<bool, std::vector<size_t>> DBScan::expandCluster(size_t centroid, int clusterID, std::vector<int> &labels, const NeighborGraph &graph) {
+    auto clusterSeeds = centroidNeighbours(centroid, labels, graph);
 
-    // Centroide no contiene la cantidad mínima de puntos
-    if (clusterSeeds.second.size() < MIN_CLUSTER_POINTS) {
-        centroid.setClusterID(cNoise);
+    // Centroide no es un punto core. Se cuentan todos sus vecinos, incluidos los fronteras de otros clusteres, igual que
+    // para el resto de semillas y en la versión paralela, en lugar de solo los vecinos sin cluster como en la versión original
+    if (clusterSeeds.first < MIN_CLUSTER_POINTS) {
+        labels[centroid] = cNoise;
         return {false, {}};
     }
 
@@ -51,8 +181,8 @@ std::pair<bool, std::vector<size_t>> DBScan::expandCluster(Point &centroid, int
 
         size_t index = 0, indexCorePoint = 0;
         for (auto &i : clusterSeeds.second) {
-            points[i].setClusterID(clusterID);
-            if (points[i] == centroid) {
+            labels[i] = clusterID;
+            if (i == centroid) {
                 indexCorePoint = index;
             }
             ++index;
@@ -61,16 +191,16 @@ std::pair<bool, std::vector<size_t>> DBScan::expandCluster(Point &centroid, int
 
         // Expandimos a través de los puntos vecinos al centroide
         for (size_t i = 0, seedsSize = clusterSeeds.second.size(); i < seedsSize; ++i) {
-            auto clusterNeighbours = centroidNeighbours(points[clusterSeeds.second[i]], points, map);
+            auto clusterNeighbours = centroidNeighbours(clusterSeeds.second[i], labels, graph);
 
             // Comprobación de que no es un punto frontera
             if (clusterNeighbours.first >= MIN_CLUSTER_POINTS) {
                 for (auto &i : clusterNeighbours.second) {
-                    if (points[i].getClusterID() == cUnclassified) {
+                    if (labels[i] == cUnclassified) {
                         clusterSeeds.second.push_back(i);
                         ++seedsSize;
                     }
-                    points[i].setClusterID(clusterID);
+                    labels[i] = clusterID;
 
                     clusterPoints.push_back(i);  // Añadimos punto al vector de indices totales
                 }
@@ -81,36 +211,55 @@ std::pair<bool, std::vector<size_t>> DBScan::expandCluster(Point &centroid, int
     }
 }
 
-std::pair<size_t, std::vector<size_t>> DBScan::centroidNeighbours(const Point &centroid, const std::vector<Point> &points, const Octree &map) {
+std::pair<size_t, std::vector<size_t>> DBScan::centroidNeighbours(size_t centroid, const std::vector<int> &labels, const NeighborGraph &graph) {
     std::vector<size_t> clusterIndex;
 
-    std::vector<Point *> neighbourPoints = map.searchNeighbors(centroid, CLUSTER_POINT_PROXIMITY, Kernel_t::sphere);
+    NeighborRange neighbourPoints = graph.neighborsOf(centroid, CLUSTER_POINT_PROXIMITY);
 
-    for (Point *&np : neighbourPoints) {
-        if (np->getClusterID() < 0) {
-            // A partir del estandar C++0x los elementos de un vector estan contiguos en memoria (menos los tipo bool)
-            // Haciendo uso de aritmetica de punteros le restamos a una dirección de un punto del vector (np) la dirección
-            // inicial (&*points.begin()) obteniendo de esta forma el índice del elemento en tiempo constante sin recurrir
-            // a una búsqueda lineal
-            clusterIndex.push_back((size_t)(np - &*points.begin()));
+    for (size_t i : neighbourPoints) {
+        if (labels[i] < 0) {
+            clusterIndex.push_back(i);
         }
     }
 
     return {neighbourPoints.size(), clusterIndex};
 }
 
-std::vector<std::vector<size_t>> DBScan::normals(std::vector<Point> &points) {
+std::vector<std::vector<size_t>> DBScan::normals(const std::vector<Point> &points) {
+    PointCloud cloud(points);
+    return normals(cloud);
+}
+
+std::vector<std::vector<size_t>> DBScan::normals(const PointCloud &points) {
+    std::vector<int> labels;
+    return normals(points, labels);
+}
+
+std::vector<std::vector<size_t>> DBScan::normals(const PointCloud &points, std::vector<int> &labels) {
+    NeighborGraph graph(points, std::max(NORMAL_CALC_POINT_PROXIMITY, FACE_POINT_PROXIMITY));
+    return normals(points, graph, labels);
+}
+
+std::vector<std::vector<size_t>> DBScan::normals(const PointCloud &points, const NeighborGraph &graph, std::vector<int> &labels) {
     int clusterID = 0;
     std::vector<std::vector<size_t>> faces;
 
-    Octree clustermap(points);
-    std::vector<Vector> normals = Geometry::computeNormals(points, clustermap, NORMAL_CALC_POINT_PROXIMITY);  // Cálculo de las normales
+    std::vector<Vector> normals = Geometry::computeNormals(points, graph, NORMAL_CALC_POINT_PROXIMITY, NORMAL_ESTIMATION_MODE);  // Cálculo de las normales
+
+    labels.assign(points.size(), cUnclassified);
 
+    std::vector<bool> valid(points.size());            // Puntos con normal válida
+    std::vector<bool> assigned(points.size(), false);  // Puntos asignados a una cara
     for (size_t i = 0; i < points.size(); ++i) {
-        if (points[i].getClusterID() == cUnclassified && normals[i] != Vector(0, 0, 0)) {
-            std::pair<bool, std::vector<size_t>> expansion = expandNormalCluster(i, clusterID, points, normals, clustermap);
+        valid[i] = normals[i] != Vector(0, 0, 0);
+    }
+
+    std::vector<size_t> candidates;  // Buffer de vecinos candidatos reutilizado entre expansiones
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (labels[i] == cUnclassified && valid[i]) {
+            std::pair<bool, std::vector<size_t>> expansion = expandNormalCluster(i, clusterID, labels, assigned, valid, normals, graph, candidates);
             if (expansion.first) {
-                faces.push_back(expansion.second);
+                faces.push_back(std::move(expansion.second));
                 ++clusterID;
             }
         }
@@ -119,49 +268,58 @@ std::vector<std::vector<size_t>> DBScan::normals(std::vector<Point> &points) {
     return faces;
 }
 
-std::pair<bool, std::vector<size_t>> DBScan::expandNormalCluster(size_t centroid, int clusterID, std::vector<Point> &points, const std::vector<Vector> &normals, const Octree &map) {
-    auto clusterSeeds = centroidNormalNeighbours(centroid, normals[centroid], points, normals, map);
+std::pair<bool, std::vector<size_t>> DBScan::expandNormalCluster(size_t centroid, int clusterID, std::vector<int> &labels, std::vector<bool> &assigned, const std::vector<bool> &valid,
+                                                                 const std::vector<Vector> &normals, const NeighborGraph &graph, std::vector<size_t> &candidates) {
+    // Suma de las normales de la cara, cuya dirección es la de la normal media
+    std::array<double, 3> normalSum = {normals[centroid].getX(), normals[centroid].getY(), normals[centroid].getZ()};
+
+    centroidNormalNeighbours(centroid, normalSum, assigned, valid, normals, graph, candidates);
 
     // Centroide no contiene la cantidad mínima de puntos
-    if (clusterSeeds.second.size() < MIN_FACE_POINTS) {
-        points[centroid].setClusterID(cNoise);
+    if (candidates.size() < MIN_FACE_POINTS) {
+        labels[centroid] = cNoise;
         return {false, {}};
     }
 
     // Expandimos el cluster
     else {
-        std::vector<size_t> clusterPoints = clusterSeeds.second;
-        std::vector<Vector> clusterNormals;  // Referencias a las normales de los puntos
-        clusterNormals.reserve(clusterSeeds.second.size());
-
-        // Guardado de los puntos iniciales del cluster
-        size_t index = 0, indexCorePoint = 0;
-        for (auto &i : clusterSeeds.second) {
-            points[i].setClusterID(clusterID);
-            clusterNormals.push_back(normals[i]);
-            if (points[i] == points[centroid]) {
-                indexCorePoint = index;
+        std::vector<size_t> clusterPoints;  // Puntos de la cara
+        std::vector<size_t> clusterSeeds;   // Puntos a través de los que se expande la cara
+        clusterPoints.reserve(candidates.size());
+        clusterSeeds.reserve(candidates.size());
+        normalSum = {0, 0, 0};
+
+        // Guardado de los puntos iniciales del cluster, sin el centroide como semilla
+        for (size_t i : candidates) {
+            labels[i] = clusterID;
+            assigned[i] = true;
+            normalSum[0] += normals[i].getX();
+            normalSum[1] += normals[i].getY();
+            normalSum[2] += normals[i].getZ();
+            clusterPoints.push_back(i);
+            if (i != centroid) {
+                clusterSeeds.push_back(i);
             }
-            ++index;
         }
-        clusterSeeds.second.erase(clusterSeeds.second.begin() + indexCorePoint);  // Eliminamos el centroide para el calculo de vecinos
 
         // Expandimos a través de los puntos vecinos al centroide
-        for (size_t i = 0, seedsSize = clusterSeeds.second.size(); i < seedsSize; ++i) {
-            Vector meanNormal = Geometry::mean(clusterNormals);
-            auto clusterNeighbours = centroidNormalNeighbours(clusterSeeds.second[i], meanNormal, points, normals, map);
+        for (size_t s = 0; s < clusterSeeds.size(); ++s) {
+            size_t neighbours = centroidNormalNeighbours(clusterSeeds[s], normalSum, assigned, valid, normals, graph, candidates);
 
             // Comprobación de que no es un punto frontera
-            if (clusterNeighbours.first >= MIN_FACE_POINTS) {
-                for (auto &i : clusterNeighbours.second) {
-                    if (points[i].getClusterID() == cUnclassified) {
-                        clusterSeeds.second.push_back(i);
-                        ++seedsSize;
+            if (neighbours >= MIN_FACE_POINTS) {
+                for (size_t i : candidates) {
+                    if (labels[i] == cUnclassified) {
+                        clusterSeeds.push_back(i);
                     }
-                    points[i].setClusterID(clusterID);
+                    labels[i] = clusterID;
+                    assigned[i] = true;
 
-                    clusterNormals.push_back(normals[i]);  // Añadimos referencia para el calculo de la normal media
-                    clusterPoints.push_back(i);            // Añadimos punto al vector de indices totales
+                    // Actualización incremental de la normal media
+                    normalSum[0] += normals[i].getX();
+                    normalSum[1] += normals[i].getY();
+                    normalSum[2] += normals[i].getZ();
+                    clusterPoints.push_back(i);  // Añadimos punto al vector de indices totales
                 }
             }
         }
@@ -170,30 +328,33 @@ std::pair<bool, std::vector<size_t>> DBScan::expandNormalCluster(size_t centroid
     }
 }
 
-std::pair<size_t, std::vector<size_t>> DBScan::centroidNormalNeighbours(size_t centroid, const Vector &meanNormal, const std::vector<Point> &points, const std::vector<Vector> &normals, const Octree &map) {
-    std::vector<size_t> clusterIndex;
+size_t DBScan::centroidNormalNeighbours(size_t centroid, const std::array<double, 3> &normalSum, const std::vector<bool> &assigned, const std::vector<bool> &valid,
+                                        const std::vector<Vector> &normals, const NeighborGraph &graph, std::vector<size_t> &candidates) {
+    // Umbrales angulares como cosenos, al ser las normales vectores unitarios
+    static const double cosNormal = std::cos(MAX_NORMAL_VECT_ANGLE);
+    static const double cosMean = std::cos(MAX_MEAN_VECT_ANGLE);
+    static const double cosMeanSingle = std::cos(MAX_MEAN_VECT_ANGLE_SINGLE);
+
+    const double cx = normals[centroid].getX(), cy = normals[centroid].getY(), cz = normals[centroid].getZ();
+    const double sumModule = std::sqrt(normalSum[0] * normalSum[0] + normalSum[1] * normalSum[1] + normalSum[2] * normalSum[2]);
+    const double minMean = cosMean * sumModule, minMeanSingle = cosMeanSingle * sumModule;
+
     size_t neighbours = 0;
-    std::vector<Point *> neighbourPoints = map.searchNeighbors(points[centroid], FACE_POINT_PROXIMITY, Kernel_t::sphere);
-
-    size_t i;
-    for (Point *&np : neighbourPoints) {
-        // A partir del estandar C++0x los elementos de un vector estan contiguos en memoria (menos los tipo bool)
-        // Haciendo uso de aritmetica de punteros le restamos a una dirección de un punto del vector (np) la dirección
-        // inicial (&*points.begin()) obteniendo de esta forma el índice del elemento en tiempo constante sin recurrir
-        // a una búsqueda lineal
-        i = (size_t)(np - &*points.begin());
-
-        if (normals[i] != Vector(0, 0, 0) &&
-            ((
-                 normals[centroid].vectorialAngle(normals[i]) <= MAX_NORMAL_VECT_ANGLE &&
-                 meanNormal.vectorialAngle(normals[i]) <= MAX_MEAN_VECT_ANGLE) ||
-             meanNormal.vectorialAngle(normals[i]) <= MAX_MEAN_VECT_ANGLE_SINGLE)) {
-            ++neighbours;
-            if (np->getClusterID() < 0) {
-                clusterIndex.push_back(i);
+    candidates.clear();
+
+    for (size_t i : graph.neighborsOf(centroid, FACE_POINT_PROXIMITY)) {
+        if (valid[i]) {
+            const double nx = normals[i].getX(), ny = normals[i].getY(), nz = normals[i].getZ();
+            const double meanDot = nx * normalSum[0] + ny * normalSum[1] + nz * normalSum[2];
+
+            if ((meanDot >= minMeanSingle || (meanDot >= minMean && nx * cx + ny * cy + nz * cz >= cosNormal)) && sumModule > 0) {
+                ++neighbours;
+                if (!assigned[i]) {
+                    candidates.push_back(i);
+                }
             }
         }
     }
 
-    return {neighbours, clusterIndex};
+    return neighbours;
 }
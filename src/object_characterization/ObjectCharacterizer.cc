@@ -21,6 +21,7 @@
 #include "object_characterization/CharacterizedObject.hh"
 #include "models/LidarPoint.hh"
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
 #include "app/CLI.hh"
 #include "app/config.h"
 
@@ -202,7 +203,7 @@ void ObjectCharacterizer::defineBackground() {
     }
 }
 
-std::pair<bool, CharacterizedObject> ObjectCharacterizer::defineObject() {
+std::pair<bool, PointCloud> ObjectCharacterizer::scanObject() {
     object = {};
 
     state = defObject;
@@ -212,7 +213,7 @@ std::pair<bool, CharacterizedObject> ObjectCharacterizer::defineObject() {
             break;
         case kScanError:
             CLI_STDERR("An error ocurred while scanning: Scan will end");
-            return {false, {}};  // Error de escaneo
+            return {false, PointCloud()};  // Error de escaneo
             break;
         case kScanEof:
             CLI_STDERR("End Of File reached: Scan will end and file will be reset");
@@ -225,16 +226,20 @@ std::pair<bool, CharacterizedObject> ObjectCharacterizer::defineObject() {
     }
 
     // Object points filtering
-    std::vector<Point> filtered;
+    const PointCloud &scanned = object.getPoints();
+    std::vector<char> foreground(scanned.size());
 #pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
-    for (size_t i = 0; i < object.getPoints().size(); ++i) {
-        if (!isBackground(object.getPoints()[i])) {
-#pragma omp critical
-            {
-                filtered.push_back(object.getPoints()[i]);
-            }
+    for (size_t i = 0; i < scanned.size(); ++i) {
+        foreground[i] = !isBackground(scanned[i]);
+    }
+
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < scanned.size(); ++i) {
+        if (foreground[i]) {
+            indices.push_back(i);
         }
     }
+    PointCloud filtered = scanned.subset(indices);
 
     if (chrono) {
         end = std::chrono::high_resolution_clock::now();
@@ -246,7 +251,25 @@ std::pair<bool, CharacterizedObject> ObjectCharacterizer::defineObject() {
 
     CLI_STDOUT("Scanned object contains " << filtered.size() << " unique points (a total of " << object.getPoints().size() << " points were scanned)");
 
-    return CharacterizedObject::parse(filtered, chrono);
+    return {true, std::move(filtered)};
+}
+
+std::pair<bool, CharacterizedObject> ObjectCharacterizer::defineObject() {
+    std::pair<bool, PointCloud> filtered = scanObject();
+    if (!filtered.first) {
+        return {false, CharacterizedObject()};
+    }
+
+    return CharacterizedObject::parse(filtered.second, chrono);
+}
+
+std::vector<CharacterizedObject> ObjectCharacterizer::defineObjects() {
+    std::pair<bool, PointCloud> filtered = scanObject();
+    if (!filtered.first) {
+        return {};
+    }
+
+    return CharacterizedObject::parseAll(filtered.second, chrono);
 }
 
 void ObjectCharacterizer::wait(uint32_t miliseconds) {
@@ -267,4 +290,4 @@ void ObjectCharacterizer::wait(uint32_t miliseconds) {
     }
 }
 
-bool ObjectCharacterizer::isBackground(const Point &p) const { return background.getMap().searchNeighbors(p, backDistance, Kernel_t::sphere).size() > 0; }
\ No newline at end of file
+bool ObjectCharacterizer::isBackground(const Point &p) const { return background.getMap().searchNeighborIndices(p, backDistance, Kernel_t::sphere).size() > 0; }
\ No newline at end of file
@@ -0,0 +1,255 @@
+/**
+ * @file ObjectFile.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del formato de archivo de objetos y modelos ObjectFile
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "object_characterization/ObjectFile.hh"
+#include "object_characterization/Face.hh"
+#include "models/PointCloud.hh"
+#include "models/BBox.hh"
+#include "models/Point.hh"
+
+#include "logging/debug.hh"
+
+// Redondea una posición al siguiente múltiplo del alineamiento de las secciones
+static uint64_t align(uint64_t offset) {
+    return (offset + ObjectFile::kAlignment - 1) / ObjectFile::kAlignment * ObjectFile::kAlignment;
+}
+
+// Comprueba que una sección tiene el tamaño esperado y se encuentra alineada dentro del archivo
+static bool validSection(const ObjectFile::SectionEntry &section, uint64_t size, uint64_t fileSize) {
+    return section.size == size && section.offset % ObjectFile::kAlignment == 0 && section.offset <= fileSize && size <= fileSize - section.offset;
+}
+
+// Proyecta un archivo completo en memoria de solo lectura, que se libera al destruir el último propietario
+static std::shared_ptr<const void> mapFile(const std::string &filename, size_t &size) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return nullptr;
+    }
+    size = st.st_size;
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // La proyección se mantiene tras cerrar el descriptor
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+    return std::shared_ptr<const void>(addr, [size](const void *p) { munmap(const_cast<void *>(p), size); });
+}
+
+uint32_t ObjectFile::crc32(const void *data, size_t size, uint32_t crc) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool ObjectFile::isObjectFile(const std::string &filename) {
+    std::ifstream infile(filename, std::ios::binary);
+    char magic[sizeof(kMagic)];
+    return infile.read(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool ObjectFile::write(const std::string &filename, const PointCloud &points, const BBox &bbox, const std::vector<Face> &faces) {
+    // Registros de las caras con sus índices concatenados
+    std::vector<FaceRecord> records(faces.size());
+    size_t numIndices = 0;
+    for (const Face &f : faces) {
+        numIndices += f.getIndices().size();
+    }
+    std::vector<uint64_t> indices;
+    indices.reserve(numIndices);
+    for (size_t i = 0; i < faces.size(); ++i) {
+        const Face &f = faces[i];
+        FaceRecord &r = records[i];
+        const Point *values[4] = {&f.getNormal(), &f.getMinBBox().getMin(), &f.getMinBBox().getMax(), &f.getMinBBoxRotAngles()};
+        double *fields[4] = {r.normal, r.bboxMin, r.bboxMax, r.rotation};
+        for (int k = 0; k < 4; ++k) {
+            fields[k][0] = values[k]->getX();
+            fields[k][1] = values[k]->getY();
+            fields[k][2] = values[k]->getZ();
+        }
+        r.planeRMS = f.getPlaneRMS();
+        r.planeMaxResidual = f.getPlaneMaxResidual();
+        r.firstIndex = indices.size();
+        r.numIndices = f.getIndices().size();
+        indices.insert(indices.end(), f.getIndices().begin(), f.getIndices().end());
+    }
+
+    // Cabecera
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.headerSize = sizeof(Header);
+    header.numPoints = points.size();
+    header.numFaces = faces.size();
+    header.numIndices = indices.size();
+    const Point &min = bbox.getMin(), &max = bbox.getMax();
+    header.bboxMin[0] = min.getX();
+    header.bboxMin[1] = min.getY();
+    header.bboxMin[2] = min.getZ();
+    header.bboxMax[0] = max.getX();
+    header.bboxMax[1] = max.getY();
+    header.bboxMax[2] = max.getZ();
+
+    // Secciones
+    const void *data[kNumSections] = {points.xData(), points.yData(), points.zData(), records.data(), indices.data()};
+    const uint64_t sizes[kNumSections] = {
+        points.size() * sizeof(float),
+        points.size() * sizeof(float),
+        points.size() * sizeof(float),
+        records.size() * sizeof(FaceRecord),
+        indices.size() * sizeof(uint64_t),
+    };
+    uint64_t offset = sizeof(Header);
+    for (int s = 0; s < kNumSections; ++s) {
+        offset = align(offset);
+        header.sections[s] = {offset, sizes[s], crc32(data[s], sizes[s]), 0};
+        offset += sizes[s];
+    }
+    header.fileSize = offset;
+    header.headerCRC = crc32(&header, sizeof(Header));
+
+    // Escritura de cada bloque con el relleno de alineamiento previo en un archivo temporal, ya que los puntos
+    // pueden ser una proyección del propio archivo de destino y truncarlo invalidaría la memoria que se está leyendo
+    const std::string tmpname = filename + ".tmp";
+    std::ofstream outfile(tmpname, std::ios::binary);
+    if (!outfile.is_open()) {
+        return false;
+    }
+    static const char padding[kAlignment] = {};
+    outfile.write((const char *)&header, sizeof(Header));
+    offset = sizeof(Header);
+    for (int s = 0; s < kNumSections; ++s) {
+        outfile.write(padding, header.sections[s].offset - offset);
+        outfile.write((const char *)data[s], sizes[s]);
+        offset = header.sections[s].offset + sizes[s];
+    }
+    outfile.close();
+    if (outfile.fail() || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+        std::remove(tmpname.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ObjectFile::read(const std::string &filename, PointCloud &points, BBox &bbox, std::vector<Face> &faces, bool verify) {
+    size_t fileSize = 0;
+    std::shared_ptr<const void> mapping = mapFile(filename, fileSize);
+    if (!mapping || fileSize < sizeof(Header)) {
+        return false;
+    }
+    const uint8_t *base = static_cast<const uint8_t *>(mapping.get());
+
+    // Cabecera
+    Header header;
+    std::memcpy(&header, base, sizeof(Header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        return false;
+    }
+    if (header.byteOrder != kByteOrder) {
+        DEBUG_STDERR("Object file " << filename << " was written with a different byte order");
+        return false;
+    }
+    if (header.version != kVersion || header.headerSize != sizeof(Header)) {
+        DEBUG_STDERR("Unsupported object file version " << header.version);
+        return false;
+    }
+    uint32_t crc = header.headerCRC;
+    header.headerCRC = 0;
+    if (crc32(&header, sizeof(Header)) != crc || header.fileSize != fileSize) {
+        DEBUG_STDERR("Corrupted object file header in " << filename);
+        return false;
+    }
+
+    // Secciones
+    if (header.numPoints > fileSize || header.numFaces > fileSize || header.numIndices > fileSize) {
+        return false;
+    }
+    const uint64_t sizes[kNumSections] = {
+        header.numPoints * sizeof(float),
+        header.numPoints * sizeof(float),
+        header.numPoints * sizeof(float),
+        header.numFaces * sizeof(FaceRecord),
+        header.numIndices * sizeof(uint64_t),
+    };
+    for (int s = 0; s < kNumSections; ++s) {
+        const SectionEntry &section = header.sections[s];
+        if (!validSection(section, sizes[s], fileSize)) {
+            DEBUG_STDERR("Invalid section " << s << " in object file " << filename);
+            return false;
+        }
+        if (verify && crc32(base + section.offset, section.size) != section.crc) {
+            DEBUG_STDERR("Corrupted section " << s << " in object file " << filename);
+            return false;
+        }
+    }
+    const FaceRecord *records = reinterpret_cast<const FaceRecord *>(base + header.sections[kSectionFaces].offset);
+    const uint64_t *indices = reinterpret_cast<const uint64_t *>(base + header.sections[kSectionIndices].offset);
+
+    // Caras, copiando en bloque los índices de cada una
+    std::vector<Face> loaded(header.numFaces);
+    for (size_t i = 0; i < header.numFaces; ++i) {
+        const FaceRecord &r = records[i];
+        if (r.firstIndex > header.numIndices || r.numIndices > header.numIndices - r.firstIndex) {
+            return false;
+        }
+        std::vector<size_t> faceIndices(indices + r.firstIndex, indices + r.firstIndex + r.numIndices);
+        if (std::any_of(faceIndices.begin(), faceIndices.end(), [&header](size_t idx) { return idx >= header.numPoints; })) {
+            return false;
+        }
+        loaded[i] = Face(std::move(faceIndices),
+                         Vector(r.normal[0], r.normal[1], r.normal[2]),
+                         BBox(Point(r.bboxMax[0], r.bboxMax[1], r.bboxMax[2]), Point(r.bboxMin[0], r.bboxMin[1], r.bboxMin[2])),
+                         Vector(r.rotation[0], r.rotation[1], r.rotation[2]),
+                         r.planeRMS,
+                         r.planeMaxResidual);
+    }
+
+    // Puntos, usados directamente desde la proyección del archivo
+    const float *xs = reinterpret_cast<const float *>(base + header.sections[kSectionX].offset);
+    const float *ys = reinterpret_cast<const float *>(base + header.sections[kSectionY].offset);
+    const float *zs = reinterpret_cast<const float *>(base + header.sections[kSectionZ].offset);
+    points = PointCloud::external(std::move(mapping), xs, ys, zs, header.numPoints);
+    bbox = BBox(Point(header.bboxMax[0], header.bboxMax[1], header.bboxMax[2]), Point(header.bboxMin[0], header.bboxMin[1], header.bboxMin[2]));
+    faces = std::move(loaded);
+    return true;
+}
@@ -13,6 +13,9 @@
 #include <string>
 #include <functional>
 #include <chrono>
+#include <mutex>
+#include <memory>
+#include <vector>
 
 #include "livox_sdk.h"
 
@@ -22,21 +25,25 @@
 
 #include "logging/debug.hh"
 
+std::vector<std::unique_ptr<ScannerLidar>> ScannerLidar::scanners;
+
 #pragma GCC push_options
 #pragma GCC optimize("O0")
 
 // Obtiene los datos del punto enviado por el sensor
 void getLidarData(uint8_t handle, LivoxEthPacket *data, uint32_t data_num, void *client_data) {
-    if (ScannerLidar::getInstance()->lidar.device_state == kDeviceStateSampling) {
+    ScannerLidar *scanner = client_data ? (ScannerLidar *)client_data : ScannerLidar::find(handle);
+
+    if (scanner && scanner->lidar.device_state == kDeviceStateSampling) {
         // Obtenemos datos
         if (data && data->data_type == kExtendCartesian) {
             LivoxExtendRawPoint *p_data = (LivoxExtendRawPoint *)data->data;
 
             DEBUG_POINT_STDOUT("Point packet of type " << std::to_string(data->data_type) << " retrieved");
 
-            for (uint32_t i = 0; ScannerLidar::getInstance()->scanning && i < data_num; ++i)
-                if (ScannerLidar::getInstance()->callback) {
-                    ScannerLidar::getInstance()->callback({Timestamp(data->timestamp), p_data[i].reflectivity, p_data[i].x, p_data[i].y, p_data[i].z});
+            for (uint32_t i = 0; scanner->scanning && i < data_num; ++i)
+                if (scanner->callback) {
+                    scanner->callback({Timestamp(data->timestamp), p_data[i].reflectivity, p_data[i].x, p_data[i].y, p_data[i].z});
                 }
         }
         // Dato de tipo incorrecto
@@ -54,17 +61,19 @@ void onDeviceBroadcast(const BroadcastDeviceInfo *info) {
         return;
     }
 
-    DEBUG_STDOUT("Retrieved broadcast code " << std::string(ScannerLidar::getInstance()->lidar.info.broadcast_code));
+    DEBUG_STDOUT("Retrieved broadcast code " << std::string(info->broadcast_code));
 
-    if (strncmp(info->broadcast_code, ScannerLidar::getInstance()->lidar.info.broadcast_code, kBroadcastCodeSize) != 0) {
-        DEBUG_STDERR("Retrieved broadcast code do not match stored code");
+    // Buscamos el escaner asociado al sensor
+    ScannerLidar *scanner = ScannerLidar::find(info->broadcast_code);
+    if (!scanner || !scanner->initialized) {
+        DEBUG_STDERR("Retrieved broadcast code do not match any stored code");
         return;
     }
 
     // Conectamos LiDAR
-    if (AddLidarToConnect(info->broadcast_code, &ScannerLidar::getInstance()->lidar.handle) == kStatusSuccess) {
+    if (AddLidarToConnect(info->broadcast_code, &scanner->lidar.handle) == kStatusSuccess) {
         /** Set the point cloud data for a specific Livox LiDAR. */
-        SetDataCallback(ScannerLidar::getInstance()->lidar.handle, getLidarData, NULL);
+        SetDataCallback(scanner->lidar.handle, getLidarData, scanner);
 
     } else {
         DEBUG_STDERR("Unable to connect with LiDAR scanner");
@@ -92,18 +101,18 @@ void onLidarErrorStatusCallback(livox_status status, uint8_t handle, ErrorMessag
 }
 
 // Conecta el sensor
-void lidarConnect(const DeviceInfo *info) {
-    if (ScannerLidar::getInstance()->lidar.device_state == kDeviceStateDisconnect) {
-        ScannerLidar::getInstance()->lidar.device_state = kDeviceStateConnect;
-        ScannerLidar::getInstance()->lidar.info = *info;
+void lidarConnect(ScannerLidar *scanner, const DeviceInfo *info) {
+    if (scanner->lidar.device_state == kDeviceStateDisconnect) {
+        scanner->lidar.device_state = kDeviceStateConnect;
+        scanner->lidar.info = *info;
     }
 }
 
 // Desconecta el sensor
-void lidarDisConnect(const DeviceInfo *info) { ScannerLidar::getInstance()->lidar.device_state = kDeviceStateDisconnect; }
+void lidarDisConnect(ScannerLidar *scanner, const DeviceInfo *info) { scanner->lidar.device_state = kDeviceStateDisconnect; }
 
 // Cambia el la información de estado del sensor
-void lidarStateChange(const DeviceInfo *info) { ScannerLidar::getInstance()->lidar.info = *info; }
+void lidarStateChange(ScannerLidar *scanner, const DeviceInfo *info) { scanner->lidar.info = *info; }
 
 // Callback para cambiar el estado del sensor
 void onDeviceInfoChange(const DeviceInfo *info, DeviceEvent type) {
@@ -112,34 +121,35 @@ void onDeviceInfoChange(const DeviceInfo *info, DeviceEvent type) {
         return;
     }
 
-    // Comprobamos que el handler sea el correcto
-    if (ScannerLidar::getInstance()->lidar.handle != info->handle) {
+    // Buscamos el escaner asociado al handler
+    ScannerLidar *scanner = ScannerLidar::find(info->handle);
+    if (!scanner) {
         DEBUG_STDERR("Handler mismatch");
         return;
     }
 
     if (type == kEventConnect) {
-        lidarConnect(info);
+        lidarConnect(scanner, info);
 
         DEBUG_STDOUT("LiDAR scanner " << std::string(info->broadcast_code) << " connected");
     }
 
     else if (type == kEventDisconnect) {
-        lidarDisConnect(info);
+        lidarDisConnect(scanner, info);
 
         DEBUG_STDOUT("LiDAR scanner " << std::string(info->broadcast_code) << " disconnected");
     }
 
     else if (type == kEventStateChange) {
-        lidarStateChange(info);
+        lidarStateChange(scanner, info);
 
-        DEBUG_STDOUT("Updated LiDAR scanner state [connection: " + std::to_string(ScannerLidar::getInstance()->lidar.device_state) +
-                     "] [state: " + std::to_string(ScannerLidar::getInstance()->lidar.info.state) +
-                     "] [feature: " + std::to_string(ScannerLidar::getInstance()->lidar.info.feature) + "]");
+        DEBUG_STDOUT("Updated LiDAR scanner state [connection: " + std::to_string(scanner->lidar.device_state) +
+                     "] [state: " + std::to_string(scanner->lidar.info.state) +
+                     "] [feature: " + std::to_string(scanner->lidar.info.feature) + "]");
     }
 
-    if (ScannerLidar::getInstance()->lidar.device_state == kDeviceStateConnect) {
-        SetErrorMessageCallback(ScannerLidar::getInstance()->lidar.handle, onLidarErrorStatusCallback);
+    if (scanner->lidar.device_state == kDeviceStateConnect) {
+        SetErrorMessageCallback(scanner->lidar.handle, onLidarErrorStatusCallback);
     }
 }
 
@@ -147,17 +157,22 @@ void onDeviceInfoChange(const DeviceInfo *info, DeviceEvent type) {
 void onSampleCallback(livox_status status, uint8_t handle, uint8_t response, void *data) {
     DEBUG_STDOUT("Point scanning start [status: " << std::to_string(status) << "] [response: " << std::to_string(response) << "]");
 
+    ScannerLidar *scanner = data ? (ScannerLidar *)data : ScannerLidar::find(handle);
+    if (!scanner) {
+        return;
+    }
+
     // Inicio correcto
     if (status == kStatusSuccess) {
-        ScannerLidar::getInstance()->lidar.device_state = kDeviceStateSampling;
+        scanner->lidar.device_state = kDeviceStateSampling;
 
     }
     // Fallo
     else {
         DEBUG_STDERR("Error while starting point scanning");
-        ScannerLidar::getInstance()->lidar.device_state = kDeviceStateDisconnect;
+        scanner->lidar.device_state = kDeviceStateDisconnect;
 
-        ScannerLidar::getInstance()->scanning = false;
+        scanner->scanning = false;
     }
 }
 
@@ -165,18 +180,23 @@ void onSampleCallback(livox_status status, uint8_t handle, uint8_t response, voi
 void onStopSampleCallback(livox_status status, uint8_t handle, uint8_t response, void *data) {
     DEBUG_STDOUT("Ended point scanning [status: " << std::to_string(status) << "] [response: " << std::to_string(response) << "]");
 
+    ScannerLidar *scanner = data ? (ScannerLidar *)data : ScannerLidar::find(handle);
+    if (!scanner) {
+        return;
+    }
+
     // Pausa correcta
     if (status == kStatusSuccess) {
-        ScannerLidar::getInstance()->lidar.device_state = kDeviceStateConnect;
+        scanner->lidar.device_state = kDeviceStateConnect;
 
     }
     // Fallo
     else {
         DEBUG_STDERR("Error while ending point scanning");
-        ScannerLidar::getInstance()->lidar.device_state = kDeviceStateDisconnect;
+        scanner->lidar.device_state = kDeviceStateDisconnect;
     }
 
-    ScannerLidar::getInstance()->scanning = false;
+    scanner->scanning = false;
 }
 
 // Se ejecuta al realizar la peticion de desestimiento de los datos IMU
@@ -204,28 +224,42 @@ void onSetCartesianCoordinateCallback(livox_status status, uint8_t handle, uint8
 }
 
 bool ScannerLidar::init() {
-    DEBUG_STDOUT("Initializing LIVOX SDK");
-
-    // Inicialización de Livox SDK
-    if (!Init()) {
-        DEBUG_STDERR("Error while initializing LIVOX SDK");
+    if (initialized) {
+        DEBUG_STDERR("LiDAR scanner already initialized");
         return false;
     }
-    // Desactivamos logs
-    DisableConsoleLogger();
 
-    // Callback para recibir mensajes de broadcast del Livox LiDAR
-    SetBroadcastCallback(onDeviceBroadcast);
+    std::lock_guard<std::mutex> lock(sdkMutex);
 
-    // Callback para cuando se recibe un cambio de estado (conexión/desconexión/cambio de estado)
-    SetDeviceStateUpdateCallback(onDeviceInfoChange);
+    // El Livox SDK se inicializa una única vez para todos los escaneres
+    if (sdkUsers == 0) {
+        DEBUG_STDOUT("Initializing LIVOX SDK");
 
-    if (!Start()) {
-        DEBUG_STDERR("Error while starting LIVOX SDK");
-        return false;
+        // Inicialización de Livox SDK
+        if (!Init()) {
+            DEBUG_STDERR("Error while initializing LIVOX SDK");
+            return false;
+        }
+        // Desactivamos logs
+        DisableConsoleLogger();
+
+        // Callback para recibir mensajes de broadcast del Livox LiDAR
+        SetBroadcastCallback(onDeviceBroadcast);
+
+        // Callback para cuando se recibe un cambio de estado (conexión/desconexión/cambio de estado)
+        SetDeviceStateUpdateCallback(onDeviceInfoChange);
+
+        if (!Start()) {
+            DEBUG_STDERR("Error while starting LIVOX SDK");
+            Uninit();
+            return false;
+        }
+
+        DEBUG_STDOUT("Initialized LIVOX SDK");
     }
 
-    DEBUG_STDOUT("Initialized LIVOX SDK");
+    ++sdkUsers;
+    initialized = true;
 
     return true;
 }
@@ -237,26 +271,26 @@ ScanCode ScannerLidar::scan() {
         scanning = true;
 
         /* Esperamos a que el sensor esté listo */
-        while (ScannerLidar::getInstance()->lidar.info.state != kLidarStateNormal) {}
+        while (lidar.info.state != kLidarStateNormal) {}
 
         DEBUG_STDOUT("LiDAR scanner ready");
 
         /* Renegamos de la obtención de datos IMU */
-        LidarSetImuPushFrequency(ScannerLidar::getInstance()->lidar.handle, kImuFreq0Hz, onStopIMURecepcionCallback, NULL);
+        LidarSetImuPushFrequency(lidar.handle, kImuFreq0Hz, onStopIMURecepcionCallback, this);
 
         /* Establecemos las cordenadas cartesianas por defecto */
-        SetCartesianCoordinate(ScannerLidar::getInstance()->lidar.handle, onSetCartesianCoordinateCallback, NULL);
+        SetCartesianCoordinate(lidar.handle, onSetCartesianCoordinateCallback, this);
 
         /* Comenzamos el muestreo */
-        if (kStatusSuccess == LidarStartSampling(ScannerLidar::getInstance()->lidar.handle, onSampleCallback, NULL)) {
+        if (kStatusSuccess == LidarStartSampling(lidar.handle, onSampleCallback, this)) {
             while (this->isScanning()) {}  // Esperamos a que finalize de escanear
 
             return ScanCode::kScanOk;
         } else {
             DEBUG_STDERR("Scanner failed to start scanning");
-            return ScanCode::kScanError;
-            
+
             scanning = false;
+            return ScanCode::kScanError;
         }
 
     } else {
@@ -266,9 +300,9 @@ ScanCode ScannerLidar::scan() {
 }
 
 void ScannerLidar::pause() {
-    LidarStopSampling(lidar.handle, onStopSampleCallback, NULL);
+    LidarStopSampling(lidar.handle, onStopSampleCallback, this);
 
-    ScannerLidar::getInstance()->lidar.device_state = kDeviceStateConnect;
+    lidar.device_state = kDeviceStateConnect;
 }
 
 bool ScannerLidar::setCallback(const std::function<void(const LidarPoint &p)> func) {
@@ -279,12 +313,27 @@ bool ScannerLidar::setCallback(const std::function<void(const LidarPoint &p)> fu
 }
 
 void ScannerLidar::stop() {
-    DEBUG_STDOUT("Closing LIVOX SDK");
+    if (!initialized) {
+        return;
+    }
+
+    LidarStopSampling(lidar.handle, onStopSampleCallback, this);
+
+    lidar.handle = DeviceItem::kInvalidHandle;
+    lidar.device_state = kDeviceStateDisconnect;
+    lidar.info.state = kLidarStateUnknown;
+    initialized = false;
 
-    LidarStopSampling(lidar.handle, onStopSampleCallback, NULL);
-    Uninit();
+    std::lock_guard<std::mutex> lock(sdkMutex);
 
-    DEBUG_STDOUT("LIVOX SDK closed");
+    // El último escaner en finalizar cierra el Livox SDK
+    if (--sdkUsers == 0) {
+        DEBUG_STDOUT("Closing LIVOX SDK");
+
+        Uninit();
+
+        DEBUG_STDOUT("LIVOX SDK closed");
+    }
 }
 
 #pragma GCC pop_options
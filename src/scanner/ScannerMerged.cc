@@ -0,0 +1,270 @@
+/**
+ * @file ScannerMerged.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del objeto ScannerMerged
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+
+#include "scanner/ScannerMerged.hh"
+#include "models/LidarPoint.hh"
+#include "models/Geometry.hh"
+#include "models/Point.hh"
+
+#include "logging/debug.hh"
+
+ScannerMerged::ScannerMerged(const std::vector<std::pair<IScanner *, SensorExtrinsic>> &sensors, size_t capacity) : capacity(capacity > 0 ? capacity : 1) {
+    this->sensors.resize(sensors.size());
+
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        const SensorExtrinsic &e = sensors[i].second;
+
+        this->sensors[i].scanner = sensors[i].first;
+        this->sensors[i].rotation = Geometry::rotationMatrix(e.rotation);
+        this->sensors[i].translation = e.translation;
+        this->sensors[i].identity = e.rotation == Vector(0, 0, 0) && e.translation == Vector(0, 0, 0);
+        this->sensors[i].finished = false;
+        this->sensors[i].running = false;
+        this->sensors[i].code = ScanCode::kScanOk;
+    }
+}
+
+bool ScannerMerged::readExtrinsics(const std::string &filename, std::map<std::string, SensorExtrinsic> &extrinsics) {
+    std::ifstream infile(filename, std::ios::in);
+    if (infile.fail()) {
+        DEBUG_STDERR("Unable to open extrinsics file " << filename);
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(infile, line)) {
+        // Líneas vacías y comentarios
+        size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+
+        std::istringstream iss(line);
+        std::string code;
+        double rx, ry, rz, tx, ty, tz;
+        if (!(iss >> code >> rx >> ry >> rz >> tx >> ty >> tz)) {
+            DEBUG_STDERR("Malformed extrinsics line: " << line);
+            return false;
+        }
+
+        extrinsics[code] = {{rx, ry, rz}, {tx, ty, tz}};
+    }
+
+    return true;
+}
+
+bool ScannerMerged::init() {
+    DEBUG_STDOUT("Initializing merged scanner with " << sensors.size() << " sensors");
+
+    if (sensors.empty()) {
+        DEBUG_STDERR("Merged scanner has no sensors");
+        return false;
+    }
+
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        if (!sensors[i].scanner->init()) {
+            DEBUG_STDERR("Error while initializing sensor " << i << " of the merged scanner");
+            return false;
+        }
+        sensors[i].scanner->setCallback([this, i](const LidarPoint &p) { this->push(i, p); });
+        sensors[i].finished = false;
+        sensors[i].buffer.clear();
+    }
+
+    DEBUG_STDOUT("Initialized merged scanner");
+
+    return true;
+}
+
+ScannerMerged::~ScannerMerged() {
+    pause();
+
+    // Un hilo joinable no puede destruirse, por lo que se pausan sus escaneres y se espera a que finalicen
+    std::unique_lock<std::mutex> lock(mutex);
+    for (Sensor &s : sensors) {
+        while (s.running) {
+            lock.unlock();
+            s.scanner->pause();
+            lock.lock();
+            dataReady.wait_for(lock, std::chrono::milliseconds(100), [&] { return !s.running; });
+        }
+    }
+    lock.unlock();
+
+    for (Sensor &s : sensors) {
+        if (s.thread.joinable()) {
+            s.thread.join();
+        }
+    }
+}
+
+void ScannerMerged::push(size_t sensor, const LidarPoint &p) {
+    Sensor &s = sensors[sensor];
+
+    // Transformación al sistema de coordenadas común, fuera de la sección crítica
+    LidarPoint transformed = s.identity ? p : LidarPoint(p.getTimestamp(), p.getReflectivity(), p.rotate(s.rotation) + s.translation);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    spaceReady.wait(lock, [&] { return s.buffer.size() < capacity || !scanning; });
+    s.buffer.push_back(transformed);
+    lock.unlock();
+
+    dataReady.notify_one();
+}
+
+ScanCode ScannerMerged::scan() {
+    DEBUG_STDOUT("Starting point scanning");
+
+    if (scanning) {
+        DEBUG_STDERR("Scanner already in use");
+        return ScanCode::kScanError;
+    }
+
+    scanning = true;
+
+    // Un hilo de escaneo por sensor
+    for (size_t i = 0; i < sensors.size(); ++i) {
+        if (!sensors[i].finished) {
+            sensors[i].running = true;
+            sensors[i].thread = std::thread([this, i]() {
+                ScanCode code = sensors[i].scanner->scan();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    sensors[i].code = code;
+                    sensors[i].running = false;
+                    sensors[i].finished = code != ScanCode::kScanOk || scanning;  // Finalizado sin haber sido pausado
+                }
+                dataReady.notify_all();
+            });
+        }
+    }
+
+    ScanCode result = ScanCode::kScanOk;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // K-way merge de los buffers de reordenación
+    while (scanning) {
+        int next = -1;         // Sensor con el punto más antiguo
+        bool complete = true;  // Todos los sensores activos tienen puntos
+        bool full = false;     // Algún buffer está lleno
+        bool alive = false;    // Algún sensor tiene puntos o sigue escaneando
+
+        for (size_t i = 0; i < sensors.size(); ++i) {
+            const Sensor &s = sensors[i];
+            if (s.buffer.empty()) {
+                complete &= s.finished;
+                alive |= !s.finished;
+            } else {
+                alive = true;
+                full |= s.buffer.size() >= capacity;
+                if (next < 0 || s.buffer.front().getTimestamp() < sensors[next].buffer.front().getTimestamp()) {
+                    next = i;
+                }
+            }
+        }
+
+        // Todos los sensores han finalizado y se han vaciado sus buffers
+        if (!alive) {
+            result = ScanCode::kScanEof;
+            for (const Sensor &s : sensors) {
+                if (s.code == ScanCode::kScanError) {
+                    result = ScanCode::kScanError;
+                }
+            }
+            break;
+        }
+
+        // Emisión del punto más antiguo
+        if (next >= 0 && (complete || full)) {
+            LidarPoint p = sensors[next].buffer.front();
+            sensors[next].buffer.pop_front();
+            lock.unlock();
+            spaceReady.notify_all();
+
+            // Llamada al callback
+            if (this->callback) {
+                this->callback(p);
+            }
+
+            lock.lock();
+        } else {
+            dataReady.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    scanning = false;
+    spaceReady.notify_all();
+
+    // Pausamos los escaneres que sigan activos y esperamos a sus hilos
+    for (Sensor &s : sensors) {
+        while (s.running) {
+            lock.unlock();
+            s.scanner->pause();
+            lock.lock();
+            dataReady.wait_for(lock, std::chrono::milliseconds(100), [&] { return !s.running; });
+        }
+    }
+    lock.unlock();
+
+    for (Sensor &s : sensors) {
+        if (s.thread.joinable()) {
+            s.thread.join();
+        }
+    }
+
+    // Al finalizar todos los escaneres se reinicia la combinación
+    if (result != ScanCode::kScanOk) {
+        for (Sensor &s : sensors) {
+            s.finished = false;
+            s.code = ScanCode::kScanOk;
+        }
+    }
+
+    return result;
+}
+
+void ScannerMerged::pause() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        scanning = false;
+    }
+    spaceReady.notify_all();
+    dataReady.notify_all();
+}
+
+bool ScannerMerged::setCallback(const std::function<void(const LidarPoint &p)> func) {
+    DEBUG_STDOUT("Setting up callback");
+
+    callback = func;
+    return ((bool)callback);
+}
+
+void ScannerMerged::stop() {
+    DEBUG_STDOUT("Closing merged scanner");
+
+    for (Sensor &s : sensors) {
+        s.scanner->stop();
+        s.buffer.clear();
+        s.finished = false;
+    }
+
+    DEBUG_STDOUT("Merged scanner closed");
+}
@@ -0,0 +1,283 @@
+/**
+ * @file ScannerSynthetic.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Implementación del objeto ScannerSynthetic
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+
+#include "scanner/ScannerSynthetic.hh"
+#include "models/LidarPoint.hh"
+#include "models/Timestamp.hh"
+#include "models/Geometry.hh"
+#include "models/Point.hh"
+#include "app/config.h"
+
+#include "logging/debug.hh"
+
+/**
+ * Superficie plana de la escena definida por un origen y dos aristas
+ */
+struct SyntheticSurface {
+    Point origin;                             ///< Esquina de la superficie
+    Vector eu;                                ///< Primera arista
+    Vector ev;                                ///< Segunda arista
+    Vector normal;                            ///< Normal exterior unitaria
+    double area;                              ///< Área (mm²)
+    uint32_t reflectivity;                    ///< Reflectividad de los puntos
+    bool background;                          ///< Superficie del fondo
+    int face;                                 ///< Cara de la caja a la que pertenece
+    const std::vector<SyntheticDent> *dents;  ///< Abolladuras de la caja a la que pertenece
+};
+
+// Componente de un punto en el eje especificado
+static inline double component(const Point &p, int axis) { return axis == 0 ? p.getX() : (axis == 1 ? p.getY() : p.getZ()); }
+
+// Vector unitario del eje especificado
+static inline Vector unit(int axis) { return {axis == 0 ? 1. : 0., axis == 1 ? 1. : 0., axis == 2 ? 1. : 0.}; }
+
+// Obtiene todas las superficies de la escena
+static std::vector<SyntheticSurface> surfaces(const SyntheticScene &scene) {
+    std::vector<SyntheticSurface> result;
+
+    const double d = scene.roomDepth, w = scene.roomWidth, h = scene.roomHeight, s = scene.sensorHeight;
+    const uint32_t r = scene.backgroundReflectivity;
+
+    // Fondo
+    if (scene.floor) {
+        result.push_back({{0., -w / 2, -s}, {d, 0., 0.}, {0., w, 0.}, {0., 0., 1.}, d * w, r, true, -1, nullptr});
+    }
+    if (scene.walls) {
+        result.push_back({{d, -w / 2, -s}, {0., w, 0.}, {0., 0., h}, {-1., 0., 0.}, w * h, r, true, -1, nullptr});
+        result.push_back({{0., w / 2, -s}, {d, 0., 0.}, {0., 0., h}, {0., -1., 0.}, d * h, r, true, -1, nullptr});
+        result.push_back({{0., -w / 2, -s}, {d, 0., 0.}, {0., 0., h}, {0., 1., 0.}, d * h, r, true, -1, nullptr});
+    }
+
+    // Cajas
+    for (const SyntheticBox &box : scene.boxes) {
+        const arma::mat33 rot = Geometry::rotationMatrix(box.rotation);
+        const Vector half = box.dimensions / 2;
+
+        for (int face = 0; face < 6; ++face) {
+            if (box.missingFaces & (1 << face)) {
+                continue;
+            }
+
+            const int a = face / 2, b = (a + 1) % 3, c = (a + 2) % 3;
+            const double sign = face % 2 ? 1. : -1.;
+
+            Point origin = unit(a) * (sign * component(half, a)) - unit(b) * component(half, b) - unit(c) * component(half, c);
+            Vector eu = unit(b) * (2 * component(half, b));
+            Vector ev = unit(c) * (2 * component(half, c));
+
+            result.push_back({box.center + origin.rotate(rot), eu.rotate(rot), ev.rotate(rot), (unit(a) * sign).rotate(rot),
+                              eu.module() * ev.module(), box.reflectivity, false, face, &box.dents});
+        }
+    }
+
+    return result;
+}
+
+double ScannerSynthetic::area(const SyntheticScene &scene, bool background, bool objects) {
+    double total = 0;
+    for (const SyntheticSurface &s : surfaces(scene)) {
+        if (s.background ? background : objects) {
+            total += s.area;
+        }
+    }
+    return total;
+}
+
+std::vector<LidarPoint> ScannerSynthetic::generate(const SyntheticScene &scene, size_t points, bool background, bool objects) {
+    std::vector<SyntheticSurface> all = surfaces(scene);
+
+    // Superficies seleccionadas, manteniendo su índice para que la semilla no dependa de la selección
+    std::vector<size_t> selected;
+    double total = 0;
+    for (size_t i = 0; i < all.size(); ++i) {
+        if (all[i].background ? background : objects) {
+            selected.push_back(i);
+            total += all[i].area;
+        }
+    }
+    if (selected.empty() || total <= 0) {
+        return {};
+    }
+
+    // Reparto de puntos proporcional al área de cada superficie
+    std::vector<size_t> counts(selected.size()), offsets(selected.size());
+    size_t assigned = 0;
+    for (size_t i = 0; i < selected.size(); ++i) {
+        counts[i] = static_cast<size_t>(points * (all[selected[i]].area / total));
+        offsets[i] = assigned;
+        assigned += counts[i];
+    }
+    counts.back() += points - assigned;
+
+    std::vector<LidarPoint> result(points);
+
+#pragma omp parallel for schedule(OMP_SCHEDULE_TYPE, OMP_CHUNK_SIZE)
+    for (size_t i = 0; i < selected.size(); ++i) {
+        const SyntheticSurface &s = all[selected[i]];
+        const double lu = s.eu.module(), lv = s.ev.module();
+
+        std::mt19937 gen(scene.seed + selected[i]);
+        std::uniform_real_distribution<double> uniform(0., 1.);
+        std::normal_distribution<double> gauss(0., scene.noise > 0 ? scene.noise : 1.);
+
+        for (size_t j = 0; j < counts[i]; ++j) {
+            const double u = uniform(gen), v = uniform(gen);
+            Point p = s.origin + s.eu * u + s.ev * v;
+
+            // Abolladuras hacia el interior de la caja
+            if (s.dents) {
+                for (const SyntheticDent &dent : *s.dents) {
+                    if (dent.face == s.face && dent.radius > 0) {
+                        const double du = (u - dent.u) * lu, dv = (v - dent.v) * lv;
+                        const double d2 = (du * du + dv * dv) / (dent.radius * dent.radius);
+                        if (d2 < 1) {
+                            p = p - s.normal * (dent.depth * (1 - d2));
+                        }
+                    }
+                }
+            }
+
+            // Ruido en la distancia al sensor
+            if (scene.noise > 0) {
+                const double range = p.module();
+                if (range > 0) {
+                    p = p + p * (gauss(gen) / range);
+                }
+            }
+
+            result[offsets[i] + j] = LidarPoint(Timestamp(0, 0), s.reflectivity, p);
+        }
+    }
+
+    return result;
+}
+
+bool ScannerSynthetic::init() {
+    DEBUG_STDOUT("Initializing synthetic scanner");
+
+    const double backgroundArea = area(scene, true, false);
+    const double objectArea = area(scene, false, true);
+
+    if (scene.pointRate == 0 || scene.density <= 0 || backgroundArea + objectArea <= 0) {
+        DEBUG_STDERR("Error while initializing synthetic scanner: empty scene");
+        return false;
+    }
+
+    // Densidad en puntos/m², áreas en mm²
+    backgroundCloud = generate(scene, static_cast<size_t>(backgroundArea * scene.density / 1.e6), true, false);
+    std::vector<LidarPoint> objectCloud = generate(scene, static_cast<size_t>(objectArea * scene.density / 1.e6), false, true);
+
+    sceneCloud = backgroundCloud;
+    sceneCloud.insert(sceneCloud.end(), objectCloud.begin(), objectCloud.end());
+
+    if (sceneCloud.empty()) {
+        DEBUG_STDERR("Error while initializing synthetic scanner: scene density too low");
+        return false;
+    }
+
+    // Orden aleatorio para que cualquier intervalo de escaneo cubra toda la escena
+    std::mt19937 gen(scene.seed);
+    std::shuffle(backgroundCloud.begin(), backgroundCloud.end(), gen);
+    std::shuffle(sceneCloud.begin(), sceneCloud.end(), gen);
+
+    uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    startTime = Timestamp(static_cast<uint32_t>(now / NANO_DIGITS), static_cast<uint32_t>(now % NANO_DIGITS));
+    emitted = 0;
+    backgroundOffset = 0;
+    sceneOffset = 0;
+
+    DEBUG_STDOUT("Initialized synthetic scanner with " << backgroundCloud.size() << " background points and " << objectCloud.size() << " object points");
+
+    return true;
+}
+
+ScanCode ScannerSynthetic::scan() {
+    DEBUG_STDOUT("Starting point scanning");
+
+    if (!scanning) {
+        if (!sceneCloud.empty()) {
+            scanning = true;
+            return readData();
+        }
+        // Escena no generada
+        else {
+            DEBUG_STDERR("Synthetic scene was not generated");
+            return ScanCode::kScanError;
+        }
+
+    } else {
+        DEBUG_STDERR("Scanner already in use");
+        return ScanCode::kScanError;
+    }
+}
+
+void ScannerSynthetic::pause() {
+    scanning = false;
+}
+
+bool ScannerSynthetic::setCallback(const std::function<void(const LidarPoint &p)> func) {
+    DEBUG_STDOUT("Setting up callback");
+
+    callback = func;
+    return ((bool)callback);
+}
+
+void ScannerSynthetic::stop() {
+    DEBUG_STDOUT("Closing scanner");
+
+    backgroundCloud = {};
+    sceneCloud = {};
+
+    DEBUG_STDOUT("Scanner closed");
+}
+
+ScanCode ScannerSynthetic::readData() {
+    // Los sensores LIVOX comparten el timestamp entre los puntos de un mismo paquete
+    const uint64_t packetTime = static_cast<uint64_t>(SYNTHETIC_POINTS_PER_PACKET) * NANO_DIGITS / scene.pointRate;
+    const uint64_t objectPoints = static_cast<uint64_t>(scene.objectDelay) * scene.pointRate / 1000;
+    const uint64_t totalPoints = static_cast<uint64_t>(scene.duration) * scene.pointRate / 1000;
+
+    while (scanning) {
+        // Final de la escena
+        if (scene.duration && emitted >= totalPoints) {
+            startTime = startTime + (emitted / SYNTHETIC_POINTS_PER_PACKET + 1) * packetTime;
+            emitted = 0;
+            backgroundOffset = 0;
+            sceneOffset = 0;
+            scanning = false;
+            return ScanCode::kScanEof;
+        }
+
+        const bool onlyBackground = emitted < objectPoints && !backgroundCloud.empty();
+        const std::vector<LidarPoint> &cloud = onlyBackground ? backgroundCloud : sceneCloud;
+        size_t &offset = onlyBackground ? backgroundOffset : sceneOffset;
+
+        // Llamada al callback
+        if (this->callback) {
+            const LidarPoint &p = cloud[offset];
+            this->callback({startTime + (emitted / SYNTHETIC_POINTS_PER_PACKET) * packetTime, p.getReflectivity(), static_cast<const Point &>(p)});
+        }
+
+        if (scanning) {
+            ++emitted;
+            offset = (offset + 1) % cloud.size();
+        }
+    }
+
+    return ScanCode::kScanOk;
+}
@@ -7,11 +7,25 @@
  *
  */
 
+#include <vector>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <limits>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
 #include "catch.hpp"
 #include "catch_utils.hh"
 
 #include "anomaly_detection/AnomalyDetector.hh"
+#include "anomaly_detection/ModelIndex.hh"
 #include "object_characterization/CharacterizedObject.hh"
+#include "scanner/ScannerSynthetic.hh"
 
 class AnomalyFixture {
    public:
@@ -22,10 +36,486 @@ class AnomalyFixture {
                        co2(CharacterizedObject::load("../../test/test_object2").second) {}
 };
 
+class DentedBoxFixture {
+   public:
+    SyntheticScene scene;                                  // Caja de 600x400x500mm sin defectos
+    SyntheticScene dented;                                 // Caja con una abolladura en la cara orientada al sensor
+    SyntheticScene rescanned;                              // Misma caja sin defectos con otro ruido
+    std::pair<bool, CharacterizedObject> model;            // Caja caracterizada
+    std::pair<bool, CharacterizedObject> dentedObject;     // Caja abollada caracterizada
+    std::pair<bool, CharacterizedObject> rescannedObject;  // Nuevo escaneo de la caja sin defectos
+
+    DentedBoxFixture() {
+        scene.boxes.push_back({{3000, 0, -750}, {600, 400, 500}});
+        dented = scene;
+        dented.boxes[0].dents.push_back({0, 0.5, 0.5, 150, 60});  // Cara -x, orientada al sensor
+        rescanned = scene;
+        rescanned.seed = 7;
+
+        model = parse(scene);
+        dentedObject = parse(dented);
+        rescannedObject = parse(rescanned);
+    }
+
+    static std::pair<bool, CharacterizedObject> parse(const SyntheticScene &s, size_t points = 30000) {
+        std::vector<LidarPoint> generated = ScannerSynthetic::generate(s, points, false, true);
+        return CharacterizedObject::parse(std::vector<Point>(generated.begin(), generated.end()), false);
+    }
+};
+
 TEST_CASE_METHOD(AnomalyFixture, "4.1, 4.2", "[AnomalyDetector]") {
     AnomalyDetector adf(false);
     AnomalyDetector adt(true);
 
     CHECK(adf.compare(co1, co1).similar);
     CHECK(!adt.compare(co1, co2).similar);
-}
\ No newline at end of file
+}
+
+// BENCHMARK: Comparación de una caja sintética abollada contra su modelo de 10k a 1M puntos
+TEST_CASE_METHOD(DentedBoxFixture, "4.3", "[.][benchmark][AnomalyDetector]") {
+    AnomalyDetector ad(false);
+
+    std::cout << std::endl
+              << std::setw(10) << "points" << std::setw(16) << "compare (s)" << std::setw(10) << "similar" << std::endl;
+
+    for (size_t n : {10000, 100000, 1000000}) {
+        std::pair<bool, CharacterizedObject> sizedModel = parse(scene, n);
+        std::pair<bool, CharacterizedObject> sizedObject = parse(dented, n);
+        REQUIRE(sizedModel.first);
+        REQUIRE(sizedObject.first);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        AnomalyReport report = ad.compare(sizedObject.second, sizedModel.second);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << std::setw(10) << n << std::setw(16) << std::chrono::duration<double>(end - start).count() << std::setw(10) << report.similar << std::endl;
+    }
+}
+
+// Caras sintéticas con bounding boxes y normales aleatorias
+static std::vector<Face> randomFaces(size_t n, std::mt19937 &gen) {
+    std::uniform_real_distribution<double> side(10, 500), component(-1, 1);
+    std::vector<Face> faces;
+    for (size_t i = 0; i < n; ++i) {
+        faces.push_back(Face({}, Vector(component(gen), component(gen), component(gen)), BBox(Vector(side(gen), side(gen), side(gen) / 50)), Vector(0., 0., 0.)));
+    }
+    return faces;
+}
+
+// Coste total de un emparejamiento de caras
+static double totalCost(const std::vector<Face> &objFaces, const std::vector<Face> &modFaces, const std::vector<std::pair<size_t, size_t>> &matches) {
+    double total = 0;
+    for (const std::pair<size_t, size_t> &match : matches) {
+        total += AnomalyDetector::matchingCost(objFaces[match.first], modFaces[match.second]);
+    }
+    return total;
+}
+
+TEST_CASE("4.4, 4.5", "[AnomalyDetector]") {
+    std::mt19937 gen(7);
+
+    // 4.4 - EL EMPAREJAMIENTO ÓPTIMO COINCIDE CON LA BÚSQUEDA EXHAUSTIVA Y NUNCA ES PEOR QUE EL VORAZ
+    for (size_t n : {1, 3, 5, 6}) {
+        for (size_t m : {1, 4, 6}) {
+            std::vector<Face> objFaces = randomFaces(n, gen), modFaces = randomFaces(m, gen);
+
+            std::vector<std::pair<size_t, size_t>> optimal = AnomalyDetector::matchFaces(objFaces, modFaces, kFaceMatchingOptimal);
+            std::vector<std::pair<size_t, size_t>> greedy = AnomalyDetector::matchFaces(objFaces, modFaces, kFaceMatchingGreedy);
+            REQUIRE(optimal.size() == std::min(n, m));
+            REQUIRE(greedy.size() == std::min(n, m));
+
+            // Cada cara se empareja como mucho una vez
+            std::vector<bool> objUsage(n, false), modUsage(m, false);
+            for (const std::pair<size_t, size_t> &match : optimal) {
+                CHECK(!objUsage[match.first]);
+                CHECK(!modUsage[match.second]);
+                objUsage[match.first] = modUsage[match.second] = true;
+            }
+
+            // Todas las asignaciones de las caras del conjunto menor a caras distintas del mayor
+            double best = std::numeric_limits<double>::infinity();
+            const bool rows = n <= m;
+            std::vector<size_t> perm(std::max(n, m));
+            std::iota(perm.begin(), perm.end(), 0);
+            do {
+                double total = 0;
+                for (size_t k = 0; k < std::min(n, m); ++k) {
+                    total += rows ? AnomalyDetector::matchingCost(objFaces[k], modFaces[perm[k]]) : AnomalyDetector::matchingCost(objFaces[perm[k]], modFaces[k]);
+                }
+                best = std::min(best, total);
+            } while (std::next_permutation(perm.begin(), perm.end()));
+
+            const double optimalCost = totalCost(objFaces, modFaces, optimal);
+            CHECK(std::fabs(optimalCost - best) < 1e-9);
+            CHECK(optimalCost <= totalCost(objFaces, modFaces, greedy) + 1e-9);
+        }
+    }
+
+    // 4.5 - CARAS DE UN MODELO DESORDENADAS EMPAREJADAS CON SU POSICIÓN ORIGINAL
+    std::vector<Face> modFaces = randomFaces(60, gen);
+    std::vector<size_t> order(modFaces.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), gen);
+    std::vector<Face> objFaces;
+    for (size_t i : order) {
+        objFaces.push_back(modFaces[i]);
+    }
+
+    std::vector<std::pair<size_t, size_t>> matches = AnomalyDetector::matchFaces(objFaces, modFaces, kFaceMatchingOptimal);
+    REQUIRE(matches.size() == order.size());
+    for (const std::pair<size_t, size_t> &match : matches) {
+        CHECK(match.second == order[match.first]);
+    }
+}
+
+// BENCHMARK: Emparejamiento voraz y óptimo de las caras de objetos con 10 a 400 caras
+TEST_CASE("4.6", "[.][benchmark][AnomalyDetector]") {
+    std::mt19937 gen(11);
+    std::normal_distribution<double> noise(0, 0.05);
+
+    std::cout << std::endl
+              << std::setw(10) << "faces" << std::setw(16) << "greedy (s)" << std::setw(16) << "optimal (s)"
+              << std::setw(16) << "greedy cost" << std::setw(16) << "optimal cost" << std::endl;
+
+    for (size_t n : {10, 50, 100, 200, 400}) {
+        // Caras del objeto: caras del modelo con ruido en sus dimensiones y normales
+        std::vector<Face> modFaces = randomFaces(n, gen), objFaces;
+        for (const Face &f : modFaces) {
+            const Vector &d = f.getMinBBox().getDelta();
+            const Vector &v = f.getNormal();
+            objFaces.push_back(Face({}, Vector(v.getX() + noise(gen), v.getY() + noise(gen), v.getZ() + noise(gen)),
+                                    BBox(Vector(d.getX() * (1 + noise(gen)), d.getY() * (1 + noise(gen)), d.getZ() * (1 + noise(gen)))), Vector(0., 0., 0.)));
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::pair<size_t, size_t>> greedy = AnomalyDetector::matchFaces(objFaces, modFaces, kFaceMatchingGreedy);
+        auto middle = std::chrono::high_resolution_clock::now();
+        std::vector<std::pair<size_t, size_t>> optimal = AnomalyDetector::matchFaces(objFaces, modFaces, kFaceMatchingOptimal);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << std::setw(10) << n << std::setw(16) << std::chrono::duration<double>(middle - start).count()
+                  << std::setw(16) << std::chrono::duration<double>(end - middle).count()
+                  << std::setw(16) << totalCost(objFaces, modFaces, greedy) << std::setw(16) << totalCost(objFaces, modFaces, optimal) << std::endl;
+    }
+}
+
+TEST_CASE_METHOD(AnomalyFixture, "4.7, 4.8", "[AnomalyDetector]") {
+    // Caja sintética pequeña muy distinta de los objetos de prueba
+    SyntheticScene scene;
+    scene.boxes.push_back({{3000, 0, -750}, {300, 300, 300}});
+    std::vector<LidarPoint> generated = ScannerSynthetic::generate(scene, 5000, false, true);
+    std::pair<bool, CharacterizedObject> box = CharacterizedObject::parse(std::vector<Point>(generated.begin(), generated.end()), false);
+    REQUIRE(box.first);
+
+    std::unordered_map<std::string, Model> models;
+    models.emplace("object1", co1.clone());
+    models.emplace("object2", co2.clone());
+    models.emplace("box", std::move(box.second));
+
+    AnomalyDetector ad(false);
+    ad.setDeviationAnalysis(true);
+    ad.setDistanceMetrics(true);
+    ClassificationReport cr = ad.classify(co1, models);
+
+    // 4.7 - MODELO IDÉNTICO AL OBJETO EN PRIMERA POSICIÓN Y MISMO INFORME QUE LA COMPARACIÓN INDIVIDUAL
+    REQUIRE(cr.models.size() + cr.pruned.size() == models.size());
+    REQUIRE(cr.models.size() == cr.reports.size());
+    REQUIRE(cr.models.size() > 0);
+    CHECK(cr.models[0] == "object1");
+    CHECK(cr.reports[0].similar);
+    for (size_t i = 0; i < cr.models.size(); ++i) {
+        AnomalyReport ar = ad.compare(co1, models.at(cr.models[i]));
+        CHECK(cr.reports[i].similar == ar.similar);
+        CHECK(cr.reports[i].totalAnomalies == ar.totalAnomalies);
+        CHECK(cr.reports[i].deviation.computed == ar.deviation.computed);
+        CHECK(cr.reports[i].distance.computed == ar.distance.computed);
+    }
+    ad.setDeviationAnalysis(false);
+    ad.setDistanceMetrics(false);
+    for (const AnomalyReport &ar : ad.classify(co1, models).reports) {
+        CHECK(!ar.deviation.computed);
+        CHECK(!ar.distance.computed);
+    }
+
+    // 4.8 - MODELO CON BOUNDING BOX MUY DISTINTA DESCARTADO SIN COMPARAR SUS CARAS
+    CHECK(std::find(cr.pruned.begin(), cr.pruned.end(), "box") != cr.pruned.end());
+    CHECK(std::find(cr.models.begin(), cr.models.end(), "box") == cr.models.end());
+}
+
+TEST_CASE("4.9, 4.10", "[ModelIndex]") {
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<double> component(0, 1000);
+
+    // Descriptores aleatorios insertados en orden creciente de la primera componente, el peor caso del árbol
+    std::vector<ModelIndex::Descriptor> descriptors(3000);
+    for (ModelIndex::Descriptor &d : descriptors) {
+        for (double &c : d) {
+            c = component(gen);
+        }
+    }
+    std::sort(descriptors.begin(), descriptors.end());
+
+    ModelIndex index;
+    for (size_t i = 0; i < descriptors.size(); ++i) {
+        index.insert("model-" + std::to_string(i), descriptors[i]);
+    }
+
+    // 4.9 - MISMOS VECINOS MÁS CERCANOS QUE LA BÚSQUEDA EXHAUSTIVA
+    for (int q = 0; q < 50; ++q) {
+        ModelIndex::Descriptor query;
+        for (double &c : query) {
+            c = component(gen);
+        }
+
+        std::vector<double> distances;
+        for (const ModelIndex::Descriptor &d : descriptors) {
+            double sum = 0;
+            for (size_t c = 0; c < d.size(); ++c) {
+                sum += (d[c] - query[c]) * (d[c] - query[c]);
+            }
+            distances.push_back(std::sqrt(sum));
+        }
+        std::sort(distances.begin(), distances.end());
+
+        std::vector<std::pair<std::string, double>> nearest = index.nearest(query, 10);
+        REQUIRE(nearest.size() == 10);
+        for (size_t k = 0; k < nearest.size(); ++k) {
+            CHECK(std::fabs(nearest[k].second - distances[k]) < 1e-9);
+        }
+    }
+
+    // 4.10 - PROFUNDIDAD LOGARÍTMICA TRAS INSERCIONES ORDENADAS
+    CHECK(index.size() == descriptors.size());
+    CHECK(index.depth() <= 2 * std::log2(static_cast<double>(index.size())) + 2);
+}
+
+// Nube de puntos girada sobre el eje z y desplazada
+static PointCloud rigidlyMoved(const PointCloud &points, double degrees, const Vector &shift) {
+    const double c = std::cos(degrees * M_PI / 180), s = std::sin(degrees * M_PI / 180);
+    PointCloud moved;
+    for (size_t i = 0; i < points.size(); ++i) {
+        moved.push_back(Point(c * points.getX(i) - s * points.getY(i) + shift.getX(),
+                              s * points.getX(i) + c * points.getY(i) + shift.getY(),
+                              points.getZ(i) + shift.getZ()));
+    }
+    return moved;
+}
+
+TEST_CASE_METHOD(DentedBoxFixture, "4.11, 4.12", "[AnomalyDetector]") {
+    REQUIRE(model.first);
+
+    // 4.11 - REGISTRO DE UNA COPIA DESPLAZADA DEL MODELO SIN DESVIACIONES
+    CharacterizedObject moved = model.second.clone();
+    moved.setPoints(rigidlyMoved(model.second.getPoints(), 2, Vector(5., -5., 5.)));
+    DeviationReport same = AnomalyDetector::deviations(moved, model.second);
+    REQUIRE(same.computed);
+    CHECK(same.similar);
+    CHECK(same.deviations.size() == moved.getPoints().size());
+    CHECK(same.max < 1);
+    CHECK(same.outliers == 0);
+
+    // 4.12 - DESVIACIONES EN UN OBJETO ABOLLADO, PERO NO EN UN NUEVO ESCANEO DEL MISMO OBJETO
+    REQUIRE(dentedObject.first);
+    REQUIRE(rescannedObject.first);
+
+    DeviationReport dent = AnomalyDetector::deviations(dentedObject.second, model.second);
+    DeviationReport rescan = AnomalyDetector::deviations(rescannedObject.second, model.second);
+    CHECK(!dent.similar);
+    CHECK(dent.max > 30);
+    CHECK(rescan.similar);
+    CHECK(rescan.percentile < DEVIATION_THRESHOLD);
+
+    AnomalyDetector ad(false);
+    ad.setDeviationAnalysis(true);
+    CHECK(!ad.compare(dentedObject.second, model.second).deviation.similar);
+    ad.setDeviationAnalysis(false);
+    CHECK(!ad.compare(dentedObject.second, model.second).deviation.computed);
+}
+
+// BENCHMARK: Análisis de desviaciones y distancias de un objeto de 50k puntos, con y sin construcción del índice del modelo,
+// dentro del tiempo de un fotograma de 100ms de un LIVOX Horizon una vez construido el índice. Las distancias, con su
+// registro, deben costar menos de la mitad que la caracterización del objeto
+TEST_CASE("4.13", "[.][benchmark][AnomalyDetector]") {
+    const double budget = 0.1;
+    SyntheticScene scene;
+    scene.boxes.push_back({{3000, 0, -750}, {600, 400, 500}});
+    std::vector<LidarPoint> generated = ScannerSynthetic::generate(scene, 50000, false, true);
+    std::vector<Point> points(generated.begin(), generated.end());
+
+    auto parseStart = std::chrono::high_resolution_clock::now();
+    std::pair<bool, CharacterizedObject> model = CharacterizedObject::parse(points, false);
+    auto parseEnd = std::chrono::high_resolution_clock::now();
+    REQUIRE(model.first);
+    const double characterization = std::chrono::duration<double>(parseEnd - parseStart).count();
+
+    CharacterizedObject object = model.second.clone();
+    object.setPoints(rigidlyMoved(model.second.getPoints(), 2, Vector(5., -5., 5.)));
+
+    std::cout << std::endl
+              << std::setw(10) << "points" << std::setw(16) << "call" << std::setw(16) << "time (s)" << std::setw(12) << "iterations" << std::endl;
+    std::cout << std::setw(10) << points.size() << std::setw(16) << "characterize" << std::setw(16) << characterization << std::setw(12) << "-" << std::endl;
+
+    for (const char *call : {"first", "cached"}) {
+        auto start = std::chrono::high_resolution_clock::now();
+        DeviationReport report = AnomalyDetector::deviations(object, model.second);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << std::setw(10) << object.getPoints().size() << std::setw(16) << call << std::setw(16) << seconds << std::setw(12) << report.iterations << std::endl;
+        CHECK(report.similar);
+        if (std::string(call) == "cached") {
+            CHECK(seconds < budget);
+        }
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    DistanceReport report = AnomalyDetector::distances(object, model.second);
+    auto end = std::chrono::high_resolution_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << std::setw(10) << object.getPoints().size() << std::setw(16) << "distances" << std::setw(16) << seconds << std::setw(12) << "-" << std::endl;
+    CHECK(report.similar);
+    CHECK(seconds < characterization / 2);
+}
+
+// Distancias de Chamfer y Hausdorff por búsqueda exhaustiva
+static std::pair<double, double> bruteDistances(const PointCloud &a, const PointCloud &b) {
+    auto directed = [](const PointCloud &from, const PointCloud &to, double &sum, double &max) {
+        for (size_t i = 0; i < from.size(); ++i) {
+            double best = std::numeric_limits<double>::infinity();
+            for (size_t j = 0; j < to.size(); ++j) {
+                best = std::min(best, from[i].distance3D(to[j]));
+            }
+            sum += best;
+            max = std::max(max, best);
+        }
+    };
+    double sumA = 0, sumB = 0, max = 0;
+    directed(a, b, sumA, max);
+    directed(b, a, sumB, max);
+    return {(sumA / a.size() + sumB / b.size()) / 2, max};
+}
+
+TEST_CASE_METHOD(DentedBoxFixture, "4.14, 4.15", "[AnomalyDetector]") {
+    REQUIRE(model.first);
+    REQUIRE(dentedObject.first);
+    REQUIRE(rescannedObject.first);
+
+    // 4.14 - DISTANCIAS IGUALES A LAS DE LA BÚSQUEDA EXHAUSTIVA SOBRE LOS MISMOS PUNTOS
+    CharacterizedObject same = model.second.clone();
+    DistanceReport identical = AnomalyDetector::distances(same, model.second);
+    REQUIRE(identical.computed);
+    CHECK(!identical.exceeded);
+    CHECK(identical.similar);
+    CHECK(identical.chamfer < 1e-3);
+    CHECK(identical.hausdorff < 1e-3);
+
+    // Submuestras anidadas del modelo: el registro no mueve el objeto y las distancias se pueden comprobar
+    std::vector<size_t> modIndices, objIndices;
+    for (size_t i = 0; i < model.second.getPoints().size(); i += 20) {
+        modIndices.push_back(i);
+        if (i % 140 == 0) {
+            objIndices.push_back(i);
+        }
+    }
+    CharacterizedObject sparseModel = model.second.clone(), sparseObject = model.second.clone();
+    sparseModel.setPoints(model.second.getPoints().subset(modIndices));
+    sparseObject.setPoints(model.second.getPoints().subset(objIndices));
+    DistanceReport sparse = AnomalyDetector::distances(sparseObject, sparseModel, std::numeric_limits<double>::infinity());
+    std::pair<double, double> brute = bruteDistances(sparseObject.getPoints(), sparseModel.getPoints());
+    REQUIRE(!sparse.exceeded);
+    CHECK(std::fabs(sparse.chamfer - brute.first) < 0.1);
+    CHECK(std::fabs(sparse.hausdorff - brute.second) < 0.1);
+
+    DistanceReport rescan = AnomalyDetector::distances(rescannedObject.second, model.second, std::numeric_limits<double>::infinity());
+    REQUIRE(!rescan.exceeded);
+    CHECK(rescan.similar);
+
+    // 4.15 - PARADA TEMPRANA AL SUPERAR EL UMBRAL DE HAUSDORFF EN UN OBJETO ABOLLADO
+    DistanceReport dent = AnomalyDetector::distances(dentedObject.second, model.second);
+    CHECK(dent.exceeded);
+    CHECK(!dent.similar);
+    CHECK(dent.hausdorff > HAUSDORFF_THRESHOLD);
+    DistanceReport full = AnomalyDetector::distances(dentedObject.second, model.second, std::numeric_limits<double>::infinity());
+    CHECK(!full.exceeded);
+    CHECK(full.hausdorff >= dent.hausdorff - 1e-9);
+    CHECK(full.chamfer > rescan.chamfer);
+}
+
+TEST_CASE_METHOD(DentedBoxFixture, "4.17", "[AnomalyDetector]") {
+    REQUIRE(model.first);
+
+    // Modelo sin los puntos de su cara más grande, como en un escaneo en el que quedase oculta
+    const std::vector<Face> &faces = model.second.getFaces();
+    REQUIRE(faces.size() > 1);
+    const Face &hidden = *std::max_element(faces.begin(), faces.end(), [](const Face &a, const Face &b) { return a.getIndices().size() < b.getIndices().size(); });
+    std::vector<bool> isHidden(model.second.getPoints().size(), false);
+    for (size_t i : hidden.getIndices()) {
+        isHidden[i] = true;
+    }
+    std::vector<size_t> visible;
+    for (size_t i = 0; i < isHidden.size(); ++i) {
+        if (!isHidden[i]) {
+            visible.push_back(i);
+        }
+    }
+    CharacterizedObject occluded = model.second.clone();
+    occluded.setPoints(model.second.getPoints().subset(visible));
+
+    // 4.17 - OBJETO CON UNA CARA OCULTA SIMILAR AL MODELO, AUNQUE AUMENTEN SUS DISTANCIAS SIMÉTRICAS
+    DistanceReport report = AnomalyDetector::distances(occluded, model.second);
+    REQUIRE(report.computed);
+    CHECK(!report.exceeded);
+    CHECK(report.similar);
+    CHECK(report.directedChamfer < 1e-3);
+    CHECK(report.directedHausdorff < 1e-3);
+    CHECK(report.hausdorff > HAUSDORFF_THRESHOLD);
+    CHECK(report.chamfer > CHAMFER_THRESHOLD);
+}
+
+TEST_CASE_METHOD(DentedBoxFixture, "4.16", "[AnomalyDetector]") {
+    REQUIRE(model.first);
+    REQUIRE(dentedObject.first);
+    REQUIRE(rescannedObject.first);
+
+    // Solo el ajuste al plano de las caras, sin registro de los puntos
+    AnomalyDetector ad(false);
+    ad.setDeviationAnalysis(false);
+    ad.setDistanceMetrics(false);
+
+    // 4.16 - CARA ABOLLADA DETECTADA POR SU AJUSTE AL PLANO, PERO NO EN UN NUEVO ESCANEO DEL MISMO OBJETO
+    for (const Face &face : model.second.getFaces()) {
+        if (face.getIndices().size() >= 1000) {  // Caras grandes, poco afectadas por los puntos de las aristas
+            CHECK(face.getPlaneRMS() < scene.noise * 2);
+        }
+    }
+    AnomalyReport rescan = ad.compare(rescannedObject.second, model.second);
+    for (const FaceComparison &fc : rescan.faceComparisons) {
+        if (rescannedObject.second.getFaces()[fc.objectFace].getIndices().size() >= 1000 && model.second.getFaces()[fc.modelFace].getIndices().size() >= 1000) {
+            CHECK(fc.flat);
+        }
+    }
+    AnomalyReport dent = ad.compare(dentedObject.second, model.second);
+    CHECK(std::any_of(dent.faceComparisons.begin(), dent.faceComparisons.end(), [](const FaceComparison &fc) { return !fc.flat; }));
+    CHECK(!dent.similar);
+}
+
+TEST_CASE("4.18", "[ModelIndex]") {
+    // Biblioteca con muchos modelos iguales, como varias copias de una misma pieza, y uno distinto al final
+    ModelIndex::Descriptor same{}, other{};
+    same.fill(100);
+    other.fill(500);
+
+    ModelIndex index;
+    for (size_t i = 0; i < 3000; ++i) {
+        index.insert("copy-" + std::to_string(i), same);
+    }
+    index.insert("other", other);
+
+    // 4.18 - LOS DESCRIPTORES IGUALES NO FORMAN UNA CADENA Y LA BÚSQUEDA SIGUE SIENDO CORRECTA
+    CHECK(index.depth() <= 2 * std::log2(static_cast<double>(index.size())) + 2);
+    std::vector<std::pair<std::string, double>> nearest = index.nearest(other, 3);
+    REQUIRE(nearest.size() == 3);
+    CHECK(nearest[0].first == "other");
+    CHECK(nearest[0].second == 0);
+    CHECK(nearest[1].second == Approx(400 * std::sqrt(static_cast<double>(ModelIndex::kDimensions))));
+}
@@ -11,6 +11,8 @@
 #include "catch_utils.hh"
 
 #include <string>
+#include <vector>
+#include <utility>
 
 #include "app/CLICommand.hh"
 #include "app/ObjectManager.hh"
@@ -45,4 +47,18 @@ TEST_CASE_METHOD(CLIFixture, "5.3, 5.4", "[ObjectManager]") {
     CHECK(r1.second == "object-0");
     // 5.4
     CHECK(r2);
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(CLIFixture, "5.5", "[ObjectManager]") {
+    ObjectManager om;
+    om.newObject("objeto", CharacterizedObject());
+    om.newModel("objeto", "modelo");
+    om.newModel("objeto", "modelo");
+
+    // 5.5 - ÍNDICE DE MODELOS ACTUALIZADO AL CREAR MODELOS
+    REQUIRE(om.getModelIndex().size() == 1);
+    std::vector<std::pair<std::string, double>> nearest = om.getModelIndex().nearest(om.getObjects().at("objeto"), 5);
+    REQUIRE(nearest.size() == 1);
+    CHECK(nearest[0].first == "modelo");
+    CHECK(nearest[0].second == 0);
+}
@@ -11,15 +11,32 @@
 #include "catch_utils.hh"
 
 #include <vector>
+#include <algorithm>
+#include <random>
+#include <numeric>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+#include <memory>
+#include <omp.h>
 
 #include "app/config.h"
 
 #include "models/BBox.hh"
+#include "models/ConvexHull.hh"
 #include "models/Geometry.hh"
 #include "models/Kernel.hh"
+#include "models/KDTree.hh"
+#include "models/NeighborGraph.hh"
 #include "models/Octree.hh"
 #include "models/OctreeMap.hh"
 #include "models/Point.hh"
+#include "models/PointCloud.hh"
+#include "models/TaskGraph.hh"
 #include "models/Timestamp.hh"
 
 class ModelsFixture {
@@ -40,6 +57,32 @@ class ModelsFixture {
     }
 };
 
+// Lleva un punto de una caja de dimensiones size a la cara i % 6, situada a una distancia inset hacia el interior de la
+// caja: el eje perpendicular a la cara toma el valor inset (cara mínima) o size - inset (cara máxima)
+static Point boxSurfacePoint(int i, const Point &p, const Vector &size, double inset = 0) {
+    Point q = p;
+    switch (i % 6) {
+        case 0:
+            q.setX(inset);
+            break;
+        case 1:
+            q.setX(size.getX() - inset);
+            break;
+        case 2:
+            q.setY(inset);
+            break;
+        case 3:
+            q.setY(size.getY() - inset);
+            break;
+        case 4:
+            q.setZ(inset);
+            break;
+        default:
+            q.setZ(size.getZ() - inset);
+    }
+    return q;
+}
+
 TEST_CASE_METHOD(ModelsFixture, "2.1, 2.2, 2.3", "[BBox]") {
     std::vector<Point> vv, v2;
     v2.push_back({2, 2, 2});
@@ -164,4 +207,582 @@ TEST_CASE_METHOD(ModelsFixture, "2.19, 2.20", "[Octree][OctreeMap]") {
     CHECK(oc.searchNeighbors(Point(0, 5, 5), 1.01, Kernel_t::sphere).size() == (4 + 1));
     // 2.20
     CHECK(om.getPoints().size() == 1);
-}
\ No newline at end of file
+}
+TEST_CASE_METHOD(ModelsFixture, "2.21", "[Point]") {
+    Point p(1234.5678, -2345.25, 0.125);
+    PointCloud cloud;
+    cloud.push_back(p);
+
+    // 2.21 - PUNTO EN PRECISIÓN DOBLE Y NUBE COMPACTA CON PRECISIÓN SUBMILIMÉTRICA
+    CHECK(p.getX() == 1234.5678);
+    CHECK(p != Point(1234.5678 + 1e-9, -2345.25, 0.125));
+    CHECK(std::fabs(cloud.getX(0) - 1234.5678) < 1e-3);
+    CHECK(cloud.getY(0) == -2345.25);
+    CHECK(cloud.getZ(0) == 0.125);
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.22, 2.23, 2.24", "[PointCloud][Octree]") {
+    PointCloud cloud(xplane);
+    std::vector<size_t> indices = {5, 10, 15};
+    PointCloudView view = cloud.view(indices);
+    PointCloud sub = view.subset();
+    PointCloud copy = cloud.clone();
+    copy.set(0, Point(1, 1, 1));
+
+    // 2.22 - VISTAS Y SUBCONJUNTOS SIN ALTERAR LA NUBE ORIGINAL
+    REQUIRE(sub.size() == 3);
+    CHECK(sub[1] == xplane[10]);
+    CHECK(view.index(2) == 15);
+    CHECK(cloud.view(90, 100).size() == 10);
+    CHECK(cloud[0] == xplane[0]);
+    CHECK(copy[0] == Point(1, 1, 1));
+    // 2.23 - OCTREE POR ÍNDICES EQUIVALENTE AL OCTREE DE PUNTOS
+    Octree oc(cloud);
+    CHECK(oc.searchNeighborIndices(Point(0, 5, 5), 1.01, Kernel_t::sphere).size() == (4 + 1));
+    // 2.24
+    CHECK(BBox(cloud.view()).getDelta() == BBox(xplane).getDelta());
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.25, 2.26", "[NeighborGraph]") {
+    PointCloud cloud(xplane);
+    Octree oc(cloud);
+    NeighborGraph graph(cloud, oc, 3.01);
+
+    // 2.25 - VECINDARIOS DE MENOR RADIO IGUALES A LAS BÚSQUEDAS EN EL OCTREE
+    for (double r : {1.01, 2.01, 3.01}) {
+        for (size_t i = 0; i < cloud.size(); ++i) {
+            NeighborRange range = graph.neighborsOf(i, r);
+            std::vector<size_t> filtered(range.begin(), range.end());
+            std::vector<size_t> searched = oc.searchNeighborIndices(cloud[i], r, Kernel_t::sphere);
+            std::sort(filtered.begin(), filtered.end());
+            std::sort(searched.begin(), searched.end());
+            CHECK(filtered == searched);
+        }
+    }
+    // 2.26 - NORMALES SOBRE LAS FILAS DEL GRAFO IGUALES A LAS DE CADA VECINDARIO POR SEPARADO
+    std::vector<Vector> normals = Geometry::computeNormals(cloud, graph, 2.01, kNormalExact);
+    REQUIRE(normals.size() == cloud.size());
+    for (size_t i = 0; i < cloud.size(); ++i) {
+        NeighborRange range = graph.neighborsOf(i, 2.01);
+        std::vector<size_t> neighbours(range.begin(), range.end());
+        Vector normal = Geometry::computeNormal(cloud.view(neighbours));
+        if (normal.getX() < 0) {
+            normal = normal * -1;
+        }
+        CHECK((normals[i] - normal).module() < 1e-12);
+    }
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.27", "[Geometry]") {
+    // Plano inclinado con un ligero ruido pseudoaleatorio en la dirección de su normal
+    Vector expected = Vector(1, 2, 3) / Vector(1, 2, 3).module();
+    Vector u = expected.crossProduct(Vector(0, 0, 1));
+    u = u / u.module();
+    Vector w = expected.crossProduct(u);
+    std::vector<Point> tilted;
+    for (int i = 0; i < 400; ++i) {
+        tilted.push_back(Point(1000, 500, -200) + u * (i % 20 * 5.) + w * (i / 20 * 5.) + expected * (((i * 7919) % 13) / 13. - 0.5));
+    }
+    PointCloud cloud(tilted);
+
+    Vector svd = Geometry::computeNormal(tilted);
+    Vector eigen = Geometry::computeNormal(cloud.view());
+
+    // 2.27 - NORMAL POR COVARIANZA Y JACOBI EQUIVALENTE A LA NORMAL POR SVD
+    CHECK(std::fabs(eigen.module() - 1) < 1e-6);
+    CHECK(std::fabs(std::fabs(eigen.scalarProduct(svd)) - 1) < 1e-6);
+    CHECK(std::fabs(std::fabs(eigen.scalarProduct(expected)) - 1) < 1e-3);
+    CHECK(Geometry::computeNormal(PointCloud(xplane).view()) == Point(1, 0, 0));
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.28", "[Geometry]") {
+    PointCloud cloud;
+    for (int i = 0; i < 2500; ++i) {
+        cloud.push_back(Point(3000, i / 50 * 4, i % 50 * 4));
+    }
+    NeighborGraph graph(cloud, 20.01);
+
+    std::vector<Vector> exact = Geometry::computeNormals(cloud, graph, 20.01, kNormalExact);
+    std::vector<Vector> voxel = Geometry::computeVoxelNormals(cloud, 20.01);
+
+    // 2.28 - NORMALES POR MOMENTOS DE VÓXELES IGUALES A LAS EXACTAS EN UN PLANO
+    REQUIRE(voxel.size() == cloud.size());
+    for (size_t i = 0; i < cloud.size(); ++i) {
+        CHECK(exact[i] == Point(1, 0, 0));
+        CHECK(voxel[i] == Point(1, 0, 0));
+    }
+    CHECK(Geometry::computeNormals(cloud, graph, 20.01, kNormalVoxel) == exact);  // Nube por debajo de NORMAL_VOXEL_MIN_POINTS
+}
+
+TEST_CASE("2.29", "[.][benchmark][Geometry]") {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> uniform(0., 500.);
+    std::normal_distribution<double> noise(0., 2.);
+
+    std::cout << std::endl
+              << std::setw(10) << "points" << std::setw(16) << "exact (s)" << std::setw(16) << "voxel (s)" << std::setw(16) << "error (deg)" << std::endl;
+
+    // Tres caras de una caja de 500mm con densidad creciente
+    for (size_t n : {5000, 20000, 60000}) {
+        PointCloud cloud;
+        cloud.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            double a = uniform(gen), b = uniform(gen);
+            switch (i % 3) {
+                case 0:
+                    cloud.push_back(Point(3000 + a, b, 500 + noise(gen)));
+                    break;
+                case 1:
+                    cloud.push_back(Point(3000 + noise(gen), a, b));
+                    break;
+                default:
+                    cloud.push_back(Point(3000 + a, noise(gen), b));
+            }
+        }
+        NeighborGraph graph(cloud, NORMAL_CALC_POINT_PROXIMITY);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<Vector> exact = Geometry::computeNormals(cloud, graph, NORMAL_CALC_POINT_PROXIMITY, kNormalExact);
+        auto middle = std::chrono::high_resolution_clock::now();
+        std::vector<Vector> voxel = Geometry::computeNormals(cloud, graph, NORMAL_CALC_POINT_PROXIMITY, kNormalVoxel);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        // Error angular medio de las normales aproximadas
+        double error = 0;
+        for (size_t i = 0; i < n; ++i) {
+            error += std::acos(std::min(1., std::fabs(exact[i].scalarProduct(voxel[i])))) / RAD_PER_DEG;
+        }
+
+        std::cout << std::setw(10) << n << std::setw(16) << std::chrono::duration<double>(middle - start).count()
+                  << std::setw(16) << std::chrono::duration<double>(end - middle).count() << std::setw(16) << error / n << std::endl;
+
+        CHECK(error / n < 5);
+    }
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.30, 2.31", "[ConvexHull]") {
+    // Vértices de un cubo de 100mm junto con puntos interiores y sobre sus caras
+    std::vector<Point> cube;
+    for (int i = 0; i < 8; ++i) {
+        cube.push_back(Point(i & 1 ? 100 : 0, i & 2 ? 100 : 0, i & 4 ? 100 : 0));
+    }
+    for (int i = 0; i < 500; ++i) {
+        cube.push_back(Point(i * 37 % 100, i * 53 % 100, i % 3 ? i * 71 % 100 : 100));
+    }
+    ConvexHull hull(cube);
+
+    // 2.30 - LA ENVOLVENTE DE UN CUBO CONTIENE SOLO SUS VÉRTICES Y TODOS LOS PUNTOS QUEDAN EN SU INTERIOR
+    REQUIRE(!hull.isDegenerate());
+    CHECK(hull.getVertices().size() == 8);
+    CHECK(hull.getFaces().size() == 12);
+    for (size_t v = 0; v < hull.getVertices().size(); ++v) {
+        CHECK(hull.getIndices()[v] < 8);
+    }
+    for (size_t f = 0; f < hull.getFaces().size(); ++f) {
+        const Point &origin = hull.getVertices()[hull.getFaces()[f][0]];
+        for (const Point &p : cube) {
+            CHECK(hull.getNormals()[f].scalarProduct(p - origin) < 1e-6);
+        }
+    }
+
+    // 2.31 - LA ENVOLVENTE DE PUNTOS COPLANARES ES DEGENERADA
+    ConvexHull flat(xplane);
+    CHECK(flat.isDegenerate());
+    CHECK(flat.getVertices().size() == xplane.size());
+    CHECK(flat.getFaces().empty());
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.32, 2.33", "[Geometry]") {
+    // Superficie de una caja de 300x120x40mm girada arbitrariamente
+    arma::mat33 rot = Geometry::rotationMatrix(25, 40, 70);
+    std::vector<Point> box;
+    for (int i = 0; i < 3000; ++i) {
+        Point p = boxSurfacePoint(i, Point(i * 37 % 300, i * 53 % 120, i * 71 % 40), Vector(300, 120, 40));
+        box.push_back(p.rotate(rot) + Point(1000, 200, 300));
+    }
+    PointCloud cloud(box);
+
+    // 2.32 - DESCOMPOSICIÓN DE UNA MATRIZ DE ROTACIÓN EN SUS ÁNGULOS
+    Vector angles = Geometry::rotationAngles(rot);
+    CHECK(std::fabs(angles.getX() - 25) < 1e-6);
+    CHECK(std::fabs(angles.getY() - 40) < 1e-6);
+    CHECK(std::fabs(angles.getZ() - 70) < 1e-6);
+
+    std::pair<BBox, Vector> hull = Geometry::minimumBBox(cloud.view(), kBBoxHullSearch);
+    std::pair<BBox, Vector> grid = Geometry::minimumBBox(cloud.view(), kBBoxGridSearch);
+
+    // 2.33 - BBOX MÍNIMA POR ENVOLVENTE CONVEXA AJUSTADA A LAS DIMENSIONES REALES Y NO PEOR QUE LA BÚSQUEDA EN REJILLA
+    Vector delta = hull.first.getDelta();
+    CHECK(std::fabs(delta.getX() - 40) < 1);
+    CHECK(std::fabs(delta.getY() - 120) < 1);
+    CHECK(std::fabs(delta.getZ() - 300) < 1);
+    Vector gdelta = grid.first.getDelta();
+    CHECK(delta.getX() * delta.getY() * delta.getZ() <= gdelta.getX() * gdelta.getY() * gdelta.getZ() + 1);
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.34, 2.35", "[ConvexHull][Geometry]") {
+    // Nube densa con forma de cilindro achatado
+    PointCloud cloud;
+    for (int i = 0; i < 5000; ++i) {
+        double angle = i * 0.7 * RAD_PER_DEG, radius = 10 + i % 90;
+        cloud.push_back(Point(500 + radius * std::cos(angle), -300 + radius * std::sin(angle), i % 37 * 1.));
+    }
+    ConvexHull hull(cloud);
+    PointCloud vertices(hull.getVertices());
+
+    // 2.34 - LOS VÉRTICES DE LA ENVOLVENTE DEFINEN LA MISMA BOUNDING BOX QUE TODOS LOS PUNTOS EN CUALQUIER ROTACIÓN
+    CHECK(vertices.size() < cloud.size() / 4);
+    for (int angle = 0; angle < 90; angle += 15) {
+        arma::mat33 rot = Geometry::rotationMatrix(angle, 2 * angle, 90 - angle);
+        BBox all(cloud, rot), reduced(vertices, rot);
+        CHECK(all.getMin() == reduced.getMin());
+        CHECK(all.getMax() == reduced.getMax());
+    }
+
+    // 2.35 - ACTUALIZACIÓN DE LA ENVOLVENTE TRAS UNA TRANSFORMACIÓN RÍGIDA DE LOS PUNTOS
+    arma::mat33 rot = Geometry::rotationMatrix(30, 0, 45);
+    for (size_t i = 0; i < cloud.size(); ++i) {
+        cloud.set(i, cloud[i].rotate(rot) + Point(10, 20, 30));
+    }
+    hull.update(cloud);
+    for (size_t v = 0; v < hull.getVertices().size(); ++v) {
+        CHECK(hull.getVertices()[v] == cloud[hull.getIndices()[v]]);
+    }
+    for (size_t f = 0; f < hull.getFaces().size(); ++f) {
+        const Point &origin = hull.getVertices()[hull.getFaces()[f][0]];
+        CHECK(std::fabs(hull.getNormals()[f].module() - 1) < 1e-6);
+        for (size_t i = 0; i < cloud.size(); i += 50) {
+            CHECK(hull.getNormals()[f].scalarProduct(cloud[i] - origin) < 1e-3);
+        }
+    }
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.36", "[Geometry]") {
+    PointCloud cloud;
+    for (int i = 0; i < 1000; ++i) {
+        cloud.push_back(Point(i * 37 % 250, i * 53 % 90, i * 71 % 30) + Point(-100, 400, 2000));
+    }
+    std::vector<arma::mat33> rotations;
+    for (int i = 0; i < 90; i += 7) {
+        rotations.push_back(Geometry::rotationMatrix(i, 90 - i, i / 2));
+    }
+
+    std::vector<BBox> batched = Geometry::rotatedBBoxes(cloud, rotations);
+
+    // 2.36 - BOUNDING BOXES POR LOTES DE ROTACIONES IGUALES A LAS CALCULADAS PUNTO A PUNTO
+    REQUIRE(batched.size() == rotations.size());
+    for (size_t r = 0; r < rotations.size(); ++r) {
+        BBox single(cloud, rotations[r]);
+        CHECK((batched[r].getMin() - single.getMin()).module() < 1e-3);
+        CHECK((batched[r].getMax() - single.getMax()).module() < 1e-3);
+    }
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.37", "[Geometry]") {
+    // Caras de un prisma de 200x80x50mm ligeramente rugosas, girado arbitrariamente
+    arma::mat33 rot = Geometry::rotationMatrix(10, 35, 60);
+    PointCloud cloud;
+    std::vector<std::vector<size_t>> faces(6);
+    for (int i = 0; i < 3000; ++i) {
+        double noise = (i * 7919 % 11) / 10.;
+        faces[i % 6].push_back(cloud.size());
+        cloud.push_back(boxSurfacePoint(i, Point(i * 37 % 200, i * 53 % 80, i * 71 % 50), Vector(200, 80, 50), noise).rotate(rot));
+    }
+    std::vector<PointCloudView> views;
+    for (const std::vector<size_t> &face : faces) {
+        views.push_back(cloud.view(face));
+    }
+
+    // Búsqueda de referencia secuencial sobre todos los puntos: rotaciones cada 6º de 0 a 89º y refinamiento cada 1º
+    // alrededor de la mejor, calculando cada bounding box punto a punto
+    auto reference = [](const PointCloudView &points) {
+        BBox best(points);
+        int angles[3] = {0, 0, 0};
+        for (int step : {6, 1}) {
+            const int x = angles[0], y = angles[1], z = angles[2];
+            for (int i = step == 6 ? 0 : x - 5; i <= (step == 6 ? 89 : x + 5); i += step) {
+                for (int j = step == 6 ? 0 : y - 5; j <= (step == 6 ? 89 : y + 5); j += step) {
+                    for (int k = step == 6 ? 0 : z - 5; k <= (step == 6 ? 89 : z + 5); k += step) {
+                        BBox bbox(points, Geometry::rotationMatrix(i, j, k));
+                        if (bbox < best) {
+                            best = bbox;
+                            angles[0] = i, angles[1] = j, angles[2] = k;
+                        }
+                    }
+                }
+            }
+        }
+        return best;
+    };
+
+    std::vector<std::pair<BBox, Vector>> joint = Geometry::gridSearch(views, {{6, 1.}, {1, 1.}});
+
+    // 2.37 - BÚSQUEDA EN REJILLA CONJUNTA DE VARIAS CARAS CON EL MISMO VOLUMEN QUE LA BÚSQUEDA SECUENCIAL DE REFERENCIA
+    REQUIRE(joint.size() == views.size());
+    for (size_t v = 0; v < views.size(); ++v) {
+        BBox expected = reference(views[v]);
+        CHECK(std::fabs(joint[v].first.volume() - expected.volume()) <= 1e-6 * expected.volume());
+        CHECK(std::fabs(BBox(views[v], Geometry::rotationMatrix(joint[v].second)).volume() - joint[v].first.volume()) <= 1e-6 * expected.volume());
+    }
+}
+
+TEST_CASE_METHOD(ModelsFixture, "2.38", "[Geometry]") {
+    // Superficie densa de un prisma de 250x100x60mm girado arbitrariamente
+    arma::mat33 rot = Geometry::rotationMatrix(20, 50, 75);
+    PointCloud cloud;
+    for (int i = 0; i < 12000; ++i) {
+        cloud.push_back(boxSurfacePoint(i, Point(i * 37 % 250, i * 53 % 100, i * 71 % 60), Vector(250, 100, 60)).rotate(rot));
+    }
+
+    std::pair<BBox, Vector> exhaustive = Geometry::gridSearch({cloud.view()}, {{6, 1.}, {1, 1.}})[0];
+    std::pair<BBox, Vector> scheduled = Geometry::gridSearch({cloud.view()}, {{6, 0.05}, {2, 0.25}, {1, 1.}})[0];
+
+    // 2.38 - BÚSQUEDA MULTIRRESOLUCIÓN SOBRE SUBMUESTRAS CERCANA A LA BÚSQUEDA EXHAUSTIVA Y EVALUADA SOBRE TODOS LOS PUNTOS
+    CHECK(scheduled.first.volume() <= exhaustive.first.volume() * 1.01);
+    CHECK((scheduled.first.getDelta() - BBox(cloud, Geometry::rotationMatrix(scheduled.second)).getDelta()).module() < 1e-3);
+}
+
+TEST_CASE("2.39", "[.][benchmark][Geometry]") {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> uniform(0., 1.);
+    std::normal_distribution<double> noise(0., 1.);
+    const std::vector<GridStage> exhaustive = {{6, 1.}, {1, 1.}}, scheduled = {{6, 0.05}, {2, 0.25}, {1, 1.}};
+
+    std::cout << std::endl
+              << std::setw(10) << "points" << std::setw(18) << "exhaustive (s)" << std::setw(18) << "schedule (s)"
+              << std::setw(18) << "mean error (%)" << std::setw(18) << "max error (%)" << std::endl;
+
+    // Error relativo del volumen frente a la búsqueda exhaustiva sobre cajas de dimensiones y orientaciones aleatorias
+    for (size_t n : {2000, 20000, 100000}) {
+        double exhaustiveTime = 0, scheduledTime = 0, meanError = 0, maxError = 0;
+        const int objects = 8;
+        for (int o = 0; o < objects; ++o) {
+            double a = 100 + 400 * uniform(gen), b = 50 + 300 * uniform(gen), c = 20 + 200 * uniform(gen);
+            arma::mat33 rot = Geometry::rotationMatrix(90 * uniform(gen), 90 * uniform(gen), 90 * uniform(gen));
+            PointCloud cloud;
+            cloud.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                double x = a * uniform(gen), y = b * uniform(gen), z = c * uniform(gen);
+                double nx = noise(gen), ny = noise(gen), nz = noise(gen);
+                cloud.push_back((boxSurfacePoint(i, Point(x, y, z), Vector(a, b, c)) + Point(nx, ny, nz)).rotate(rot));
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            std::pair<BBox, Vector> reference = Geometry::gridSearch({cloud.view()}, exhaustive)[0];
+            auto middle = std::chrono::high_resolution_clock::now();
+            std::pair<BBox, Vector> result = Geometry::gridSearch({cloud.view()}, scheduled)[0];
+            auto end = std::chrono::high_resolution_clock::now();
+
+            exhaustiveTime += std::chrono::duration<double>(middle - start).count();
+            scheduledTime += std::chrono::duration<double>(end - middle).count();
+            double error = 100 * (result.first.volume() / reference.first.volume() - 1);
+            meanError += error;
+            maxError = std::max(maxError, error);
+        }
+
+        std::cout << std::setw(10) << n << std::setw(18) << exhaustiveTime / objects << std::setw(18) << scheduledTime / objects
+                  << std::setw(18) << meanError / objects << std::setw(18) << maxError << std::endl;
+
+        CHECK(maxError < 5);
+    }
+}
+
+TEST_CASE("2.40, 2.41, 2.42", "[TaskGraph]") {
+    // Grafo en rombo: a -> {b, c} -> d, con b como rama más lenta
+    TaskGraph graph;
+    std::mutex mutex;
+    std::vector<TaskGraph::TaskID> order;
+    auto task = [&](TaskGraph::TaskID id, int ms) {
+        return [&, id, ms]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    };
+    TaskGraph::TaskID a = graph.add("a", task(0, 10));
+    TaskGraph::TaskID b = graph.add("b", task(1, 80), {a});
+    TaskGraph::TaskID c = graph.add("c", task(2, 5), {a});
+    TaskGraph::TaskID d = graph.add("d", task(3, 10), {b, c});
+    graph.run(3);
+
+    // 2.40 - TODAS LAS TAREAS SE EJECUTAN UNA VEZ DESPUÉS DE SUS DEPENDENCIAS
+    REQUIRE(order.size() == 4);
+    CHECK(order.front() == a);
+    CHECK(order.back() == d);
+    CHECK(graph.duration(b) >= 0.08);
+
+    // 2.41 - CAMINO CRÍTICO FORMADO POR LA CADENA DE MAYOR DURACIÓN
+    CHECK(graph.criticalPath() == std::vector<TaskGraph::TaskID>({a, b, d}));
+    CHECK(graph.getWallTime() >= graph.duration(a) + graph.duration(b) + graph.duration(d));
+
+    // 2.42 - LAS EXCEPCIONES DE LAS TAREAS SE PROPAGAN Y DETIENEN A SUS SUCESORAS
+    TaskGraph failing;
+    bool reached = false;
+    TaskGraph::TaskID first = failing.add("throw", []() { throw std::runtime_error("task failed"); });
+    failing.add("successor", [&]() { reached = true; }, {first});
+    CHECK_THROWS_AS(failing.run(2), std::runtime_error);
+    CHECK(!reached);
+    CHECK_THROWS_AS(failing.add("invalid", []() {}, {5}), std::invalid_argument);
+}
+
+TEST_CASE("2.43, 2.44", "[KDTree]") {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> coordinate(-500, 500);
+
+    // Puntos aleatorios con puntos repetidos y un plano denso
+    PointCloud cloud;
+    for (int i = 0; i < 4000; ++i) {
+        cloud.push_back(Point(coordinate(gen), coordinate(gen), coordinate(gen)));
+    }
+    for (int i = 0; i < 50; ++i) {
+        cloud.push_back(Point(10., 10., 10.));
+    }
+    for (int i = 0; i < 30; ++i) {
+        for (int j = 0; j < 30; ++j) {
+            cloud.push_back(Point(i * 2., j * 2., 0.));
+        }
+    }
+    KDTree tree(cloud);
+    REQUIRE(tree.size() == cloud.size());
+
+    for (int q = 0; q < 200; ++q) {
+        Point p(coordinate(gen), coordinate(gen), coordinate(gen));
+        if (q % 4 == 0) {
+            p = Point(q * .1, q * .2, .5);  // Consultas sobre el plano denso
+        }
+
+        std::vector<std::pair<double, size_t>> distances;
+        for (size_t i = 0; i < cloud.size(); ++i) {
+            distances.push_back({(cloud[i] - p).module(), i});
+        }
+        std::sort(distances.begin(), distances.end());
+
+        // 2.43 - MISMA DISTANCIA AL VECINO MÁS CERCANO QUE LA BÚSQUEDA EXHAUSTIVA Y RESPETO DE LA DISTANCIA MÁXIMA
+        std::pair<size_t, double> nearest = tree.nearest(p);
+        REQUIRE(nearest.first < cloud.size());
+        CHECK(std::fabs(nearest.second - distances[0].first) < 1e-3);
+        CHECK(std::fabs((cloud[nearest.first] - p).module() - nearest.second) < 1e-3);
+        CHECK(tree.nearest(p, distances[0].first * 0.5).first == tree.size());
+
+        // 2.44 - K VECINOS MÁS CERCANOS ORDENADOS POR DISTANCIA
+        std::vector<size_t> knn = tree.nearestK(p, 12);
+        REQUIRE(knn.size() == 12);
+        for (size_t k = 0; k < knn.size(); ++k) {
+            CHECK(std::fabs((cloud[knn[k]] - p).module() - distances[k].first) < 1e-3);
+        }
+    }
+}
+
+TEST_CASE("2.45", "[Geometry]") {
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<double> coordinate(-200, 200), offset(-1, 1);
+
+    // Plano inclinado con ruido uniforme y puntos ajenos a la cara
+    const Vector normal(1., 2., 2.);
+    PointCloud cloud;
+    std::vector<size_t> indices;
+    std::vector<double> residuals;
+    for (int i = 0; i < 1001; ++i) {
+        cloud.push_back(Point(500., 500., 500.));  // Fuera de la cara
+        const double x = coordinate(gen), y = coordinate(gen), r = offset(gen);
+        indices.push_back(cloud.size());
+        residuals.push_back(r);
+        cloud.push_back(Point(x + r / 3, y + 2 * r / 3, (100 - x - 2 * y) / 2 + 2 * r / 3));  // Residuo r sobre x + 2y + 2z = 100
+    }
+
+    double mean = std::accumulate(residuals.begin(), residuals.end(), 0.) / residuals.size(), squares = 0, max = 0;
+    for (double r : residuals) {
+        squares += (r - mean) * (r - mean);
+        max = std::max(max, std::fabs(r - mean));
+    }
+
+    // 2.45 - RESIDUOS DEL AJUSTE AL PLANO IGUALES A LOS CALCULADOS SOBRE LOS PUNTOS DE LA CARA
+    std::pair<double, double> fit = Geometry::planeResiduals(cloud, indices, normal);
+    CHECK(std::fabs(fit.first - std::sqrt(squares / residuals.size())) < 1e-3);
+    CHECK(std::fabs(fit.second - max) < 1e-3);
+    CHECK(Geometry::planeResiduals(cloud, {}, normal) == std::pair<double, double>(0., 0.));
+}
+
+TEST_CASE("2.46", "[PointCloud]") {
+    // Coordenadas en memoria externa, liberada por el propietario al destruir la última nube que la utiliza
+    std::shared_ptr<std::vector<float>> columns = std::make_shared<std::vector<float>>(std::vector<float>{1, 2, 3, 4, 5, 6, 7, 8, 9});
+    std::weak_ptr<std::vector<float>> owner = columns;
+    const float *data = columns->data();
+    PointCloud cloud = PointCloud::external(std::move(columns), data, data + 3, data + 6, 3);
+    PointCloud copy = cloud.clone();
+    PointCloud modified = cloud.clone();
+    modified.set(1, Point(0, 0, 0));
+
+    // 2.46 - NUBE SOBRE MEMORIA EXTERNA SIN COPIA, COMPARTIDA POR SUS COPIAS Y COPIADA AL MODIFICARSE
+    REQUIRE(cloud.size() == 3);
+    CHECK(cloud.isExternal());
+    CHECK(cloud.xData() == data);
+    CHECK(cloud[1] == Point(2, 5, 8));
+    CHECK(copy.zData() == data + 6);
+    CHECK(!modified.isExternal());
+    CHECK(modified[1] == Point(0, 0, 0));
+    CHECK(modified[2] == Point(3, 6, 9));
+    CHECK(cloud[1] == Point(2, 5, 8));
+    CHECK(cloud.subset(std::vector<size_t>{2})[0] == Point(3, 6, 9));
+    cloud.clear();
+    CHECK(cloud.empty());
+    CHECK(!owner.expired());
+    copy.clear();
+    CHECK(owner.expired());
+}
+
+TEST_CASE("2.47", "[TaskGraph]") {
+    const int previous = omp_get_max_threads();
+    omp_set_num_threads(4);
+
+    // Cuatro tareas independientes que coinciden en el tiempo
+    TaskGraph parallel;
+    std::vector<int> threads(4, 0);
+    for (size_t t = 0; t < threads.size(); ++t) {
+        parallel.add("parallel", [&threads, t]() {
+            threads[t] = omp_get_max_threads();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        });
+    }
+    parallel.run(4);
+
+    // Una única tarea tras otra que se ejecuta sola
+    TaskGraph chain;
+    int alone = 0;
+    TaskGraph::TaskID first = chain.add("first", []() {});
+    chain.add("alone", [&alone]() { alone = omp_get_max_threads(); }, {first});
+    chain.run(4);
+
+    // 2.47 - HILOS DE OPENMP REPARTIDOS ENTRE LAS TAREAS SIMULTÁNEAS Y RECUPERADOS AL TERMINAR
+    CHECK(std::accumulate(threads.begin(), threads.end(), 0) <= 4);
+    CHECK(std::count(threads.begin(), threads.end(), 0) == 0);
+    CHECK(alone == 4);
+    CHECK(omp_get_max_threads() == 4);
+
+    omp_set_num_threads(previous);
+}
+
+TEST_CASE("2.48", "[Geometry]") {
+    // Plano x = 0 junto al origen y plano horizontal a 2^21 vóxeles de altura, sobre vóxeles de 1mm
+    PointCloud cloud;
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            cloud.push_back(Point(0, i, j));
+        }
+    }
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            cloud.push_back(Point(i, j, 1 << 21));
+        }
+    }
+
+    std::vector<Vector> normals = Geometry::computeVoxelNormals(cloud, 1.5, 1);
+
+    // 2.48 - VÓXELES LEJANOS NO SE CONFUNDEN CON LOS DEL ORIGEN
+    for (size_t i = 0; i < 100; ++i) {
+        CHECK(normals[i] == Point(1, 0, 0));
+    }
+    for (size_t i = 100; i < cloud.size(); ++i) {
+        CHECK(std::fabs(normals[i].getZ()) == Approx(1));
+    }
+}
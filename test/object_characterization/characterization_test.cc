@@ -11,13 +11,28 @@
 #include "catch_utils.hh"
 
 #include <vector>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+#include <iterator>
 
 #include "object_characterization/ObjectCharacterizer.hh"
 #include "object_characterization/CharacterizedObject.hh"
 #include "object_characterization/DBScan.hh"
+#include "object_characterization/ObjectFile.hh"
 
 #include "scanner/IScanner.hh"
+#include "scanner/ScannerSynthetic.hh"
 #include "models/LidarPoint.hh"
+#include "models/PointCloud.hh"
+#include "models/NeighborGraph.hh"
+#include "app/config.h"
 
 /* MOCKUP */
 class ScannerMock : public IScanner {
@@ -195,7 +210,368 @@ TEST_CASE_METHOD(CharacterizationFixture, "3.6", "[ObjectCharacterizer]") {
 
 TEST_CASE_METHOD(CharacterizationFixture, "3.7, 3.8", "[DBScan]") {
     // 3.7
-    CHECK(DBScan::clusters(cubo).size() == 1);
+    std::vector<std::vector<size_t>> clusters = DBScan::clusters(cubo);
+    REQUIRE(clusters.size() == 1);
+    CHECK(clusters[0].size() == cubo.size() - 1);  // Todos los puntos salvo el aislado, como en la versión original
     // 3.8
     CHECK(DBScan::normals(plano).size() == 1);
-}
\ No newline at end of file
+}
+
+// BENCHMARK: DBScan y caracterización de una caja sintética de 10k a 10M puntos
+TEST_CASE("3.9", "[.][benchmark][DBScan]") {
+    SyntheticScene scene;
+    scene.boxes.push_back({{3000, 0, -750}, {500, 500, 500}, {0, 0, 30}});
+
+    std::cout << std::endl
+              << std::setw(10) << "points" << std::setw(16) << "sequential (s)" << std::setw(16) << "clusters (s)" << std::setw(16) << "parse (s)" << std::endl;
+
+    for (size_t n : {10000, 100000, 1000000, 10000000}) {
+        std::vector<LidarPoint> generated = ScannerSynthetic::generate(scene, n, false, true);
+        std::vector<Point> points(generated.begin(), generated.end());
+        PointCloud cloud(points);
+        std::vector<int> labels;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::vector<size_t>> sequential = DBScan::sequentialClusters(cloud, labels);
+        auto first = std::chrono::high_resolution_clock::now();
+        std::vector<std::vector<size_t>> clusters = DBScan::clusters(cloud, labels);
+        auto middle = std::chrono::high_resolution_clock::now();
+        std::pair<bool, CharacterizedObject> object = CharacterizedObject::parse(points, false);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << std::setw(10) << n << std::setw(16) << std::chrono::duration<double>(first - start).count()
+                  << std::setw(16) << std::chrono::duration<double>(middle - first).count()
+                  << std::setw(16) << std::chrono::duration<double>(end - middle).count() << std::endl;
+
+        CHECK(sequential.size() == 1);
+        CHECK(clusters.size() == 1);
+        CHECK(object.first);
+    }
+}
+
+TEST_CASE_METHOD(CharacterizationFixture, "3.10", "[DBScan]") {
+    PointCloud cloud(plano);
+    std::vector<int> labels;
+    std::vector<std::vector<size_t>> faces = DBScan::normals(cloud, labels);
+
+    // 3.10 - ETIQUETAS COHERENTES CON LAS CARAS Y PUNTO AISLADO COMO RUIDO
+    REQUIRE(faces.size() == 1);
+    REQUIRE(labels.size() == plano.size());
+    for (size_t i : faces[0]) {
+        CHECK(labels[i] == 0);
+    }
+    CHECK(labels.back() < 0);
+}
+
+TEST_CASE("3.11", "[DBScan]") {
+    SyntheticScene scene;
+    scene.boxes.push_back({{3000, -600, -750}, {400, 400, 400}});
+    scene.boxes.push_back({{3000, 600, -750}, {400, 400, 400}, {0, 0, 45}});
+
+    PointCloud cloud(ScannerSynthetic::generate(scene, 20000, false, true));
+    std::vector<int> sequentialLabels, parallelLabels, repeatedLabels;
+
+    std::vector<std::vector<size_t>> sequential = DBScan::sequentialClusters(cloud, sequentialLabels);
+    std::vector<std::vector<size_t>> parallel = DBScan::clusters(cloud, parallelLabels);
+    std::vector<std::vector<size_t>> repeated = DBScan::clusters(cloud, repeatedLabels);
+
+    // 3.11 - MISMOS CLUSTERES Y ETIQUETAS QUE LA VERSIÓN SECUENCIAL Y RESULTADO DETERMINISTA
+    REQUIRE(sequential.size() >= 2);
+    REQUIRE(parallel.size() == sequential.size());
+    for (size_t i = 0; i < parallel.size(); ++i) {
+        CHECK(std::is_sorted(parallel[i].begin(), parallel[i].end()));
+        std::sort(sequential[i].begin(), sequential[i].end());
+        CHECK(parallel[i] == sequential[i]);
+    }
+    CHECK(parallelLabels == sequentialLabels);
+    CHECK(parallel == repeated);
+    CHECK(parallelLabels == repeatedLabels);
+}
+
+TEST_CASE("3.12", "[.][benchmark][DBScan]") {
+    std::cout << std::endl
+              << std::setw(10) << "points" << std::setw(16) << "graph (s)" << std::setw(16) << "faces (s)" << std::setw(16) << "faces (us/pt)" << std::endl;
+
+    // Caras planas cuadradas de tamaño creciente con una densidad constante de un punto cada 10mm
+    for (size_t side : {100, 200, 400, 600}) {
+        PointCloud cloud;
+        cloud.reserve(side * side);
+        for (size_t i = 0; i < side; ++i) {
+            for (size_t j = 0; j < side; ++j) {
+                cloud.push_back(Point(3000., i * 10., j * 10.));
+            }
+        }
+        std::vector<int> labels;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        NeighborGraph graph(cloud, NEIGHBOR_GRAPH_PROXIMITY);
+        auto middle = std::chrono::high_resolution_clock::now();
+        std::vector<std::vector<size_t>> faces = DBScan::normals(cloud, graph, labels);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        const double facesTime = std::chrono::duration<double>(end - middle).count();
+        std::cout << std::setw(10) << cloud.size() << std::setw(16) << std::chrono::duration<double>(middle - start).count()
+                  << std::setw(16) << facesTime << std::setw(16) << facesTime * 1.e6 / cloud.size() << std::endl;
+
+        CHECK(faces.size() == 1);
+    }
+}
+
+TEST_CASE("3.13", "[CharacterizedObject]") {
+    SyntheticScene scene;
+    scene.boxes.push_back({{3000, -600, -750}, {400, 400, 400}});
+    scene.boxes.push_back({{3000, 600, -750}, {400, 400, 400}, {0, 0, 45}});
+
+    PointCloud cloud(ScannerSynthetic::generate(scene, 60000, false, true));
+    // Pequeño grupo de puntos aislado por debajo del tamaño mínimo de un objeto
+    for (int i = 0; i < 10; ++i) {
+        for (int j = 0; j < 10; ++j) {
+            cloud.push_back(Point(3000., i * 4., 1000. + j * 4.));
+        }
+    }
+
+    std::vector<int> labels;
+    std::vector<std::vector<size_t>> clusters = DBScan::clusters(cloud, labels);
+    std::vector<size_t> sizes;
+    for (const std::vector<size_t> &c : clusters) {
+        if (c.size() >= MIN_OBJECT_POINTS) {
+            sizes.push_back(c.size());
+        }
+    }
+    std::sort(sizes.rbegin(), sizes.rend());
+
+    std::vector<CharacterizedObject> objects = CharacterizedObject::parseAll(cloud, false);
+    std::pair<bool, CharacterizedObject> largest = CharacterizedObject::parse(cloud, false);
+
+    // 3.13 - UN OBJETO POR CADA CLUSTER CON TAMAÑO SUFICIENTE, DE MAYOR A MENOR Y EL PRIMERO IGUAL AL DE PARSE
+    REQUIRE(clusters.size() == 3);
+    REQUIRE(objects.size() == 2);
+    for (size_t i = 0; i < objects.size(); ++i) {
+        CHECK(objects[i].getPoints().size() == sizes[i]);
+        CHECK(objects[i].getFaces().size() > 0);
+    }
+    REQUIRE(largest.first);
+    CHECK(largest.second.getPoints().size() == objects[0].getPoints().size());
+    CHECK(largest.second.getFaces().size() == objects[0].getFaces().size());
+    CHECK((largest.second.getBBox().getDelta() - objects[0].getBBox().getDelta()).module() < 1e-3);
+}
+
+TEST_CASE("3.14, 3.15", "[CharacterizedObject]") {
+    SyntheticScene scene;
+    scene.boxes.push_back({{3000, 0, -750}, {400, 400, 400}});
+    std::pair<bool, CharacterizedObject> parsed = CharacterizedObject::parse(PointCloud(ScannerSynthetic::generate(scene, 20000, false, true)), false);
+    REQUIRE(parsed.first);
+    const CharacterizedObject &object = parsed.second;
+
+    // 3.14 - CARACTERÍSTICAS CONSTRUIDAS UNA SOLA VEZ, COMPARTIDAS CON LAS COPIAS Y COHERENTES CON EL OBJETO
+    std::shared_ptr<const ModelFeatures> features = object.getFeatures();
+    CHECK(object.getFeatures() == features);
+    CHECK(parsed.second.getPoints().size() == features->tree.size());  // Consultar los puntos no invalida las características
+    CHECK(object.getFeatures() == features);
+    CHECK(features->normals.size() == object.getPoints().size());
+    std::shared_ptr<const FaceFeatures> faceFeatures = object.getFaceFeatures();
+    CHECK(object.getFaceFeatures() == faceFeatures);
+    REQUIRE(faceFeatures->size() == object.getFaces().size());
+    for (size_t i = 0; i < object.getFaces().size(); ++i) {
+        CHECK(faceFeatures->descriptors[i].volume == object.getFaces()[i].getMinBBox().volume());
+        const Vector normal = object.getFaces()[i].getNormal() / object.getFaces()[i].getNormal().module();
+        CHECK(std::fabs(faceFeatures->normals(0, i) - normal.getX()) < 1e-6);
+        CHECK(std::fabs(faceFeatures->normals(1, i) - normal.getY()) < 1e-6);
+        CHECK(std::fabs(faceFeatures->normals(2, i) - normal.getZ()) < 1e-6);
+    }
+    // Envolvente de la caracterización sobre los puntos recolocados del objeto: vértices tomados de sus puntos y
+    // todos los puntos en el interior de cada cara
+    std::shared_ptr<const ConvexHull> parsedHull = object.getHull();
+    CHECK(object.getHull() == parsedHull);
+    REQUIRE(!parsedHull->isDegenerate());
+    for (size_t v = 0; v < parsedHull->getVertices().size(); ++v) {
+        CHECK(parsedHull->getVertices()[v] == object.getPoints()[parsedHull->getIndices()[v]]);
+    }
+    for (size_t f = 0; f < parsedHull->getFaces().size(); ++f) {
+        const Point &a = parsedHull->getVertices()[parsedHull->getFaces()[f][0]];
+        double outside = 0;
+        for (size_t i = 0; i < object.getPoints().size(); ++i) {
+            outside = std::max(outside, (object.getPoints()[i] - a).scalarProduct(parsedHull->getNormals()[f]));
+        }
+        CHECK(outside < 1e-2);
+    }
+    CharacterizedObject copy = object.clone();
+    CHECK(copy.getFeatures() == features);
+    CHECK(copy.getFaceFeatures() == faceFeatures);
+    CHECK(copy.getHull() == parsedHull);
+
+    // 3.15 - CARACTERÍSTICAS RECONSTRUIDAS TRAS MODIFICAR LOS PUNTOS O LAS CARAS, SIN INVALIDAR LAS YA OBTENIDAS
+    copy.setPoints(object.getPoints().subset(std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    CHECK(copy.getFeatures().get() != features.get());
+    CHECK(copy.getFeatures()->tree.size() == 10);
+    CHECK(copy.getHull().get() != parsedHull.get());
+    CHECK(copy.getHull()->getVertices().size() <= 10);
+    CHECK(object.getFeatures() == features);
+    parsed.second.setFaces({object.getFaces()[0]});
+    CHECK(object.getFaceFeatures()->size() == 1);
+    CHECK(object.getFeatures() == features);  // Las características de la superficie no dependen de las caras
+    CHECK(faceFeatures->size() > 1);
+    CHECK(features->tree.size() == object.getPoints().size());
+    CHECK(object.getHull() == parsedHull);
+
+    // Objeto sin puntos ni caras
+    CharacterizedObject empty;
+    CHECK(empty.getFeatures()->tree.size() == 0);
+    CHECK(empty.getFeatures()->normals.empty());
+    CHECK(empty.getFaceFeatures()->size() == 0);
+}
+
+// Comprueba que dos objetos tienen los mismos puntos, bounding box y caras
+static void checkSameObject(const CharacterizedObject &a, const CharacterizedObject &b) {
+    REQUIRE(a.getPoints().size() == b.getPoints().size());
+    for (size_t i = 0; i < a.getPoints().size(); ++i) {
+        CHECK(a.getPoints()[i] == b.getPoints()[i]);
+    }
+    CHECK(a.getBBox().getMin() == b.getBBox().getMin());
+    CHECK(a.getBBox().getMax() == b.getBBox().getMax());
+    REQUIRE(a.getFaces().size() == b.getFaces().size());
+    for (size_t i = 0; i < a.getFaces().size(); ++i) {
+        const Face &fa = a.getFaces()[i], &fb = b.getFaces()[i];
+        CHECK(fa.getIndices() == fb.getIndices());
+        CHECK(fa.getNormal() == fb.getNormal());
+        CHECK(fa.getMinBBox().getMin() == fb.getMinBBox().getMin());
+        CHECK(fa.getMinBBox().getMax() == fb.getMinBBox().getMax());
+        CHECK(fa.getMinBBoxRotAngles() == fb.getMinBBoxRotAngles());
+        CHECK(std::fabs(fa.getPlaneRMS() - fb.getPlaneRMS()) < 1e-9);
+        CHECK(std::fabs(fa.getPlaneMaxResidual() - fb.getPlaneMaxResidual()) < 1e-9);
+    }
+}
+
+TEST_CASE("3.16, 3.17, 3.18", "[ObjectFile]") {
+    SyntheticScene scene;
+    scene.boxes.push_back({{3000, 0, -750}, {400, 400, 400}});
+    std::pair<bool, CharacterizedObject> parsed = CharacterizedObject::parse(PointCloud(ScannerSynthetic::generate(scene, 20000, false, true)), false);
+    REQUIRE(parsed.first);
+    const CharacterizedObject &object = parsed.second;
+    const std::string filename = "objectfile_test.tmp";
+    REQUIRE(parsed.second.write(filename));
+
+    // 3.16 - OBJETO RECUPERADO SIN CAMBIOS, PUNTOS PROYECTADOS DESDE EL ARCHIVO Y GUARDADO SOBRE SU PROPIO ARCHIVO
+    {
+        REQUIRE(ObjectFile::isObjectFile(filename));
+        std::pair<bool, CharacterizedObject> loaded = CharacterizedObject::load(filename);
+        REQUIRE(loaded.first);
+        const CharacterizedObject &copy = loaded.second;
+        CHECK(copy.getPoints().isExternal());
+        checkSameObject(object, copy);
+        CHECK(copy.getFeatures()->tree.size() == object.getPoints().size());
+
+        REQUIRE(loaded.second.write(filename));
+        checkSameObject(object, copy);
+        REQUIRE(CharacterizedObject::convert(filename, filename));
+        std::pair<bool, CharacterizedObject> reloaded = CharacterizedObject::load(filename);
+        REQUIRE(reloaded.first);
+        checkSameObject(object, reloaded.second);
+    }
+
+    // 3.17 - ARCHIVOS DEL FORMATO ANTERIOR CARGADOS Y CONVERTIDOS SIN PÉRDIDAS
+    {
+        const std::string legacy = "../../test/test_object1";
+        CHECK(!ObjectFile::isObjectFile(legacy));
+        std::pair<bool, CharacterizedObject> old = CharacterizedObject::load(legacy);
+        REQUIRE(old.first);
+        CHECK(!old.second.getPoints().isExternal());
+        REQUIRE(CharacterizedObject::convert(legacy, filename));
+        std::pair<bool, CharacterizedObject> converted = CharacterizedObject::load(filename);
+        REQUIRE(converted.first);
+        checkSameObject(old.second, converted.second);
+        CHECK(!CharacterizedObject::convert("../../test/nonexistent_object", filename));
+    }
+
+    // 3.18 - CORRUPCIÓN Y TRUNCADO DETECTADOS CON LAS SUMAS DE VERIFICACIÓN Y LA CABECERA
+    {
+        CHECK(ObjectFile::crc32("123456789", 9) == 0xCBF43926u);
+        CHECK(ObjectFile::crc32("56789", 5, ObjectFile::crc32("1234", 4)) == 0xCBF43926u);
+
+        REQUIRE(parsed.second.write(filename));
+        std::ifstream infile(filename, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+        infile.close();
+        ObjectFile::Header header;
+        REQUIRE(bytes.size() >= sizeof(header));
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        CHECK(header.version == ObjectFile::kVersion);
+        CHECK(header.fileSize == bytes.size());
+        for (const ObjectFile::SectionEntry &section : header.sections) {
+            CHECK(section.offset % ObjectFile::kAlignment == 0);
+        }
+
+        // Escribe el archivo modificado y comprueba si se carga
+        auto loads = [&filename](const std::vector<char> &contents, bool verify) {
+            std::ofstream outfile(filename, std::ios::binary);
+            outfile.write(contents.data(), contents.size());
+            outfile.close();
+            PointCloud points;
+            BBox bbox;
+            std::vector<Face> faces;
+            return ObjectFile::read(filename, points, bbox, faces, verify);
+        };
+        CHECK(loads(bytes, true));
+
+        std::vector<char> corrupted = bytes;
+        corrupted[header.sections[ObjectFile::kSectionY].offset + 5] ^= 0x10;
+        CHECK(!loads(corrupted, true));
+        CHECK(loads(corrupted, false));  // Solo se comprueba la cabecera
+
+        corrupted = bytes;
+        corrupted[header.sections[ObjectFile::kSectionIndices].offset] ^= 0x01;
+        CHECK(!loads(corrupted, true));
+
+        corrupted = bytes;
+        corrupted[offsetof(ObjectFile::Header, numPoints)] ^= 0x01;
+        CHECK(!loads(corrupted, false));
+
+        corrupted = bytes;
+        corrupted.resize(bytes.size() - 1);
+        CHECK(!loads(corrupted, false));
+    }
+
+    std::remove(filename.c_str());
+}
+
+// BENCHMARK: carga de archivos de objetos de 100k a 4M puntos, con y sin comprobación de las sumas de verificación
+TEST_CASE("3.19", "[.][benchmark][ObjectFile]") {
+    const std::string filename = "objectfile_benchmark.tmp";
+
+    std::cout << std::endl
+              << std::setw(10) << "points" << std::setw(16) << "write (s)" << std::setw(16) << "load (s)" << std::setw(16) << "verified (s)" << std::endl;
+
+    for (size_t n : {100000, 1000000, 4000000}) {
+        // Objeto con una única cara que contiene todos sus puntos
+        PointCloud points;
+        points.reserve(n);
+        std::vector<size_t> indices(n);
+        for (size_t i = 0; i < n; ++i) {
+            points.push_back(Point(double(i % 1000), double(i / 1000 % 1000), double(i / 1000000)));
+            indices[i] = i;
+        }
+        BBox bbox(points.view());
+        std::vector<Face> faces = {Face(std::move(indices), Vector(0, 0, 1), bbox, Vector(0, 0, 0))};
+
+        PointCloud loaded, verified;
+        std::vector<Face> loadedFaces, verifiedFaces;
+        auto start = std::chrono::high_resolution_clock::now();
+        REQUIRE(ObjectFile::write(filename, points, bbox, faces));
+        auto first = std::chrono::high_resolution_clock::now();
+        bool read = ObjectFile::read(filename, loaded, bbox, loadedFaces, false);
+        auto middle = std::chrono::high_resolution_clock::now();
+        bool readVerified = ObjectFile::read(filename, verified, bbox, verifiedFaces, true);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::cout << std::setw(10) << n << std::setw(16) << std::chrono::duration<double>(first - start).count()
+                  << std::setw(16) << std::chrono::duration<double>(middle - first).count()
+                  << std::setw(16) << std::chrono::duration<double>(end - middle).count() << std::endl;
+
+        CHECK(read);
+        CHECK(readVerified);
+        CHECK(loaded.size() == n);
+        CHECK(verifiedFaces[0].getIndices().size() == n);
+    }
+
+    std::remove(filename.c_str());
+}
@@ -7,6 +7,12 @@
  *
  */
 
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+
 #include "catch.hpp"
 #include "catch_utils.hh"
 
@@ -15,6 +21,9 @@
 #include "scanner/ScannerLidar.hh"
 #include "scanner/ScannerLVX.hh"
 #include "scanner/ScannerCSV.hh"
+#include "scanner/ScannerSynthetic.hh"
+#include "scanner/ScannerMerged.hh"
+#include "emulator/LivoxEmulator.hh"
 
 #include "models/LidarPoint.hh"
 
@@ -31,6 +40,14 @@ class ScannerLVXMock : public ScannerLVX {
    public:
     ScannerLVXMock(const std::string &file) : ScannerLVX(file) {}
 };
+class ScannerSyntheticMock : public ScannerSynthetic {
+   public:
+    ScannerSyntheticMock(const SyntheticScene &scene) : ScannerSynthetic(scene) {}
+};
+class ScannerMergedMock : public ScannerMerged {
+   public:
+    ScannerMergedMock(const std::vector<std::pair<IScanner *, SensorExtrinsic>> &sensors, size_t capacity) : ScannerMerged(sensors, capacity) {}
+};
 /***********/
 
 class CallbackFixture {
@@ -176,4 +193,197 @@ TEST_CASE_METHOD(CallbackFixture, "1.20", "[ScannerLVX]") {
     sx.init();
     sx.stop();
     CHECK(sx.init());
-}
\ No newline at end of file
+}
+
+class EmulatorFixture {
+   public:
+    LivoxEmulator emulator;
+
+    std::atomic<uint64_t> received;    // Puntos recibidos
+    std::atomic<uint64_t> latencySum;  // Suma de latencias (ns)
+    std::atomic<uint64_t> latencyMax;  // Latencia máxima (ns)
+
+    EmulatorFixture() : emulator("test/scanner/testdata.lvx", "3WEDH7600101621"), received(0), latencySum(0), latencyMax(0) {}
+
+    void reset() {
+        received = 0;
+        latencySum = 0;
+        latencyMax = 0;
+    }
+    void callbackLatency(const LidarPoint &p) {
+        uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        uint64_t sent = static_cast<uint64_t>(p.getTimestamp().getSeconds()) * NANO_DIGITS + p.getTimestamp().getNanoseconds();
+        uint64_t latency = now > sent ? now - sent : 0;
+
+        ++received;
+        latencySum += latency;
+        uint64_t max = latencyMax.load();
+        while (latency > max && !latencyMax.compare_exchange_weak(max, latency)) {
+        }
+    }
+};
+
+// BENCHMARK: Pérdida de puntos y latencia del callback de ScannerLidar contra el emulador a 1x-8x la frecuencia del sensor
+TEST_CASE_METHOD(EmulatorFixture, "1.21", "[.][benchmark][ScannerLidar]") {
+    REQUIRE(emulator.init());
+    REQUIRE(emulator.start());
+
+    IScanner *sl = ScannerLidar::create("3WEDH7600101621");
+    REQUIRE(sl->init());
+    sl->setCallback([this](const LidarPoint &p) { this->callbackLatency(p); });
+    std::thread scanThread([sl]() { sl->scan(); });
+
+    // Esperamos a que el SDK conecte y active el muestreo
+    for (int i = 0; i < 100 && !emulator.isSampling(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    REQUIRE(emulator.isSampling());
+
+    std::cout << std::endl
+              << std::setw(6) << "rate" << std::setw(14) << "sent pts/s" << std::setw(12) << "drop %" << std::setw(16) << "mean lat (us)" << std::setw(16) << "max lat (us)" << std::endl;
+
+    for (int multiplier : {1, 2, 4, 8}) {
+        // Calentamiento a la nueva frecuencia
+        emulator.setPacketRate(LIVOX_HORIZON_PACKET_RATE * multiplier);
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        emulator.resetStatistics();
+        reset();
+        std::this_thread::sleep_for(std::chrono::seconds(5));
+
+        // Detenemos el envío y dejamos que se vacíen los buffers antes de contar
+        emulator.setPacketRate(0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        uint64_t sent = emulator.getSentPoints();
+        uint64_t recv = received;
+        double drop = sent ? 100. * (1. - static_cast<double>(recv) / sent) : 100.;
+
+        std::cout << std::setw(5) << multiplier << "x" << std::setw(14) << sent / 5 << std::setw(12) << std::fixed << std::setprecision(2) << drop
+                  << std::setw(16) << (recv ? latencySum / recv / 1000. : 0.) << std::setw(16) << latencyMax / 1000. << std::endl;
+
+        CHECK(sent > 0);
+        CHECK(recv > 0);
+    }
+
+    sl->pause();
+    scanThread.join();
+    sl->stop();
+    emulator.stop();
+}
+
+class SyntheticFixture {
+   public:
+    SyntheticScene scene;
+
+    std::vector<LidarPoint> scanned;
+
+    SyntheticFixture() {
+        scene.density = 500;
+        scene.objectDelay = 100;
+        scene.boxes.push_back({{3000, 0, -750}, {500, 500, 500}});
+    }
+
+    void callbackCount(const LidarPoint &p, IScanner *inst, size_t max) {
+        scanned.push_back(p);
+        if (scanned.size() >= max) {
+            inst->pause();
+        }
+    }
+};
+
+TEST_CASE_METHOD(SyntheticFixture, "1.22", "[ScannerSynthetic]") {
+    std::vector<LidarPoint> cloud = ScannerSynthetic::generate(scene, 10000);
+    std::vector<LidarPoint> boxes = ScannerSynthetic::generate(scene, 1000, false, true);
+
+    CHECK(cloud.size() == 10000);
+    CHECK(cloud[0] == ScannerSynthetic::generate(scene, 10000)[0]);
+
+    // Caja de 500mm de lado sin la cara inferior
+    CHECK(ScannerSynthetic::area(scene, false, true) == Approx(5 * 500. * 500.));
+    bool inside = true;
+    for (const LidarPoint &p : boxes) {
+        inside &= p.getX() > 2730 && p.getX() < 3270 && p.getZ() > -1020 && p.getZ() < -480;
+    }
+    CHECK(inside);
+}
+
+TEST_CASE_METHOD(SyntheticFixture, "1.23", "[ScannerSynthetic]") {
+    ScannerSyntheticMock ss(scene);
+    REQUIRE(ss.init());
+
+    // 100ms a 240000 puntos/s
+    ss.setCallback([this, &ss](const LidarPoint &p) { this->callbackCount(p, &ss, 2 * 24000); });
+    CHECK(ss.scan() == kScanOk);
+    REQUIRE(scanned.size() == 2 * 24000);
+
+    // Timestamps de paquete de 96 puntos
+    CHECK(scanned[0].getTimestamp() == scanned[95].getTimestamp());
+    CHECK(scanned[95].getTimestamp() < scanned[96].getTimestamp());
+
+    // Las cajas solo aparecen tras el tiempo de fondo
+    size_t boxPoints[2] = {0, 0};
+    for (size_t i = 0; i < scanned.size(); ++i) {
+        if (scanned[i].getReflectivity() == 100) {
+            ++boxPoints[i / 24000];
+        }
+    }
+    CHECK(boxPoints[0] == 0);
+    CHECK(boxPoints[1] > 0);
+}
+
+TEST_CASE_METHOD(SyntheticFixture, "1.24", "[ScannerSynthetic]") {
+    scene.duration = 10;
+    ScannerSyntheticMock ss(scene);
+    ss.init();
+
+    CHECK(ss.scan() == kScanEof);
+    ss.stop();
+    CHECK(ss.scan() == kScanError);
+}
+
+TEST_CASE_METHOD(SyntheticFixture, "1.25", "[ScannerMerged]") {
+    scene.duration = 50;
+    SyntheticScene scene2 = scene;
+    scene2.seed = 7;
+    scene2.backgroundReflectivity = 30;
+
+    ScannerSyntheticMock s1(scene);
+    ScannerSyntheticMock s2(scene2);
+    ScannerMergedMock sm({{&s1, {}}, {&s2, {{0, 0, 90}, {0, 0, 10000}}}}, 100000);
+
+    REQUIRE(sm.init());
+    sm.setCallback([this](const LidarPoint &p) { this->scanned.push_back(p); });
+    CHECK(sm.scan() == kScanEof);
+
+    // 50ms a 240000 puntos/s de cada sensor
+    REQUIRE(scanned.size() == 2 * 12000);
+
+    bool ordered = true, transformed = true;
+    for (size_t i = 0; i < scanned.size(); ++i) {
+        ordered &= i == 0 || !(scanned[i].getTimestamp() < scanned[i - 1].getTimestamp());
+        if (scanned[i].getReflectivity() == 30) {
+            transformed &= scanned[i].getZ() > 5000;
+        }
+    }
+    CHECK(ordered);
+    CHECK(transformed);
+}
+
+TEST_CASE_METHOD(SyntheticFixture, "1.26", "[ScannerMerged]") {
+    ScannerSyntheticMock s1(scene);
+    ScannerMergedMock sm({{&s1, {}}}, 1000);
+
+    sm.init();
+    sm.setCallback([this, &sm](const LidarPoint &p) { this->callbackCount(p, &sm, 5000); });
+    CHECK(sm.scan() == kScanOk);
+    CHECK(scanned.size() == 5000);
+    CHECK(!sm.isScanning());
+
+    std::map<std::string, SensorExtrinsic> extrinsics;
+    CHECK(!ScannerMerged::readExtrinsics("", extrinsics));
+    CHECK(ScannerMerged::readExtrinsics("test/scanner/extrinsics.txt", extrinsics));
+    CHECK(extrinsics.size() == 2);
+    CHECK(extrinsics["3WEDH7600101621"].translation == Vector(0, 0, 0));
+    CHECK(extrinsics["3WEDH7600101622"].rotation == Vector(0, 0, 180));
+}
@@ -0,0 +1,110 @@
+/**
+ * @file livox_emulator.cc
+ * @author Martín Suárez (martin.suarez.garcia@rai.usc.es)
+ * @date 17/10/2026
+ *
+ * @brief Función main del emulador de sensores LIVOX
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <csignal>
+#include <stdlib.h>
+
+#include "livox_def.h"
+
+#include "emulator/LivoxEmulator.hh"
+#include "app/InputParser.hh"
+#include "app/config.h"
+
+#include "logging/debug.hh"
+
+static std::atomic<bool> exitRequested(false);  // Petición de finalización mediante señal
+
+// Signal handler
+static void onSignal(int) { exitRequested = true; }
+
+// Command line usage
+static void usage(const std::string &exec_name) {
+    std::cout << std::endl
+              << "Usage:" << std::endl
+              << exec_name << " <-f lvx_file> [-b lidar_code] [-r packet_rate] [-i host_ip] [-s stats_interval] [--once]" << std::endl
+              << exec_name << " <-h | --help>" << std::endl
+              << std::endl;
+}
+
+// Command line help
+static void help(const std::string &exec_name) {
+    usage(exec_name);
+    std::cout << "\t -f                LVX file with the point packets to replay" << std::endl
+              << "\t -b                Broadcast code of the emulated sensor. Defaults to " << DEFAULT_BROADCAST_CODE << std::endl
+              << "\t -r                Point packets sent per second. Defaults to " << LIVOX_HORIZON_PACKET_RATE << " (LIVOX Horizon rate)" << std::endl
+              << "\t -i                IP the broadcast messages are sent to. Defaults to 127.0.0.1" << std::endl
+              << "\t -s                Seconds between statistics reports. Defaults to 1s, 0 disables them" << std::endl
+              << "\t --once            Replay the file only once instead of looping" << std::endl
+              << "\t -h,--help         Print the program help text" << std::endl
+              << std::endl;
+}
+
+// Main function
+int main(int argc, char *argv[]) {
+    InputParser parser(argc, const_cast<const char **>(argv));
+
+    if (parser.hasParam("-h") || parser.hasParam("--help")) {
+        help(argv[0]);
+        return EXIT_SUCCESS;
+    }
+
+    std::string filename = parser.getParam("-f");
+    std::string code = parser.hasParam("-b") ? parser.getParam("-b") : DEFAULT_BROADCAST_CODE;
+    std::string ip = parser.hasParam("-i") ? parser.getParam("-i") : "127.0.0.1";
+    double rate = LIVOX_HORIZON_PACKET_RATE;
+    int interval = 1;
+
+    try {
+        if (parser.hasParam("-r")) rate = std::stod(parser.getParam("-r"));
+        if (parser.hasParam("-s")) interval = std::stoi(parser.getParam("-s"));
+    } catch (std::exception &e) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (filename.empty() || code.empty() || code.length() >= kBroadcastCodeSize || rate < 0 || interval < 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    LivoxEmulator emulator(filename, code.c_str(), rate, !parser.hasParam("--once"), ip);
+    if (!emulator.init() || !emulator.start()) {
+        std::cerr << "Unable to start the emulator with file " << filename << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    std::cout << "Emulating LiDAR " << code << " with " << emulator.getLoadedPackets() << " packets at " << rate << " packets/s" << std::endl;
+
+    // Informe periódico de los puntos enviados
+    auto last = std::chrono::steady_clock::now();
+    while (!exitRequested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - last).count();
+        if (interval > 0 && elapsed >= interval) {
+            std::cout << "[" << (emulator.isConnected() ? "connected" : "broadcasting") << "] "
+                      << emulator.getSentPackets() / elapsed << " packets/s, "
+                      << emulator.getSentPoints() / elapsed << " points/s" << std::endl;
+            emulator.resetStatistics();
+            last = std::chrono::steady_clock::now();
+        }
+    }
+
+    emulator.stop();
+
+    return EXIT_SUCCESS;
+}